@@ -3,6 +3,7 @@
 
 #include "Adjustment/Elevation.hpp"
 #include "Adjustment/ElevationNet.hpp"
+#include "Adjustment/ElevationNetStream.hpp"
 #include "Adjustment/Traverse.hpp"
 
 #endif
\ No newline at end of file
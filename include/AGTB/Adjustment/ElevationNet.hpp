@@ -5,6 +5,7 @@
 #include "Elevation.hpp"
 #include "../Linalg/NormalEquationMatrixInverse.hpp"
 #include "../Linalg/CorrectionOlsSolve.hpp"
+#include "../Linalg/HelmertBlocking.hpp"
 #include "../IO/Eigen.hpp"
 #include "../Container/NamedGraph.hpp"
 
@@ -30,27 +31,35 @@ namespace Elevation::Net
 
     using ElevationNet = NamedGraph<VertexProperty, EdgeProperty>;
 
-    void InitializeElevations(ElevationNet &net, std::vector<ElevationNet::name_type> &unknown)
+    /**
+     * @brief Topology with `dif`, `len` of every edge (fields 0, 1)
+     *
+     */
+    using FrozenElevationNet = FrozenGraph<double, double>;
+
+    FrozenElevationNet Freeze(const ElevationNet &net)
     {
-        auto edges_access = net.Edges();
-        auto verts_access = net.Vertices();
+        return net.Freeze(&EdgeProperty::dif, &EdgeProperty::len);
+    }
 
-        std::queue<ElevationNet::name_type> initializer_list{};
+    void InitializeElevations(ElevationNet &net, const FrozenElevationNet &frozen, std::vector<ElevationNet::name_type> &unknown)
+    {
+        std::queue<VertexHandle> initializer_list{};
 
-        for (const auto &v : verts_access.Names())
+        for (const auto vh : net.VertexHandles())
         {
-            if (!net.Vertex(v).is_control)
+            if (!net.Vertex(vh).is_control)
             {
-                unknown.emplace_back(v);
+                unknown.emplace_back(net.NameOf(vh));
             }
             else
             {
-                initializer_list.emplace(v);
+                initializer_list.emplace(vh);
             }
         }
 
         int r = initializer_list.size();
-        int n = edges_access.Size();
+        int n = frozen.EdgeCount();
         int t = unknown.size();
 
         if (n - t + r < 0)
@@ -58,37 +67,34 @@ namespace Elevation::Net
             AGTB_THROW(std::invalid_argument, std::format("Input data don't support adjustments: n = {}, t = {}, r = {}", n, t, r));
         }
 
+        const auto dif = frozen.Field<0>();
         while (!initializer_list.empty())
         {
-            const auto &seed_name = initializer_list.front();
+            const auto seed = initializer_list.front();
+            const double seed_elev = net.Vertex(seed).elev;
 
-            for (auto [it, end] = net.OutEdges(seed_name); it != end; ++it)
+            for (const auto eh : frozen.OutEdges(seed))
             {
-                auto edge_idx = *it;
-                const auto &edge_name = net.NameOf(edge_idx);
-                auto &vert_prop = net.TargetVertex(edge_name);
-                const auto &edge_prop = net.Edge(edge_name);
+                const auto target = frozen.Target(eh);
+                auto &vert_prop = net.Vertex(target);
 
                 if (!vert_prop.with_init)
                 {
-                    vert_prop.elev = net.Vertex(seed_name).elev + edge_prop.dif;
+                    vert_prop.elev = seed_elev + dif[eh.id];
                     vert_prop.with_init = true;
-                    initializer_list.emplace(net.TargetName(edge_name));
+                    initializer_list.emplace(target);
                 }
             }
 
-            for (auto [it, end] = net.InEdges(seed_name); it != end; ++it)
+            for (const auto eh : frozen.InEdges(seed))
             {
-                auto edge_idx = *it;
-                const auto &edge_name = net.NameOf(edge_idx);
-                auto &vert_prop = net.SourceVertex(edge_name);
-                const auto &edge_prop = net.Edge(edge_name);
+                auto &vert_prop = net.Vertex(frozen.Source(eh));
 
                 if (!vert_prop.with_init)
                 {
-                    vert_prop.elev = edge_prop.dif - net.Vertex(seed_name).elev;
+                    vert_prop.elev = dif[eh.id] - seed_elev;
                     vert_prop.with_init = true;
-                    initializer_list.emplace(net.TargetName(edge_name));
+                    initializer_list.emplace(frozen.Target(eh));
                 }
             }
 
@@ -96,40 +102,51 @@ namespace Elevation::Net
         }
     }
 
-    void BuildMatrix(ElevationNet &net, Matrix &A, Matrix &l, Matrix &P, std::vector<ElevationNet::name_type> &unknown, double unit_p)
+    /**
+     * @brief Column of each vertex handle in `unknown`, `-1` for controls
+     *
+     */
+    std::vector<Eigen::Index> UnknownColumns(ElevationNet &net, const std::vector<ElevationNet::name_type> &unknown)
     {
-        auto edges_access = net.Edges();
-        auto verts_access = net.Vertices();
+        std::vector<Eigen::Index> column_of(net.Vertices().Size(), -1);
+        for (size_t c = 0; c != unknown.size(); ++c)
+        {
+            column_of[net.FindVertex(unknown[c]).id] = c;
+        }
+        return column_of;
+    }
 
-        int n = edges_access.Size();
+    void BuildMatrix(ElevationNet &net, const FrozenElevationNet &frozen, Matrix &A, Matrix &l, Matrix &P, std::vector<ElevationNet::name_type> &unknown, double unit_p)
+    {
+        int n = frozen.EdgeCount();
         int t = unknown.size();
 
         A = Matrix::Zero(n, t);
         l = Matrix::Zero(n, 1);
         P = Matrix::Zero(n, n);
 
-        size_t r = 0;
-        for (const auto &e : edges_access.Names())
+        const auto column_of = UnknownColumns(net, unknown);
+        const auto dif = frozen.Field<0>(), len = frozen.Field<1>();
+
+        for (size_t r = 0; r != frozen.EdgeCount(); ++r)
         {
             auto
                 subA = A.row(r),
                 subl = l.row(r);
 
-            auto &edge = net.Edge(e);
-            auto
-                &beg = net.SourceVertex(e),
-                &end = net.TargetVertex(e);
-            auto
-                beg_name = net.SourceName(e),
-                end_name = net.TargetName(e);
+            const EdgeHandle eh{static_cast<std::uint32_t>(r)};
+            const auto
+                beg_h = frozen.Source(eh),
+                end_h = frozen.Target(eh);
+            const auto
+                &beg = net.Vertex(beg_h),
+                &end = net.Vertex(end_h);
 
-            subl(0) += edge.dif;
+            subl(0) += dif[r];
 
             if (!beg.is_control)
             {
-                auto it = std::ranges::find(unknown, beg_name);
-                size_t c = std::distance(unknown.begin(), it);
-                subA(c) = -1;
+                subA(column_of[beg_h.id]) = -1;
                 subl(0) += beg.elev; // value(double)
             }
             else
@@ -139,9 +156,7 @@ namespace Elevation::Net
 
             if (!end.is_control)
             {
-                auto it = std::ranges::find(unknown, end_name);
-                size_t c = std::distance(unknown.begin(), it);
-                subA(c) = 1;
+                subA(column_of[end_h.id]) = 1;
                 subl(0) -= end.elev; // val(double)
             }
             else
@@ -151,9 +166,7 @@ namespace Elevation::Net
 
             subl(0) *= 1000;
 
-            P(r, r) = unit_p / edge.len;
-
-            ++r;
+            P(r, r) = unit_p / len[r];
         }
     }
 
@@ -175,9 +188,9 @@ namespace Elevation::Net
         }
 
         r = 0;
-        for (const auto &e : net.Edges().Names())
+        for (const auto eh : net.EdgeHandles())
         {
-            net.Edge(e).dif += V(r, 0);
+            net.Edge(eh).dif += V(r, 0);
             ++r;
         }
     }
@@ -187,6 +200,58 @@ namespace Elevation::Net
         Matrix A, l, P, x, V;
         std::vector<ElevationNet::name_type> unknown;
     };
+
+    /**
+     * @brief One sparse row per edge (in edge order), same `l` (mm) and `P` as `BuildMatrix` without dense `A`, `P`
+     *
+     */
+    Linalg::HelmertBlocking::Observations BuildObservations(ElevationNet &net, const FrozenElevationNet &frozen, const std::vector<ElevationNet::name_type> &unknown, double unit_p)
+    {
+        const auto column_of = UnknownColumns(net, unknown);
+        const auto dif = frozen.Field<0>(), len = frozen.Field<1>();
+
+        Linalg::HelmertBlocking::Observations obs{};
+        obs.Reserve(frozen.EdgeCount());
+        for (size_t e = 0; e != frozen.EdgeCount(); ++e)
+        {
+            const EdgeHandle eh{static_cast<std::uint32_t>(e)};
+            const auto
+                beg_h = frozen.Source(eh),
+                end_h = frozen.Target(eh);
+            const auto
+                &beg = net.Vertex(beg_h),
+                &end = net.Vertex(end_h);
+            const double
+                l = (dif[e] + beg.elev - end.elev) * 1000,
+                p = unit_p / len[e];
+
+            if (!beg.is_control && !end.is_control)
+            {
+                obs.Add({{column_of[beg_h.id], -1.0}, {column_of[end_h.id], 1.0}}, l, p);
+            }
+            else if (!beg.is_control)
+            {
+                obs.Add({{column_of[beg_h.id], -1.0}}, l, p);
+            }
+            else if (!end.is_control)
+            {
+                obs.Add({{column_of[end_h.id], 1.0}}, l, p);
+            }
+            else
+            {
+                obs.Add({}, l, p);
+            }
+        }
+        return obs;
+    }
+
+    struct ElevationNetPartitionedVariable
+    {
+        Matrix x, V;
+        double vpv;
+        Eigen::Index blocks, junctions, largest_block;
+        std::vector<ElevationNet::name_type> unknown;
+    };
 }
 
 namespace Elevation
@@ -197,17 +262,51 @@ namespace Elevation
     ElevationNetVariable Adjust(ElevationNet &net, double unit_p = 1.0)
     {
         ElevationNetVariable var{};
-        Net::InitializeElevations(net, var.unknown);
-        Net::BuildMatrix(net, var.A, var.l, var.P, var.unknown, unit_p);
+        const auto frozen = Net::Freeze(net);
+        Net::InitializeElevations(net, frozen, var.unknown);
+        Net::BuildMatrix(net, frozen, var.A, var.l, var.P, var.unknown, unit_p);
         Net::ComputeCorrections(var.A, var.l, var.P, var.x, var.V);
         Net::ApplyCorrections(net, var.unknown, var.x, var.V);
 
         return var;
     }
 
+    /**
+     * @brief Adjust large networks by Helmert blocking: stations are split into blocks joined by junction stations,
+     * blocks are eliminated and back-substituted in parallel (see `Linalg::HelmertBlocking`). Gives the same
+     * elevations as `Adjust` without forming dense `A` and `P`, `vpv` is in mm^2.
+     *
+     * @param net
+     * @param unit_p
+     * @param options block size and threads
+     * @return ElevationNetPartitionedVariable
+     */
+    Net::ElevationNetPartitionedVariable AdjustPartitioned(ElevationNet &net, double unit_p = 1.0, const Linalg::HelmertBlocking::Options &options = {})
+    {
+        Net::ElevationNetPartitionedVariable var{};
+        const auto frozen = Net::Freeze(net);
+        Net::InitializeElevations(net, frozen, var.unknown);
+        const auto obs = Net::BuildObservations(net, frozen, var.unknown, unit_p);
+        const auto result = Linalg::HelmertBlocking::Solve(var.unknown.size(), obs, options);
+
+        var.x = result.x / 1000;
+        var.V = Matrix(obs.Size(), 1);
+        for (size_t r = 0; r != obs.Size(); ++r)
+        {
+            var.V(r, 0) = obs.Residual(r, result.x) / 1000;
+        }
+        var.vpv = result.vpv;
+        var.blocks = result.blocks;
+        var.junctions = result.junctions;
+        var.largest_block = result.largest_block;
+        Net::ApplyCorrections(net, var.unknown, var.x, var.V);
+
+        return var;
+    }
+
     void PrintElevationNet(const ElevationNet &net, std::ostream &os = std::cout)
     {
-        for (const auto n : net.Edges().Names())
+        for (const auto &n : net.Edges().NamesView())
         {
             std::println(os, "{} : {}, {} => dif = {}, len = {}",
                          n,
@@ -217,7 +316,7 @@ namespace Elevation
                          net.Edge(n).len);
         }
 
-        for (const auto n : net.Vertices().Names())
+        for (const auto &n : net.Vertices().NamesView())
         {
             std::println(os, "{} : elev = {}, {} control, {} init",
                          n,
@@ -229,6 +328,7 @@ namespace Elevation
 }
 
 using Elevation::Adjust;
+using Elevation::AdjustPartitioned;
 using Elevation::ElevationNet;
 using Elevation::ElevationNetVariable;
 using Elevation::PrintElevationNet;
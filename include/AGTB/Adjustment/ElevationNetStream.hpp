@@ -0,0 +1,373 @@
+#ifndef __AGTB_ADJUSTMENT_ELEVATION_NET_STREAM_HPP__
+#define __AGTB_ADJUSTMENT_ELEVATION_NET_STREAM_HPP__
+
+#include "Base.hpp"
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#include <cmath>
+#include <charconv>
+#include <concepts>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+AGTB_ADJUSTMENT_BEGIN
+
+namespace Elevation::Stream
+{
+    /**
+     * @brief One height difference `H(to) - H(from) = dif` over route length `len`
+     *
+     */
+    struct Observation
+    {
+        std::string from, to;
+        double dif = 0.0;
+        double len = 0.0;
+    };
+
+    /**
+     * @brief Anything that yields observations chunk by chunk and can start over for the second pass.
+     * `Read` overwrites `buffer[0, n)` (reusing its strings) and returns `n`, `0` at the end.
+     *
+     */
+    template <typename __source>
+    concept ObservationSource = requires(__source &s, std::vector<Observation> &buffer) {
+        { s.Read(buffer) } -> std::convertible_to<size_t>;
+        { s.Rewind() };
+    };
+
+    /**
+     * @brief Text file of `from to dif len` per line, fields split by blanks or commas, `#` starts a comment line
+     *
+     */
+    class FileSource
+    {
+    public:
+        explicit FileSource(std::string path)
+            : path_(std::move(path)), file_(path_)
+        {
+            if (!file_)
+            {
+                AGTB_THROW(std::runtime_error, std::format("Cannot open file: {}", path_));
+            }
+        }
+
+        size_t Read(std::vector<Observation> &buffer)
+        {
+            size_t n = 0;
+            while (n != buffer.size() && std::getline(file_, line_))
+            {
+                ++line_number_;
+                std::string_view rest = line_;
+                std::string_view fields[4];
+                size_t count = 0;
+                for (; count != 4; ++count)
+                {
+                    const size_t begin = rest.find_first_not_of(separators);
+                    if (begin == std::string_view::npos || rest[begin] == '#')
+                    {
+                        break;
+                    }
+                    rest.remove_prefix(begin);
+                    const size_t end = std::min(rest.find_first_of(separators), rest.size());
+                    fields[count] = rest.substr(0, end);
+                    rest.remove_prefix(end);
+                }
+                if (count == 0)
+                {
+                    continue;
+                }
+
+                Observation &obs = buffer[n];
+                if (count != 4 || !ToDouble(fields[2], obs.dif) || !ToDouble(fields[3], obs.len))
+                {
+                    AGTB_THROW(std::invalid_argument, std::format("Invalid observation at line {} of {}: '{}'", line_number_, path_, line_));
+                }
+                obs.from.assign(fields[0]);
+                obs.to.assign(fields[1]);
+                ++n;
+            }
+            return n;
+        }
+
+        void Rewind()
+        {
+            file_.clear();
+            file_.seekg(0);
+            line_number_ = 0;
+        }
+
+    private:
+        static constexpr std::string_view separators = " \t\r,";
+
+        static bool ToDouble(std::string_view field, double &value)
+        {
+            auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+            return ec == std::errc{} && ptr == field.data() + field.size();
+        }
+
+        std::string path_;
+        std::ifstream file_;
+        std::string line_{};
+        size_t line_number_{0};
+    };
+
+    /**
+     * @brief `memory_limit` (bytes) bounds the observation chunk and its normal-equation contributions; the chunk
+     * starts small and doubles while the source fills it, so small nets never reach the limit. The normal matrix
+     * itself grows with stations and distinct station pairs, not with observations.
+     *
+     */
+    struct Options
+    {
+        size_t memory_limit = size_t{64} << 20;
+        double unit_p = 1.0;
+    };
+
+    struct Result
+    {
+        std::vector<std::string> unknown;
+        Eigen::VectorXd elev;
+        size_t n, t, chunks, normal_nonzeros;
+        double vpv, m0, max_abs_v;
+
+        std::string ToString() const noexcept
+        {
+            return std::format("{:=^100}\n"
+                               "n : {}\nt : {}\nChunks : {}\nNormal nonzeros : {}\nVPV : {}\nm0 : {}\nmax |V| : {}\n",
+                               " ElevationNetStreamResult ",
+                               n, t, chunks, normal_nonzeros, vpv, m0, max_abs_v);
+        }
+    };
+
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using Triplet = Eigen::Triplet<double>;
+
+    /**
+     * @brief Largest chunk (observations) within `memory_limit`
+     *
+     */
+    inline size_t ChunkSize(const Options &options)
+    {
+        constexpr size_t per_observation = sizeof(Observation) + 3 * sizeof(Triplet) + 32;
+        return std::max<size_t>(options.memory_limit / per_observation, 1);
+    }
+
+    /**
+     * @brief First chunk (observations), grown up to `ChunkSize` while chunks come back full
+     *
+     */
+    inline constexpr size_t initial_chunk = 4096;
+
+    /**
+     * @brief Station of an observation end, either a control height or an unknown index
+     *
+     */
+    struct Station
+    {
+        Eigen::Index index;
+        double elev;
+    };
+
+    class StationTable
+    {
+    public:
+        explicit StationTable(const std::unordered_map<std::string, double> &controls)
+            : controls_(controls)
+        {
+        }
+
+        Station Find(const std::string &name) const
+        {
+            if (auto it = controls_.find(name); it != controls_.end())
+            {
+                return {-1, it->second};
+            }
+            return {indices_.at(name), 0.0};
+        }
+
+        Station FindOrAdd(const std::string &name)
+        {
+            if (auto it = controls_.find(name); it != controls_.end())
+            {
+                return {-1, it->second};
+            }
+            auto [it, added] = indices_.try_emplace(name, static_cast<Eigen::Index>(names_.size()));
+            if (added)
+            {
+                names_.push_back(name);
+            }
+            return {it->second, 0.0};
+        }
+
+        std::vector<std::string> &Names() noexcept
+        {
+            return names_;
+        }
+
+    private:
+        const std::unordered_map<std::string, double> &controls_;
+        std::unordered_map<std::string, Eigen::Index> indices_{};
+        std::vector<std::string> names_{};
+    };
+
+    /**
+     * @brief `l` of `A x - l = V` with controls moved to the right, `a` is `-1` at `from` and `+1` at `to`
+     *
+     */
+    inline double Misclosure(const Observation &obs, const Station &from, const Station &to)
+    {
+        return obs.dif + from.elev - to.elev;
+    }
+}
+
+namespace Elevation
+{
+    /**
+     * @brief Levelling network adjustment over observations that do not fit in memory. The first pass streams
+     * chunks into a sparse, lower-triangular normal system, which is solved once by sparse LDLT; the second pass
+     * streams the observations again for residuals `V` (m) and `m0` (m, unit weight `unit_p / len`).
+     *
+     * @tparam __source
+     * @param source
+     * @param controls known heights by station name
+     * @param options
+     * @param on_residual optional `void(const Observation &, double v)` called for every observation in pass two
+     * @return Stream::Result
+     */
+    template <Stream::ObservationSource __source>
+    Stream::Result AdjustStream(__source &source,
+                                const std::unordered_map<std::string, double> &controls,
+                                const Stream::Options &options = {},
+                                std::function<void(const Stream::Observation &, double)> on_residual = {})
+    {
+        using namespace Stream;
+
+        const size_t max_chunk = ChunkSize(options);
+        std::vector<Observation> buffer(std::min(max_chunk, initial_chunk));
+        std::vector<Triplet> triplets{};
+        StationTable stations(controls);
+
+        SparseMatrix N(0, 0);
+        Eigen::VectorXd W(0);
+        size_t n = 0, chunks = 0;
+
+        for (size_t read = source.Read(buffer); read != 0; read = source.Read(buffer))
+        {
+            triplets.reserve(3 * read);
+            for (size_t i = 0; i != read; ++i)
+            {
+                const Observation &obs = buffer[i];
+                if (!(obs.len > 0.0))
+                {
+                    AGTB_THROW(std::invalid_argument, std::format("Route length of {} -> {} should be positive", obs.from, obs.to));
+                }
+                const Station from = stations.FindOrAdd(obs.from), to = stations.FindOrAdd(obs.to);
+                const double p = options.unit_p / obs.len, l = Misclosure(obs, from, to);
+                const Eigen::Index t = static_cast<Eigen::Index>(stations.Names().size());
+                if (W.size() < t)
+                {
+                    const Eigen::Index old = W.size();
+                    W.conservativeResize(std::max<Eigen::Index>(t, 2 * old));
+                    W.tail(W.size() - old).setZero();
+                }
+                if (from.index >= 0)
+                {
+                    triplets.emplace_back(from.index, from.index, p);
+                    W(from.index) -= p * l;
+                }
+                if (to.index >= 0)
+                {
+                    triplets.emplace_back(to.index, to.index, p);
+                    W(to.index) += p * l;
+                }
+                if (from.index >= 0 && to.index >= 0 && from.index != to.index)
+                {
+                    triplets.emplace_back(std::max(from.index, to.index), std::min(from.index, to.index), -p);
+                }
+            }
+            n += read;
+            ++chunks;
+
+            const Eigen::Index t = static_cast<Eigen::Index>(stations.Names().size());
+            if (t > N.rows())
+            {
+                N.conservativeResize(t, t);
+            }
+            SparseMatrix contribution(t, t);
+            contribution.setFromTriplets(triplets.begin(), triplets.end());
+            N += contribution;
+            triplets.clear();
+
+            if (read == buffer.size() && buffer.size() < max_chunk)
+            {
+                buffer.resize(std::min(max_chunk, 2 * buffer.size()));
+            }
+        }
+
+        const Eigen::Index t = static_cast<Eigen::Index>(stations.Names().size());
+        if (n < static_cast<size_t>(t) || t == 0)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Input data don't support adjustments: n = {}, t = {}", n, t));
+        }
+        W.conservativeResize(t);
+
+        Eigen::SimplicialLDLT<SparseMatrix, Eigen::Lower> ldlt(N);
+        if (ldlt.info() != Eigen::Success || (ldlt.vectorD().array() <= 0.0).any())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Normal equations of {} unknowns are singular, is every part of net connected to a control?", t));
+        }
+        Eigen::VectorXd x = ldlt.solve(W);
+
+        source.Rewind();
+        double vpv = 0.0, max_abs_v = 0.0;
+        size_t n_second = 0;
+        for (size_t read = source.Read(buffer); read != 0; read = source.Read(buffer))
+        {
+            for (size_t i = 0; i != read; ++i)
+            {
+                const Observation &obs = buffer[i];
+                const Station from = stations.Find(obs.from), to = stations.Find(obs.to);
+                const double
+                    H_from = from.index >= 0 ? x(from.index) : 0.0,
+                    H_to = to.index >= 0 ? x(to.index) : 0.0,
+                    v = H_to - H_from - Misclosure(obs, from, to);
+                vpv += options.unit_p / obs.len * v * v;
+                max_abs_v = std::max(max_abs_v, std::abs(v));
+                if (on_residual)
+                {
+                    on_residual(obs, v);
+                }
+            }
+            n_second += read;
+        }
+        if (n_second != n)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Source yields {} observations in second pass, {} in first", n_second, n));
+        }
+
+        return Result{
+            .unknown = std::move(stations.Names()),
+            .elev = std::move(x),
+            .n = n,
+            .t = static_cast<size_t>(t),
+            .chunks = chunks,
+            .normal_nonzeros = static_cast<size_t>(N.nonZeros()),
+            .vpv = vpv,
+            .m0 = n > static_cast<size_t>(t) ? std::sqrt(vpv / (n - t)) : 0.0,
+            .max_abs_v = max_abs_v};
+    }
+}
+
+using Elevation::AdjustStream;
+
+AGTB_ADJUSTMENT_END
+
+#endif
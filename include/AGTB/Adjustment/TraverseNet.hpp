@@ -43,6 +43,17 @@ namespace Traverse::Net
 
     using TraverseNet = NamedGraph<VertexProperty, EdgeProperty>;
 
+    /**
+     * @brief Topology with `len` of every edge (field 0)
+     *
+     */
+    using FrozenTraverseNet = FrozenGraph<double>;
+
+    FrozenTraverseNet Freeze(const TraverseNet &net)
+    {
+        return net.Freeze(&EdgeProperty::len);
+    }
+
     struct CalculationProperty
     {
         double dx{}, dy{}, s0{}, ds{}, a{}, b{};
@@ -66,7 +77,7 @@ namespace Traverse::Net
 
     void PrintTraverseNet(const TraverseNet &net)
     {
-        for (const auto &vert_name : net.Vertices().Names())
+        for (const auto &vert_name : net.Vertices().NamesView())
         {
             const auto &vert = net.Vertex(vert_name);
 
@@ -85,7 +96,7 @@ namespace Traverse::Net
             }
         }
 
-        for (const auto &edge_name : net.Edges().Names())
+        for (const auto &edge_name : net.Edges().NamesView())
         {
             const auto &edge = net.Edge(edge_name);
 
@@ -133,21 +144,21 @@ namespace Traverse::Net
                 .is_virtual = true});
     }
 
-    void InitTraverseNet(TraverseNet &net, TraverseNetVariable &var)
+    void InitTraverseNet(TraverseNet &net, const FrozenTraverseNet &frozen, TraverseNetVariable &var)
     {
         auto &unknown = var.unknown;
         auto edges_access = net.Edges();
-        auto verts_access = net.Vertices();
 
-        std::queue<TraverseNet::name_type> initializer_list{};
+        std::queue<EdgeHandle> initializer_list{};
 
-        for (const auto &vert_name : verts_access.Names())
+        for (const auto vh : net.VertexHandles())
         {
-            const auto &vert = net.Vertex(vert_name);
+            const auto &vert_name = net.NameOf(vh);
+            const auto &vert = net.Vertex(vh);
 
-            for (auto [it, end] = net.InEdges(vert_name); it != end; ++it)
+            for (const auto eh : frozen.InEdges(vh))
             {
-                const auto &ename = net.NameOf(*it);
+                const auto &ename = net.NameOf(eh);
                 const auto &prop = vert.property.at(ename);
 
                 if (!prop.is_control && !prop.is_virtual)
@@ -163,11 +174,12 @@ namespace Traverse::Net
 
         std::vector<BuildItem> cal_list{};
 
-        for (const auto &vert_name : verts_access.Names())
+        for (const auto vh : net.VertexHandles())
         {
-            auto &vert = net.Vertex(vert_name);
-            for (const auto &ename : net.InEdgesOf(vert_name))
+            auto &vert = net.Vertex(vh);
+            for (const auto in : frozen.InEdges(vh))
             {
+                const auto &ename = net.NameOf(in);
                 auto &prop = vert.property.at(ename);
                 if (!prop.is_control)
                 {
@@ -175,14 +187,14 @@ namespace Traverse::Net
                 }
 
                 prop.in_queue = true;
-                for (const auto &out_name : net.OutEdgesOf(vert_name))
+                for (const auto out : frozen.OutEdges(vh))
                 {
                     BuildItem item{
-                        .cur_vert = vert_name,
-                        .pre_vert = net.SourceName(ename),
-                        .nxt_vert = net.TargetName(out_name),
+                        .cur_vert = net.NameOf(vh),
+                        .pre_vert = net.NameOf(frozen.Source(in)),
+                        .nxt_vert = net.NameOf(frozen.Target(out)),
                         .in = ename,
-                        .out = out_name,
+                        .out = net.NameOf(out),
                         .pre_in = ename};
 
                     cal_list.push_back(item);
@@ -203,7 +215,7 @@ namespace Traverse::Net
                 std::println("|-{}, {}", k, v.beta.ToString());
             }
 
-            for (const auto &ename : net.EdgesOf(cur_vert))
+            for (const auto &ename : net.EdgesView(cur_vert))
             {
                 std::println("in: ", ename);
             }
@@ -211,11 +223,11 @@ namespace Traverse::Net
             std::println("{}", "over loop");
         }
 
-        for (const auto &edge_name : edges_access.Names())
+        for (const auto eh : net.EdgeHandles())
         {
-            if (net.Edge(edge_name).is_control)
+            if (net.Edge(eh).is_control)
             {
-                initializer_list.push(edge_name);
+                initializer_list.push(eh);
             }
         }
 
@@ -224,27 +236,26 @@ namespace Traverse::Net
 
         while (!initializer_list.empty())
         {
-            const auto &seed_edge_name = initializer_list.front();
-            const auto &known_edge = net.Edge(seed_edge_name);
-            const auto &known_vert = net.TargetVertex(seed_edge_name);
-            const auto &known_vert_name = net.TargetName(seed_edge_name);
+            const auto seed = initializer_list.front();
+            const auto &seed_edge_name = net.NameOf(seed);
+            const auto &known_edge = net.Edge(seed);
+            const auto &known_vert = net.Vertex(frozen.Target(seed));
 
-            // std::println("known edge: {}, known vert: {}", seed_edge_name, known_vert_name);
+            // std::println("known edge: {}, known vert: {}", seed_edge_name, net.NameOf(frozen.Target(seed)));
 
-            for (auto [it, end] = net.OutEdges(known_vert_name); it != end; ++it)
+            for (const auto eh : frozen.OutEdges(frozen.Target(seed)))
             {
-                auto eidx = *it;
-                const auto &ename = net.NameOf(eidx);
-                auto &unknown_edge = net.Edge(eidx);
-                auto &unknown_vert = net.TargetVertex(ename);
+                const auto &ename = net.NameOf(eh);
+                auto &unknown_edge = net.Edge(eh);
+                auto &unknown_vert = net.Vertex(frozen.Target(eh));
                 auto &unknown_prop = unknown_vert.property.at(ename);
                 auto &seed_prop = known_vert.property.at(seed_edge_name);
 
-                // std::println("unknown edge: {}, unknwon vert: {}", ename, net.TargetName(ename));
+                // std::println("unknown edge: {}, unknwon vert: {}", ename, net.NameOf(frozen.Target(eh)));
 
                 unknown_edge.azimuth = (known_edge.azimuth + seed_prop.beta - Utils::Angles::ang_180d).NormStd();
                 unknown_edge.with_init = true;
-                initializer_list.push(ename);
+                initializer_list.push(eh);
 
                 if (unknown_prop.with_init)
                 {
@@ -252,7 +263,7 @@ namespace Traverse::Net
                 }
 
                 double
-                    s = unknown_edge.len,
+                    s = frozen.Field<0>(eh),
                     cos = unknown_edge.azimuth.Cos(),
                     sin = unknown_edge.azimuth.Sin(),
                     dx = s * cos,
@@ -381,15 +392,15 @@ namespace Traverse::Net
         ++srow;
     }
 
-    void BuildMatrix(TraverseNet &net, double unit_p, TraverseNetVariable &var)
+    void BuildMatrix(TraverseNet &net, const FrozenTraverseNet &frozen, double unit_p, TraverseNetVariable &var)
     {
         int n, r, t, na, ns{0};
 
         t = var.unknown.size();
-        na = net.Edges().Size();
-        for (const auto &v : net.Vertices().Names())
+        na = frozen.EdgeCount();
+        for (const auto vh : net.VertexHandles())
         {
-            ns += net.Vertex(v).property.size();
+            ns += net.Vertex(vh).property.size();
         }
         n = na + ns;
 
@@ -397,29 +408,27 @@ namespace Traverse::Net
         var.l = Matrix(n, 1);
         var.P = Matrix::Identity(n, n);
 
-        auto edges_access = net.Edges();
-        auto verts_access = net.Vertices();
-
         std::queue<BuildItem> cal_list{};
 
-        for (const auto &vert_name : verts_access.Names())
+        for (const auto vh : net.VertexHandles())
         {
-            const auto &vert = net.Vertex(vert_name);
-            for (const auto &ename : net.InEdgesOf(vert_name))
+            const auto &vert = net.Vertex(vh);
+            for (const auto in : frozen.InEdges(vh))
             {
+                const auto &ename = net.NameOf(in);
                 const auto &prop = vert.property.at(ename);
                 if (!prop.is_control)
                 {
                     continue;
                 }
-                for (const auto &out_name : net.OutEdgesOf(vert_name))
+                for (const auto out : frozen.OutEdges(vh))
                 {
                     BuildItem item{
-                        .cur_vert = vert_name,
-                        .pre_vert = net.SourceName(ename),
-                        .nxt_vert = net.TargetName(out_name),
+                        .cur_vert = net.NameOf(vh),
+                        .pre_vert = net.NameOf(frozen.Source(in)),
+                        .nxt_vert = net.NameOf(frozen.Target(out)),
                         .in = ename,
-                        .out = out_name,
+                        .out = net.NameOf(out),
                         .pre_in = ename};
 
                     cal_list.push(item);
@@ -467,8 +476,9 @@ namespace Traverse
     {
         TraverseNetVariable var{};
 
-        Net::InitTraverseNet(net, var);
-        Net::BuildMatrix(net, unit_p, var);
+        const auto frozen = Net::Freeze(net);
+        Net::InitTraverseNet(net, frozen, var);
+        Net::BuildMatrix(net, frozen, unit_p, var);
 
         return var;
     }
@@ -0,0 +1,911 @@
+#ifndef __AGTB_CONTAINER_COLUMNAR_DATAFRAME_HPP__
+#define __AGTB_CONTAINER_COLUMNAR_DATAFRAME_HPP__
+
+#include "../details/Macros.hpp"
+#include "../Utils/Parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <Eigen/Dense>
+
+AGTB_CONTAINER_BEGIN
+
+/**
+ * @brief Element type of a `ColumnarDataFrame` column
+ *
+ */
+enum class ColumnType
+{
+    String,
+    Integer,
+    Real
+};
+
+inline std::string_view ToString(ColumnType type) noexcept
+{
+    switch (type)
+    {
+    case ColumnType::String:
+        return "string";
+    case ColumnType::Integer:
+        return "integer";
+    default:
+        return "real";
+    }
+}
+
+/**
+ * @brief Aggregates of `ColumnarDataFrame::Reduce` and `GroupBy`. NaN are skipped, `Var` / `Std` are sample
+ * statistics (`n - 1`), `Rms` is `sqrt(mean(x^2))`.
+ *
+ */
+enum class Aggregate
+{
+    Count,
+    Sum,
+    Mean,
+    Min,
+    Max,
+    Var,
+    Std,
+    Rms
+};
+
+inline std::string_view ToString(Aggregate aggregate) noexcept
+{
+    switch (aggregate)
+    {
+    case Aggregate::Count:
+        return "count";
+    case Aggregate::Sum:
+        return "sum";
+    case Aggregate::Mean:
+        return "mean";
+    case Aggregate::Min:
+        return "min";
+    case Aggregate::Max:
+        return "max";
+    case Aggregate::Var:
+        return "var";
+    case Aggregate::Std:
+        return "std";
+    default:
+        return "rms";
+    }
+}
+
+namespace detail::ColumnarDataFrame
+{
+    /**
+     * @brief Count, sum, mean, sum of squared deviations, min and max of a range, mergeable (Chan et al.) so chunks
+     * can be reduced in parallel
+     *
+     */
+    struct Moments
+    {
+        double count = 0.0;
+        double sum = 0.0;
+        double mean = 0.0;
+        double m2 = 0.0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+
+        /**
+         * @brief Vectorized passes over `x`, NaN skipped
+         *
+         */
+        static Moments Of(const Eigen::Ref<const Eigen::ArrayXd> &x)
+        {
+            const auto valid = (x == x);
+            Moments m{};
+            m.count = static_cast<double>(valid.count());
+            if (m.count == 0.0)
+            {
+                return m;
+            }
+            m.sum = valid.select(x, 0.0).sum();
+            m.mean = m.sum / m.count;
+            m.m2 = valid.select(x - m.mean, 0.0).square().sum();
+            m.min = valid.select(x, std::numeric_limits<double>::infinity()).minCoeff();
+            m.max = valid.select(x, -std::numeric_limits<double>::infinity()).maxCoeff();
+            return m;
+        }
+
+        void Merge(const Moments &other) noexcept
+        {
+            if (other.count == 0.0)
+            {
+                return;
+            }
+            const double n = count + other.count, delta = other.mean - mean;
+            mean += delta * other.count / n;
+            m2 += other.m2 + delta * delta * count * other.count / n;
+            count = n;
+            sum += other.sum;
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+        }
+
+        double Get(Aggregate aggregate) const noexcept
+        {
+            constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+            switch (aggregate)
+            {
+            case Aggregate::Count:
+                return count;
+            case Aggregate::Sum:
+                return sum;
+            case Aggregate::Mean:
+                return count > 0.0 ? mean : nan;
+            case Aggregate::Min:
+                return count > 0.0 ? min : nan;
+            case Aggregate::Max:
+                return count > 0.0 ? max : nan;
+            case Aggregate::Var:
+                return count > 1.0 ? m2 / (count - 1.0) : nan;
+            case Aggregate::Std:
+                return count > 1.0 ? std::sqrt(m2 / (count - 1.0)) : nan;
+            default:
+                return count > 0.0 ? std::sqrt(mean * mean + m2 / count) : nan;
+            }
+        }
+    };
+
+    /**
+     * @brief Rows per chunk of parallel reductions, fixed so results do not depend on the thread count
+     *
+     */
+    constexpr Eigen::Index reduce_chunk = 1 << 16;
+
+    template <typename T>
+    concept ColumnValue =
+        std::same_as<T, std::string> ||
+        std::same_as<T, std::int64_t> ||
+        std::same_as<T, double>;
+
+    template <typename T>
+    concept NumericColumnValue = ColumnValue<T> && !std::same_as<T, std::string>;
+
+    /**
+     * @brief Alternatives are in `ColumnType` order
+     *
+     */
+    using Column = std::variant<std::vector<std::string>, std::vector<std::int64_t>, std::vector<double>>;
+
+    template <ColumnValue T>
+    constexpr ColumnType ColumnTypeOf() noexcept
+    {
+        if constexpr (std::same_as<T, std::string>)
+        {
+            return ColumnType::String;
+        }
+        else if constexpr (std::same_as<T, std::int64_t>)
+        {
+            return ColumnType::Integer;
+        }
+        else
+        {
+            return ColumnType::Real;
+        }
+    }
+}
+
+/**
+ * @brief `DataFrame` with typed columns (string, 64-bit integer, double), each stored contiguously. Numeric columns
+ * are exposed as zero-copy `Eigen::Map`, so tables parsed once feed batch kernels without further conversion.
+ *
+ * @tparam __row_key_type
+ * @tparam __col_key_type
+ */
+template <
+    typename __row_key_type = std::string,
+    typename __col_key_type = std::string>
+class ColumnarDataFrame
+{
+public:
+    using row_key_type = __row_key_type;
+    using col_key_type = __col_key_type;
+
+    using string_type = std::string;
+    using integer_type = std::int64_t;
+    using real_type = double;
+    using column_type = detail::ColumnarDataFrame::Column;
+
+    template <typename T>
+    using series_of = std::vector<T>;
+    template <typename T>
+    using numeric_series_of = Eigen::Map<Eigen::Vector<T, Eigen::Dynamic>>;
+    template <typename T>
+    using const_numeric_series_of = Eigen::Map<const Eigen::Vector<T, Eigen::Dynamic>>;
+    template <typename T>
+    using numeric_frame_of = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+
+    using row_keys_type = std::vector<row_key_type>;
+    using col_keys_type = std::vector<col_key_type>;
+
+private:
+    std::vector<column_type> columns;
+    row_keys_type row_keys;
+    col_keys_type col_keys;
+
+public:
+    ~ColumnarDataFrame() = default;
+    ColumnarDataFrame() = default;
+
+    /**
+     * @brief Empty frame of `rows` rows keyed by position, columns are added by `AddColumn`
+     *
+     * @param rows
+     */
+    explicit ColumnarDataFrame(size_t rows)
+        : row_keys(__PositionKeys(rows))
+    {
+    }
+
+    /**
+     * @brief Append a column, its size must match `Rows()` unless the frame has neither rows nor columns yet
+     *
+     * @tparam T `std::string`, `std::int64_t` or `double`
+     * @param key
+     * @param values
+     * @return series_of<T>& the stored column
+     */
+    template <detail::ColumnarDataFrame::ColumnValue T>
+    series_of<T> &AddColumn(const col_key_type &key, series_of<T> values)
+    {
+        if (std::ranges::find(col_keys, key) != col_keys.end())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Column key already exists: {}", key));
+        }
+        if (columns.empty() && row_keys.empty())
+        {
+            row_keys = __PositionKeys(values.size());
+        }
+        if (values.size() != Rows())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Column {} has {} rows, frame has {}", key, values.size(), Rows()));
+        }
+        col_keys.emplace_back(key);
+        return std::get<series_of<T>>(columns.emplace_back(std::move(values)));
+    }
+
+    /**
+     * @brief Append a value-initialized column of `Rows()` elements
+     *
+     */
+    template <detail::ColumnarDataFrame::ColumnValue T>
+    series_of<T> &AddColumn(const col_key_type &key)
+    {
+        return AddColumn<T>(key, series_of<T>(Rows()));
+    }
+
+    size_t Rows() const noexcept
+    {
+        return row_keys.size();
+    }
+
+    size_t Cols() const noexcept
+    {
+        return columns.size();
+    }
+
+    ColumnType TypeOf(size_t col_idx) const
+    {
+        return static_cast<ColumnType>(__Column(col_idx).index());
+    }
+
+    ColumnType TypeOf(const col_key_type &ck) const
+    {
+        return TypeOf(ColIndex(ck));
+    }
+
+    /**
+     * @brief Position of column `ck`
+     *
+     * @param ck
+     * @return size_t
+     */
+    size_t ColIndex(const col_key_type &ck) const
+    {
+        auto it = std::ranges::find(col_keys, ck);
+        if (it == col_keys.end())
+        {
+            AGTB_THROW(std::out_of_range, std::format("{}{}", "Column key not found: ", ck));
+        }
+        return std::distance(col_keys.begin(), it);
+    }
+
+    /**
+     * @brief Typed column, throws if the column holds another type
+     *
+     */
+    template <detail::ColumnarDataFrame::ColumnValue T>
+    series_of<T> &ILoc(size_t col_idx)
+    {
+        return __Typed<T>(__Column(col_idx), col_idx);
+    }
+
+    template <detail::ColumnarDataFrame::ColumnValue T>
+    const series_of<T> &ILoc(size_t col_idx) const
+    {
+        return __Typed<T>(__Column(col_idx), col_idx);
+    }
+
+    template <detail::ColumnarDataFrame::ColumnValue T>
+    T &ILoc(size_t row_idx, size_t col_idx)
+    {
+        return __Typed<T>(__Column(col_idx), col_idx).at(row_idx);
+    }
+
+    template <detail::ColumnarDataFrame::ColumnValue T>
+    const T &ILoc(size_t row_idx, size_t col_idx) const
+    {
+        return __Typed<T>(__Column(col_idx), col_idx).at(row_idx);
+    }
+
+    template <detail::ColumnarDataFrame::ColumnValue T>
+    series_of<T> &Loc(const col_key_type &ck)
+    {
+        return ILoc<T>(ColIndex(ck));
+    }
+
+    template <detail::ColumnarDataFrame::ColumnValue T>
+    const series_of<T> &Loc(const col_key_type &ck) const
+    {
+        return ILoc<T>(ColIndex(ck));
+    }
+
+    /**
+     * @brief Zero-copy `Eigen::Map` of a numeric column, `T` must be the stored type
+     *
+     */
+    template <detail::ColumnarDataFrame::NumericColumnValue T>
+    numeric_series_of<T> NumericSeries(size_t col_idx)
+    {
+        auto &col = ILoc<T>(col_idx);
+        return numeric_series_of<T>(col.data(), col.size());
+    }
+
+    template <detail::ColumnarDataFrame::NumericColumnValue T>
+    const_numeric_series_of<T> NumericSeries(size_t col_idx) const
+    {
+        const auto &col = ILoc<T>(col_idx);
+        return const_numeric_series_of<T>(col.data(), col.size());
+    }
+
+    template <detail::ColumnarDataFrame::NumericColumnValue T>
+    numeric_series_of<T> NumericSeries(const col_key_type &ck)
+    {
+        return NumericSeries<T>(ColIndex(ck));
+    }
+
+    template <detail::ColumnarDataFrame::NumericColumnValue T>
+    const_numeric_series_of<T> NumericSeries(const col_key_type &ck) const
+    {
+        return NumericSeries<T>(ColIndex(ck));
+    }
+
+    /**
+     * @brief Copy numeric columns `cks` side by side into a column major matrix, integer columns are cast
+     *
+     * @tparam T
+     * @param cks
+     * @return numeric_frame_of<T>
+     */
+    template <typename T>
+        requires std::floating_point<T> || std::integral<T>
+    numeric_frame_of<T> NumericFrame(const std::vector<col_key_type> &cks) const
+    {
+        numeric_frame_of<T> result(Rows(), cks.size());
+        for (size_t c = 0; c != cks.size(); ++c)
+        {
+            const size_t ci = ColIndex(cks[c]);
+            std::visit(
+                [&]<typename V>(const std::vector<V> &col)
+                {
+                    if constexpr (std::same_as<V, std::string>)
+                    {
+                        AGTB_THROW(std::invalid_argument, std::format("Column {} is not numeric", cks[c]));
+                    }
+                    else
+                    {
+                        result.col(c) = Eigen::Map<const Eigen::Vector<V, Eigen::Dynamic>>(col.data(), col.size()).template cast<T>();
+                    }
+                },
+                columns[ci]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Write an Eigen expression (e.g. of `NumericSeries`) to column `key`, added if missing and replaced if
+     * its type differs. Element type follows the expression: floating point to `double`, integral and bool to
+     * `std::int64_t`.
+     *
+     * @param key
+     * @param expr `Rows()` x 1
+     * @return Reference to the column
+     */
+    template <typename __expr>
+    decltype(auto) Assign(const col_key_type &key, const Eigen::DenseBase<__expr> &expr)
+    {
+        using scalar = typename __expr::Scalar;
+        using T = std::conditional_t<std::floating_point<scalar>, double, std::int64_t>;
+        if (expr.size() != static_cast<Eigen::Index>(Rows()) || expr.cols() != 1)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Expression ({}, {}) does not fit {} rows", expr.rows(), expr.cols(), Rows()));
+        }
+
+        series_of<T> values(Rows());
+        numeric_series_of<T>(values.data(), values.size()) = expr.derived().template cast<T>();
+        auto it = std::ranges::find(col_keys, key);
+        if (it == col_keys.end())
+        {
+            return AddColumn<T>(key, std::move(values));
+        }
+        return std::get<series_of<T>>(columns[std::distance(col_keys.begin(), it)] = std::move(values));
+    }
+
+    /**
+     * @brief Aggregate one numeric column, NaN skipped. Chunks of fixed size are reduced on `threads` threads.
+     * `Sum` of an integer column is exact, as in `GroupBy`.
+     *
+     * @param ck
+     * @param aggregate
+     * @param threads `0` means `Utils::HardwareThreads()`
+     * @return double
+     */
+    double Reduce(const col_key_type &ck, Aggregate aggregate, size_t threads = 0) const
+    {
+        using detail::ColumnarDataFrame::Moments;
+        using detail::ColumnarDataFrame::reduce_chunk;
+
+        const size_t ci = ColIndex(ck);
+        const Eigen::Index n = Rows(), chunks = (n + reduce_chunk - 1) / reduce_chunk;
+
+        // Integers summed exactly, rounded to double once
+        if (const auto *integers = std::get_if<std::vector<std::int64_t>>(&columns[ci]); integers != nullptr && aggregate == Aggregate::Sum)
+        {
+            std::vector<std::int64_t> sums(chunks);
+            Utils::ParallelFor(
+                chunks,
+                [&](size_t chunk)
+                {
+                    const Eigen::Index begin = chunk * reduce_chunk, size = std::min(reduce_chunk, n - begin);
+                    sums[chunk] = Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic, 1>>(integers->data() + begin, size).sum();
+                },
+                threads);
+            return static_cast<double>(std::accumulate(sums.begin(), sums.end(), std::int64_t{0}));
+        }
+
+        std::vector<Moments> partial(chunks);
+        Utils::ParallelFor(
+            chunks,
+            [&](size_t chunk)
+            {
+                const Eigen::Index begin = chunk * reduce_chunk, size = std::min(reduce_chunk, n - begin);
+                partial[chunk] = std::visit(
+                    [&]<typename V>(const std::vector<V> &col)
+                    {
+                        if constexpr (std::same_as<V, std::string>)
+                        {
+                            AGTB_THROW(std::invalid_argument, std::format("Column {} is not numeric", ck));
+                            return Moments{};
+                        }
+                        else if constexpr (std::same_as<V, double>)
+                        {
+                            return Moments::Of(Eigen::Map<const Eigen::ArrayXd>(col.data() + begin, size));
+                        }
+                        else
+                        {
+                            return Moments::Of(Eigen::Map<const Eigen::Array<V, Eigen::Dynamic, 1>>(col.data() + begin, size).template cast<double>());
+                        }
+                    },
+                    columns[ci]);
+            },
+            threads);
+
+        Moments total{};
+        for (const auto &m : partial)
+        {
+            total.Merge(m);
+        }
+        return total.Get(aggregate);
+    }
+
+    /**
+     * @brief Rows where `mask` is true, every column copied on `threads` threads. Masks come from comparisons of
+     * numeric columns, e.g. `df.NumericSeries<double>("dH").array().abs() < 0.01`.
+     *
+     * @param mask `Rows()` x 1
+     * @param threads
+     * @return ColumnarDataFrame
+     */
+    ColumnarDataFrame Filter(const Eigen::Array<bool, Eigen::Dynamic, 1> &mask, size_t threads = 0) const
+    {
+        if (mask.size() != static_cast<Eigen::Index>(Rows()))
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Mask of {} rows for {} rows", mask.size(), Rows()));
+        }
+
+        std::vector<size_t> kept{};
+        kept.reserve(mask.count());
+        for (Eigen::Index r = 0; r != mask.size(); ++r)
+        {
+            if (mask(r))
+            {
+                kept.emplace_back(r);
+            }
+        }
+
+        ColumnarDataFrame result{};
+        result.row_keys.resize(kept.size());
+        result.col_keys = col_keys;
+        result.columns.resize(Cols());
+        Utils::ParallelFor(
+            Cols() + 1,
+            [&](size_t c)
+            {
+                if (c == Cols())
+                {
+                    for (size_t i = 0; i != kept.size(); ++i)
+                    {
+                        result.row_keys[i] = row_keys[kept[i]];
+                    }
+                    return;
+                }
+                std::visit(
+                    [&]<typename V>(const std::vector<V> &col)
+                    {
+                        std::vector<V> out(kept.size());
+                        for (size_t i = 0; i != kept.size(); ++i)
+                        {
+                            out[i] = col[kept[i]];
+                        }
+                        result.columns[c] = std::move(out);
+                    },
+                    columns[c]);
+            },
+            threads);
+        return result;
+    }
+
+    /**
+     * @brief Group rows by the values of column `by` (hashed), then aggregate columns per group. Rows are
+     * counting-sorted by group first, so each group is a contiguous segment reduced with vectorized passes, columns
+     * are done on `threads` threads.
+     *
+     * @param by key column of any type
+     * @param aggregates pairs of column and aggregate, result column is named `<column>_<aggregate>`
+     * @param sort groups ordered by key, otherwise by first appearance. NaN keys make one group, sorted last
+     * @param threads
+     * @return ColumnarDataFrame one row per group, column `by` first
+     */
+    ColumnarDataFrame GroupBy(const col_key_type &by, const std::vector<std::pair<col_key_type, Aggregate>> &aggregates, bool sort = true, size_t threads = 0) const
+        requires std::constructible_from<col_key_type, std::string>
+    {
+        using detail::ColumnarDataFrame::Moments;
+
+        const size_t rows = Rows();
+        std::vector<uint32_t> group_of(rows);
+        ColumnarDataFrame result{};
+        size_t groups = 0;
+
+        std::visit(
+            [&]<typename K>(const std::vector<K> &keys)
+            {
+                std::unordered_map<K, uint32_t> ids{};
+                std::vector<K> group_keys{};
+                uint32_t nan_group = std::numeric_limits<uint32_t>::max();
+                for (size_t r = 0; r != rows; ++r)
+                {
+                    if constexpr (std::floating_point<K>)
+                    {
+                        // NaN != NaN, all of them go to one group instead of one group each
+                        if (std::isnan(keys[r]))
+                        {
+                            if (nan_group == std::numeric_limits<uint32_t>::max())
+                            {
+                                nan_group = static_cast<uint32_t>(group_keys.size());
+                                group_keys.emplace_back(keys[r]);
+                            }
+                            group_of[r] = nan_group;
+                            continue;
+                        }
+                    }
+                    auto [it, inserted] = ids.try_emplace(keys[r], static_cast<uint32_t>(group_keys.size()));
+                    if (inserted)
+                    {
+                        group_keys.emplace_back(keys[r]);
+                    }
+                    group_of[r] = it->second;
+                }
+                groups = group_keys.size();
+
+                if (sort)
+                {
+                    std::vector<uint32_t> order(groups), rank(groups);
+                    std::iota(order.begin(), order.end(), 0u);
+                    std::ranges::sort(order, [&](uint32_t a, uint32_t b)
+                                      {
+                                          if constexpr (std::floating_point<K>)
+                                          {
+                                              // NaN group last
+                                              if (std::isnan(group_keys[a]) || std::isnan(group_keys[b]))
+                                              {
+                                                  return !std::isnan(group_keys[a]);
+                                              }
+                                          }
+                                          return group_keys[a] < group_keys[b]; });
+                    std::vector<K> sorted_keys(groups);
+                    for (uint32_t g = 0; g != groups; ++g)
+                    {
+                        rank[order[g]] = g;
+                        sorted_keys[g] = std::move(group_keys[order[g]]);
+                    }
+                    group_keys = std::move(sorted_keys);
+                    for (auto &g : group_of)
+                    {
+                        g = rank[g];
+                    }
+                }
+                result = ColumnarDataFrame(groups);
+                result.AddColumn<K>(by, std::move(group_keys));
+            },
+            __Column(ColIndex(by)));
+
+        // Counting sort: rows of group g are perm[offsets[g], offsets[g + 1])
+        std::vector<size_t> offsets(groups + 1, 0), perm(rows);
+        for (uint32_t g : group_of)
+        {
+            ++offsets[g + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        {
+            std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t r = 0; r != rows; ++r)
+            {
+                perm[fill[group_of[r]]++] = r;
+            }
+        }
+
+        std::vector<column_type> outputs(aggregates.size());
+        Utils::ParallelFor(
+            aggregates.size(),
+            [&](size_t a)
+            {
+                const auto &[ck, aggregate] = aggregates[a];
+                Eigen::ArrayXd gathered(rows);
+                std::visit(
+                    [&]<typename V>(const std::vector<V> &col)
+                    {
+                        if constexpr (std::same_as<V, std::string>)
+                        {
+                            if (aggregate != Aggregate::Count)
+                            {
+                                AGTB_THROW(std::invalid_argument, std::format("Column {} is not numeric", ck));
+                            }
+                            gathered.setZero();
+                        }
+                        else
+                        {
+                            for (size_t i = 0; i != rows; ++i)
+                            {
+                                gathered(i) = static_cast<double>(col[perm[i]]);
+                            }
+                        }
+                    },
+                    __Column(ColIndex(ck)));
+
+                std::vector<double> values(groups);
+                for (size_t g = 0; g != groups; ++g)
+                {
+                    values[g] = Moments::Of(gathered.segment(offsets[g], offsets[g + 1] - offsets[g])).Get(aggregate);
+                }
+                if (aggregate == Aggregate::Sum)
+                {
+                    // Integers summed exactly, rounded to double once
+                    std::visit(
+                        [&]<typename V>(const std::vector<V> &col)
+                        {
+                            if constexpr (std::integral<V>)
+                            {
+                                for (size_t g = 0; g != groups; ++g)
+                                {
+                                    std::int64_t sum = 0;
+                                    for (size_t i = offsets[g]; i != offsets[g + 1]; ++i)
+                                    {
+                                        sum += static_cast<std::int64_t>(col[perm[i]]);
+                                    }
+                                    values[g] = static_cast<double>(sum);
+                                }
+                            }
+                        },
+                        __Column(ColIndex(ck)));
+                }
+                if (aggregate == Aggregate::Count)
+                {
+                    outputs[a] = std::vector<std::int64_t>(values.begin(), values.end());
+                }
+                else
+                {
+                    outputs[a] = std::move(values);
+                }
+            },
+            threads);
+
+        for (size_t a = 0; a != aggregates.size(); ++a)
+        {
+            const auto &[ck, aggregate] = aggregates[a];
+            std::visit(
+                [&](auto &values)
+                { result.AddColumn(col_key_type(std::format("{}_{}", ck, Container::ToString(aggregate))), std::move(values)); },
+                outputs[a]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Cell formatted as text
+     *
+     */
+    std::string Cell(size_t row_idx, size_t col_idx) const
+    {
+        return std::visit(
+            [&](const auto &col)
+            { return std::format("{}", col.at(row_idx)); },
+            __Column(col_idx));
+    }
+
+    std::string ToString() const
+    {
+        std::string str{};
+
+        str.append("\t");
+        for (size_t c = 0; c != Cols(); ++c)
+        {
+            str.append(std::format("{}({})", col_keys[c], Container::ToString(TypeOf(c))));
+            str.append(c != Cols() - 1 ? " \t" : "\n");
+        }
+        if (Cols() == 0)
+        {
+            str.append("\n");
+        }
+        for (size_t r = 0; r != Rows(); ++r)
+        {
+            str.append(std::format("{}: ", row_keys[r]));
+            for (size_t c = 0; c != Cols(); ++c)
+            {
+                str.append(Cell(r, c));
+                if (c != Cols() - 1)
+                {
+                    str.append(", ");
+                }
+            }
+            str.append("\n");
+        }
+        return str;
+    }
+
+    col_keys_type &ColKeys() noexcept
+    {
+        return col_keys;
+    }
+
+    const col_keys_type &ColKeys() const noexcept
+    {
+        return col_keys;
+    }
+
+    col_key_type &ColKeys(size_t idx)
+    {
+        return col_keys.at(idx);
+    }
+
+    const col_key_type &ColKeys(size_t idx) const
+    {
+        return col_keys.at(idx);
+    }
+
+    row_keys_type &RowKeys() noexcept
+    {
+        return row_keys;
+    }
+
+    const row_keys_type &RowKeys() const noexcept
+    {
+        return row_keys;
+    }
+
+    row_key_type &RowKeys(size_t idx)
+    {
+        return row_keys.at(idx);
+    }
+
+    const row_key_type &RowKeys(size_t idx) const
+    {
+        return row_keys.at(idx);
+    }
+
+    /**
+     * @brief Underlying column, `std::variant` of `std::vector`s
+     *
+     */
+    const column_type &Unwrap(size_t col_idx) const
+    {
+        return __Column(col_idx);
+    }
+
+private:
+    static row_keys_type __PositionKeys(size_t rows)
+    {
+        row_keys_type keys(rows);
+        for (size_t r = 0; r != rows; ++r)
+        {
+            if constexpr (std::integral<row_key_type>)
+            {
+                keys[r] = static_cast<row_key_type>(r);
+            }
+            else if constexpr (std::constructible_from<row_key_type, std::string>)
+            {
+                keys[r] = row_key_type(std::to_string(r));
+            }
+        }
+        return keys;
+    }
+
+    const column_type &__Column(size_t col_idx) const
+    {
+        if (col_idx >= Cols())
+        {
+            AGTB_THROW(std::out_of_range, std::format("Column index {} out of range", col_idx));
+        }
+        return columns[col_idx];
+    }
+
+    column_type &__Column(size_t col_idx)
+    {
+        if (col_idx >= Cols())
+        {
+            AGTB_THROW(std::out_of_range, std::format("Column index {} out of range", col_idx));
+        }
+        return columns[col_idx];
+    }
+
+    template <typename T, typename __column>
+    auto &__Typed(__column &col, size_t col_idx) const
+    {
+        auto *typed = std::get_if<series_of<T>>(&col);
+        if (typed == nullptr)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Column {} holds {}, not {}", col_keys[col_idx],
+                                                          Container::ToString(static_cast<ColumnType>(col.index())),
+                                                          Container::ToString(detail::ColumnarDataFrame::ColumnTypeOf<T>())));
+        }
+        return *typed;
+    }
+};
+
+AGTB_CONTAINER_END
+
+AGTB_BEGIN
+
+using Container::Aggregate;
+using Container::ColumnarDataFrame;
+using Container::ColumnType;
+
+AGTB_END
+
+#endif
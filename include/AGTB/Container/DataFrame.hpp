@@ -2,9 +2,15 @@
 #define __AGTB_CONTAINER_DATAFRAME_HPP__
 
 #include "../details/Macros.hpp"
+#include "../Utils/CharConv.hpp"
 
 #include <string>
+#include <string_view>
 #include <format>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include <unordered_map>
 
 #include <Eigen/Dense>
 
@@ -226,6 +232,80 @@ template <
     typename __col_key_type = std::string>
 class DataFrameView;
 
+/**
+ * @brief Hash index from key to its first position in a key series, same result as a `std::find` scan. Built on
+ * the first lookup, dropped by `Invalidate` when keys may change. Copies start unbuilt. Lookups may run
+ * concurrently, but not together with changes of the keys.
+ *
+ * @tparam __key_type
+ */
+template <typename __key_type>
+class DataFrameKeyIndex
+{
+public:
+    using key_type = __key_type;
+
+private:
+    mutable std::mutex mutex{};
+    mutable std::atomic_bool built{false};
+    mutable std::unordered_map<key_type, size_t> positions{};
+
+public:
+    ~DataFrameKeyIndex() = default;
+    DataFrameKeyIndex() = default;
+    DataFrameKeyIndex(const DataFrameKeyIndex &) noexcept {}
+    DataFrameKeyIndex &operator=(const DataFrameKeyIndex &) noexcept
+    {
+        Invalidate();
+        return *this;
+    }
+
+    void Invalidate() noexcept
+    {
+        built.store(false, std::memory_order_release);
+    }
+
+    bool Built() const noexcept
+    {
+        return built.load(std::memory_order_acquire);
+    }
+
+    template <typename __keys>
+    std::optional<size_t> Find(const __keys &keys, const key_type &key) const
+    {
+        if (!built.load(std::memory_order_acquire))
+        {
+            std::lock_guard lock(mutex);
+            if (!built.load(std::memory_order_relaxed))
+            {
+                positions.clear();
+                positions.reserve(keys.num_elements());
+                for (size_t i = 0; i != keys.num_elements(); ++i)
+                {
+                    positions.try_emplace(keys.origin()[i], i);
+                }
+                built.store(true, std::memory_order_release);
+            }
+        }
+        auto it = positions.find(key);
+        if (it == positions.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+};
+
+/**
+ * @brief Rows kept by `DataFrame::Join`
+ *
+ */
+enum class DataFrameJoin
+{
+    Inner,
+    Left
+};
+
 /**
  * @brief A simple implement of `pandas.DataFrame`, but only store same type
  *
@@ -277,6 +357,9 @@ private:
     frame_type frame;
     row_keys_type row_keys;
     col_keys_type col_keys;
+    DataFrameKeyIndex<row_key_type> row_index;
+    DataFrameKeyIndex<col_key_type> col_index;
+    bool use_key_index = false;
 
 public:
     template <typename __self>
@@ -440,7 +523,7 @@ public:
         requires std::convertible_to<__col_like, col_key_type>
     decltype(auto) Loc(this __self &&self, __col_like &&ck)
     {
-        size_t col_idx = __FindIdxOf(self.col_keys, ck);
+        size_t col_idx = self.__LookUp(self.col_keys, self.col_index, ck, "Column");
         return self.ILoc(col_idx);
     }
 
@@ -448,12 +531,29 @@ public:
         requires std::convertible_to<__row_like, row_key_type> && std::convertible_to<__col_like, col_key_type>
     decltype(auto) Loc(this __self &&self, __row_like &&rk, __col_like &&ck)
     {
-        size_t col_idx = __FindIdxOf(self.col_keys, ck);
-        size_t row_idx = __FindIdxOf(self.row_keys, rk);
+        size_t col_idx = self.__LookUp(self.col_keys, self.col_index, ck, "Column");
+        size_t row_idx = self.__LookUp(self.row_keys, self.row_index, rk, "Row");
 
         return self.ILoc(row_idx, col_idx);
     }
 
+    /**
+     * @brief Hash row and column keys for `Loc` instead of scanning them. The index is built on the first lookup and
+     * rebuilt after keys are accessed for writing, so do not keep a mutable reference from `ColKeys` / `RowKeys`
+     * across lookups.
+     *
+     * @param enable
+     */
+    void UseKeyIndex(bool enable = true) noexcept
+    {
+        use_key_index = enable;
+    }
+
+    bool UsesKeyIndex() const noexcept
+    {
+        return use_key_index;
+    }
+
     /**
      * @brief Access keys of column
      *
@@ -464,6 +564,7 @@ public:
     template <typename __self>
     auto &&ColKeys(this __self &&self)
     {
+        self.__InvalidateIndex(self.col_index);
         return self.col_keys;
     }
 
@@ -482,6 +583,7 @@ public:
         {
             AGTB_THROW(std::out_of_range, std::format("Index {} out of range", idx));
         }
+        self.__InvalidateIndex(self.col_index);
         return self.col_keys[idx];
     }
 
@@ -495,6 +597,7 @@ public:
     template <typename __self>
     auto &&RowKeys(this __self &&self)
     {
+        self.__InvalidateIndex(self.row_index);
         return self.row_keys;
     }
 
@@ -513,6 +616,7 @@ public:
         {
             AGTB_THROW(std::out_of_range, std::format("Index {} out of range", idx));
         }
+        self.__InvalidateIndex(self.row_index);
         return self.row_keys[idx];
     }
 
@@ -546,7 +650,7 @@ public:
             {
                 for (size_t c = 0; c < cols; ++c)
                 {
-                    if (!FromString<pure_cast>(this->ILoc(r, c), result_matrix(r, c)))
+                    if (!Utils::FromString<pure_cast>(this->ILoc(r, c), result_matrix(r, c)))
                     {
                         AGTB_THROW(std::invalid_argument, std::format("Convert value {} fail", this->ILoc(r, c)));
                     }
@@ -593,7 +697,80 @@ public:
             std::forward<decltype(convert)>(convert));
     }
 
+    /**
+     * @brief Join columns of `other` by row key, e.g. point tables by station name. Rows keep the order of this
+     * frame. `Inner` keeps rows whose key is found in `other`, `Left` keeps every row and fills `value_type{}` where
+     * it is not. Keys of `other` are hashed once, so the join is linear in rows. A key repeated in `other` matches
+     * its first row.
+     *
+     * @param other
+     * @param how
+     * @return DataFrame columns of this frame followed by those of `other`
+     */
+    DataFrame Join(const DataFrame &other, DataFrameJoin how = DataFrameJoin::Inner) const
+    {
+        std::vector<std::optional<size_t>> matches(Rows());
+        size_t rows = 0;
+        for (size_t r = 0; r != Rows(); ++r)
+        {
+            matches[r] = other.row_index.Find(other.row_keys, row_keys[r]);
+            rows += how == DataFrameJoin::Left || matches[r].has_value();
+        }
+
+        const size_t cols = Cols() + other.Cols();
+        DataFrame result(rows, cols);
+        std::copy(col_keys.origin(), col_keys.origin() + Cols(), result.col_keys.origin());
+        std::copy(other.col_keys.origin(), other.col_keys.origin() + other.Cols(), result.col_keys.origin() + Cols());
+
+        size_t out = 0;
+        for (size_t r = 0; r != Rows(); ++r)
+        {
+            if (how == DataFrameJoin::Inner && !matches[r].has_value())
+            {
+                continue;
+            }
+            result.row_keys[out] = row_keys[r];
+            std::copy(frame[r].origin(), frame[r].origin() + Cols(), result.frame[out].origin());
+            if (matches[r].has_value())
+            {
+                const auto *src = other.frame[*matches[r]].origin();
+                std::copy(src, src + other.Cols(), result.frame[out].origin() + Cols());
+            }
+            ++out;
+        }
+        result.use_key_index = use_key_index;
+        return result;
+    }
+
 private:
+    template <typename __index>
+    void __InvalidateIndex(__index &index) noexcept
+    {
+        index.Invalidate();
+    }
+
+    template <typename __index>
+    void __InvalidateIndex(const __index &) const noexcept
+    {
+    }
+
+    template <typename __keys, typename __index, typename __key_type_like>
+        requires std::convertible_to<__key_type_like, typename __keys::value_type>
+    size_t __LookUp(const __keys &keys, const __index &index, __key_type_like &&key, std::string_view what) const
+    {
+        if (!use_key_index)
+        {
+            return __FindIdxOf(keys, std::forward<__key_type_like>(key), what);
+        }
+        typename __keys::value_type typed_key = static_cast<typename __keys::value_type>(key);
+        auto idx = index.Find(keys, typed_key);
+        if (!idx.has_value())
+        {
+            AGTB_THROW(std::out_of_range, std::format("{} key not found: {}", what, typed_key));
+        }
+        return *idx;
+    }
+
     decltype(auto) __GetColSeriesIndicies(size_t ci) const noexcept
     {
         return boost::indices[boost::multi_array_types::index_range(
@@ -604,7 +781,7 @@ private:
 
     template <typename __keys, typename __key_type_like>
         requires std::convertible_to<__key_type_like, typename __keys::value_type>
-    static size_t __FindIdxOf(const __keys &keys, __key_type_like &&key)
+    static size_t __FindIdxOf(const __keys &keys, __key_type_like &&key, std::string_view what)
     {
         typename __keys::value_type typed_key = static_cast<typename __keys::value_type>(key);
         auto it = std::find(keys.origin(),
@@ -612,7 +789,7 @@ private:
                             typed_key);
         if (it == keys.origin() + keys.num_elements())
         {
-            AGTB_THROW(std::out_of_range, std::format("{}{}", "Column key not found: ", typed_key));
+            AGTB_THROW(std::out_of_range, std::format("{} key not found: {}", what, typed_key));
         }
         size_t idx = std::distance(keys.origin(), it);
         return idx;
@@ -632,8 +809,8 @@ private:
     {
         col_key_type beg = ckir.beg, end = ckir.end;
         size_type stride = ckir.stride;
-        size_type i_beg = __FindIdxOf(self.col_keys, beg);
-        size_type i_end = __FindIdxOf(self.col_keys, end);
+        size_type i_beg = self.__LookUp(self.col_keys, self.col_index, beg, "Column");
+        size_type i_end = self.__LookUp(self.col_keys, self.col_index, end, "Column");
         i_end = (i_beg == i_end) ? i_beg + 1 : i_end + 1;
         return index_range(i_beg, i_end, stride);
     }
@@ -795,7 +972,7 @@ public:
             {
                 if constexpr (std::convertible_to<value_type, std::string>)
                 {
-                    if (!FromString<pure_cast>(frame_view[r][c], result_matrix(r, c)))
+                    if (!Utils::FromString<pure_cast>(frame_view[r][c], result_matrix(r, c)))
                     {
                         AGTB_THROW(std::invalid_argument, std::format("Convert value {} fail", frame_view[r][c]));
                     }
@@ -839,6 +1016,7 @@ AGTB_CONTAINER_END
 AGTB_BEGIN
 
 using Container::DataFrame;
+using Container::DataFrameJoin;
 using Container::Idx;
 using Container::Key;
 
@@ -4,13 +4,426 @@
 #include "../details/Macros.hpp"
 
 #include <boost/graph/adjacency_list.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
 
-#include <map>
+#include <atomic>
+#include <cstdint>
 #include <generator>
 #include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 AGTB_CONTAINER_BEGIN
 
+/**
+ * @brief Dense interned id of a vertex name, valid until a vertex is removed
+ *
+ */
+struct VertexHandle
+{
+    std::uint32_t id;
+
+    auto operator<=>(const VertexHandle &) const = default;
+};
+
+/**
+ * @brief Dense interned id of an edge name, valid until an edge is removed
+ *
+ */
+struct EdgeHandle
+{
+    std::uint32_t id;
+
+    auto operator<=>(const EdgeHandle &) const = default;
+};
+
+namespace detail::NamedGraph
+{
+    using name_id_type = std::uint32_t;
+
+    /**
+     * @brief Interned names: hash lookup name -> id, ids are dense `0..Size()` so id -> name and id -> descriptor
+     * are plain vectors. Erasing moves the last id into the hole to keep ids dense. The name-sorted view is built
+     * on first use and dropped by every change, copies start without it.
+     *
+     */
+    template <typename __name_type, typename __descriptor_type>
+    class NameIndex
+    {
+    public:
+        using name_type = __name_type;
+        using descriptor_type = __descriptor_type;
+        using sorted_type = std::map<name_type, descriptor_type>;
+
+        static constexpr name_id_type npos = std::numeric_limits<name_id_type>::max();
+
+    private:
+        boost::unordered_flat_map<name_type, name_id_type> ids{};
+        std::vector<name_type> names{};
+        std::vector<descriptor_type> descriptors{};
+
+        mutable std::mutex mutex{};
+        mutable std::atomic_bool built{false};
+        mutable sorted_type sorted{};
+
+        void __Invalidate() noexcept
+        {
+            built.store(false, std::memory_order_release);
+        }
+
+    public:
+        ~NameIndex() = default;
+        NameIndex() = default;
+
+        NameIndex(const NameIndex &other)
+            : ids(other.ids), names(other.names), descriptors(other.descriptors)
+        {
+        }
+
+        NameIndex(NameIndex &&other) noexcept
+            : ids(std::move(other.ids)), names(std::move(other.names)), descriptors(std::move(other.descriptors))
+        {
+            other.__Invalidate();
+        }
+
+        NameIndex &operator=(const NameIndex &other)
+        {
+            ids = other.ids;
+            names = other.names;
+            descriptors = other.descriptors;
+            __Invalidate();
+            return *this;
+        }
+
+        NameIndex &operator=(NameIndex &&other) noexcept
+        {
+            ids = std::move(other.ids);
+            names = std::move(other.names);
+            descriptors = std::move(other.descriptors);
+            __Invalidate();
+            other.__Invalidate();
+            return *this;
+        }
+
+        name_id_type Find(const name_type &name) const
+        {
+            auto it = ids.find(name);
+            return it == ids.end() ? npos : it->second;
+        }
+
+        bool Contains(const name_type &name) const
+        {
+            return ids.contains(name);
+        }
+
+        /**
+         * @brief Intern an absent `name`
+         *
+         */
+        name_id_type Insert(const name_type &name, const descriptor_type &descriptor)
+        {
+            __Invalidate();
+            const auto id = static_cast<name_id_type>(names.size());
+            ids.emplace(name, id);
+            names.emplace_back(name);
+            descriptors.emplace_back(descriptor);
+            return id;
+        }
+
+        /**
+         * @brief Drop `id`, the last id (returned, `npos` if `id` was last) takes its place
+         *
+         */
+        name_id_type Erase(name_id_type id)
+        {
+            __Invalidate();
+            const auto last = static_cast<name_id_type>(names.size() - 1);
+            ids.erase(names[id]);
+            if (id == last)
+            {
+                names.pop_back();
+                descriptors.pop_back();
+                return npos;
+            }
+            names[id] = std::move(names.back());
+            descriptors[id] = descriptors.back();
+            names.pop_back();
+            descriptors.pop_back();
+            ids[names[id]] = id;
+            return last;
+        }
+
+        const name_type &Name(name_id_type id) const
+        {
+            return names[id];
+        }
+
+        descriptor_type &Descriptor(name_id_type id)
+        {
+            __Invalidate();
+            return descriptors[id];
+        }
+
+        const descriptor_type &Descriptor(name_id_type id) const
+        {
+            return descriptors[id];
+        }
+
+        const std::vector<name_type> &Names() const noexcept
+        {
+            return names;
+        }
+
+        const std::vector<descriptor_type> &Descriptors() const noexcept
+        {
+            return descriptors;
+        }
+
+        /**
+         * @brief Name -> descriptor ordered by name. Lookups may run concurrently, but not together with changes.
+         *
+         */
+        const sorted_type &Sorted() const
+        {
+            if (!built.load(std::memory_order_acquire))
+            {
+                std::lock_guard lock(mutex);
+                if (!built.load(std::memory_order_relaxed))
+                {
+                    sorted.clear();
+                    for (size_t id = 0; id != names.size(); ++id)
+                    {
+                        sorted.emplace(names[id], descriptors[id]);
+                    }
+                    built.store(true, std::memory_order_release);
+                }
+            }
+            return sorted;
+        }
+
+        size_t Size() const noexcept
+        {
+            return names.size();
+        }
+    };
+
+    /**
+     * @brief `__first` then `__second` as one input view, both yielding the same reference type
+     *
+     */
+    template <std::ranges::view __first, std::ranges::view __second>
+        requires std::same_as<std::ranges::range_reference_t<__first>, std::ranges::range_reference_t<__second>>
+    class ConcatView : public std::ranges::view_interface<ConcatView<__first, __second>>
+    {
+    private:
+        __first first;
+        __second second;
+
+    public:
+        class Iterator
+        {
+        public:
+            using value_type = std::ranges::range_value_t<__first>;
+            using difference_type = std::ptrdiff_t;
+
+            std::ranges::iterator_t<__first> it1{}, end1{};
+            std::ranges::iterator_t<__second> it2{}, end2{};
+
+            decltype(auto) operator*() const
+            {
+                return it1 != end1 ? *it1 : *it2;
+            }
+
+            Iterator &operator++()
+            {
+                if (it1 != end1)
+                {
+                    ++it1;
+                }
+                else
+                {
+                    ++it2;
+                }
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool operator==(const Iterator &it, std::default_sentinel_t)
+            {
+                return it.it1 == it.end1 && it.it2 == it.end2;
+            }
+        };
+
+        ConcatView() = default;
+
+        ConcatView(__first f, __second s) : first(std::move(f)), second(std::move(s))
+        {
+        }
+
+        Iterator begin()
+        {
+            return Iterator{std::ranges::begin(first), std::ranges::end(first), std::ranges::begin(second), std::ranges::end(second)};
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return std::default_sentinel;
+        }
+    };
+}
+
+/**
+ * @brief Immutable topology snapshot of a `NamedGraph` indexed by handles: out edges as CSR, in edges as CSC
+ * (contiguous offsets and neighbour ids) plus per-edge source, target and the selected edge fields as arrays.
+ * Stays valid as long as no vertex or edge is added or removed; properties live on in the graph.
+ *
+ * @tparam __field_types types of the edge fields copied by `NamedGraph::Freeze`
+ */
+template <typename... __field_types>
+class FrozenGraph
+{
+public:
+    using fields_type = std::tuple<std::vector<__field_types>...>;
+
+private:
+    std::vector<VertexHandle> sources, targets;
+    std::vector<std::uint32_t> out_offsets, in_offsets;
+    std::vector<EdgeHandle> out_edges, in_edges;
+    std::vector<VertexHandle> out_neighbours, in_neighbours;
+    fields_type fields;
+
+    static void __Group(
+        const std::vector<VertexHandle> &keys,
+        const std::vector<VertexHandle> &others,
+        std::span<const EdgeHandle> order,
+        size_t vertices,
+        std::vector<std::uint32_t> &offsets,
+        std::vector<EdgeHandle> &edges,
+        std::vector<VertexHandle> &neighbours)
+    {
+        offsets.assign(vertices + 1, 0);
+        for (const auto vh : keys)
+        {
+            ++offsets[vh.id + 1];
+        }
+        for (size_t v = 0; v != vertices; ++v)
+        {
+            offsets[v + 1] += offsets[v];
+        }
+
+        std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        edges.resize(keys.size());
+        neighbours.resize(keys.size());
+        auto place = [&](EdgeHandle eh)
+        {
+            const auto at = fill[keys[eh.id].id]++;
+            edges[at] = eh;
+            neighbours[at] = others[eh.id];
+        };
+        if (order.empty())
+        {
+            for (std::uint32_t e = 0; e != keys.size(); ++e)
+            {
+                place(EdgeHandle{e});
+            }
+        }
+        else
+        {
+            for (const auto eh : order)
+            {
+                place(eh);
+            }
+        }
+    }
+
+public:
+    FrozenGraph() = default;
+
+    /**
+     * @brief Group edges by source (CSR) and by target (CSC). Within a vertex edges keep the order they have in
+     * `out_order` / `in_order` (every edge once), or handle order if empty.
+     *
+     */
+    FrozenGraph(
+        size_t vertices,
+        std::vector<VertexHandle> edge_sources,
+        std::vector<VertexHandle> edge_targets,
+        std::span<const EdgeHandle> out_order,
+        std::span<const EdgeHandle> in_order,
+        std::vector<__field_types>... edge_fields)
+        : sources(std::move(edge_sources)), targets(std::move(edge_targets)), fields(std::move(edge_fields)...)
+    {
+        __Group(sources, targets, out_order, vertices, out_offsets, out_edges, out_neighbours);
+        __Group(targets, sources, in_order, vertices, in_offsets, in_edges, in_neighbours);
+    }
+
+    size_t VertexCount() const noexcept
+    {
+        return out_offsets.empty() ? 0 : out_offsets.size() - 1;
+    }
+
+    size_t EdgeCount() const noexcept
+    {
+        return sources.size();
+    }
+
+    VertexHandle Source(EdgeHandle eh) const
+    {
+        return sources[eh.id];
+    }
+
+    VertexHandle Target(EdgeHandle eh) const
+    {
+        return targets[eh.id];
+    }
+
+    std::span<const EdgeHandle> OutEdges(VertexHandle vh) const
+    {
+        return std::span<const EdgeHandle>(out_edges).subspan(out_offsets[vh.id], out_offsets[vh.id + 1] - out_offsets[vh.id]);
+    }
+
+    std::span<const EdgeHandle> InEdges(VertexHandle vh) const
+    {
+        return std::span<const EdgeHandle>(in_edges).subspan(in_offsets[vh.id], in_offsets[vh.id + 1] - in_offsets[vh.id]);
+    }
+
+    std::span<const VertexHandle> OutNeighbours(VertexHandle vh) const
+    {
+        return std::span<const VertexHandle>(out_neighbours).subspan(out_offsets[vh.id], out_offsets[vh.id + 1] - out_offsets[vh.id]);
+    }
+
+    std::span<const VertexHandle> InNeighbours(VertexHandle vh) const
+    {
+        return std::span<const VertexHandle>(in_neighbours).subspan(in_offsets[vh.id], in_offsets[vh.id + 1] - in_offsets[vh.id]);
+    }
+
+    /**
+     * @brief `__idx`-th frozen edge field of every edge, indexed by edge handle
+     *
+     */
+    template <size_t __idx>
+    std::span<const std::tuple_element_t<__idx, std::tuple<__field_types...>>> Field() const
+    {
+        return std::get<__idx>(fields);
+    }
+
+    template <size_t __idx>
+    const auto &Field(EdgeHandle eh) const
+    {
+        return std::get<__idx>(fields)[eh.id];
+    }
+};
+
 template <
     typename __VertexProperty = boost::no_property,
     typename __EdgeProperty = boost::no_property,
@@ -30,22 +443,30 @@ public:
     using EdgeProperty = __EdgeProperty;
     using GraphProperty = __GraphProperty;
     using EdgeListS = __EdgeListS;
+    using name_id_type = detail::NamedGraph::name_id_type;
+    // Interned name id of each vertex/edge rides along as an interior property, bundles are unchanged
+    using StoredVertexProperty = boost::property<boost::vertex_name_t, name_id_type, VertexProperty>;
+    using StoredEdgeProperty = boost::property<boost::edge_name_t, name_id_type, EdgeProperty>;
     using Graph = boost::adjacency_list<
         OutEdgeListS,
         VertexListS,
         DirectedS,
-        VertexProperty,
-        EdgeProperty,
+        StoredVertexProperty,
+        StoredEdgeProperty,
         GraphProperty,
         EdgeListS>;
     using GraphTraits = boost::graph_traits<Graph>;
     using name_type = __name_type; // std::string;
     using vertex_index_type = GraphTraits::vertex_descriptor;
     using edge_index_type = GraphTraits::edge_descriptor;
-    using vertex_map_type = std::map<name_type, vertex_index_type>;
-    using edge_map_type = std::map<name_type, edge_index_type>;
-    using reverse_vertex_map_type = std::map<vertex_index_type, name_type>;
-    using reverse_edge_map_type = std::map<edge_index_type, name_type>;
+    using vertex_handle_type = VertexHandle;
+    using edge_handle_type = EdgeHandle;
+    using vertex_map_type = detail::NamedGraph::NameIndex<name_type, vertex_index_type>;
+    using edge_map_type = detail::NamedGraph::NameIndex<name_type, edge_index_type>;
+    using sorted_vertex_map_type = vertex_map_type::sorted_type;
+    using sorted_edge_map_type = edge_map_type::sorted_type;
+    using reverse_vertex_map_type [[deprecated("Use `NameOf(vidx)`")]] = std::map<vertex_index_type, name_type>;
+    using reverse_edge_map_type [[deprecated("Use `NameOf(eidx)`")]] = std::map<edge_index_type, name_type>;
 
 public:
     template <typename __map_ref_type>
@@ -54,12 +475,28 @@ public:
     public:
         using map_ref_type = __map_ref_type;
         using map_type = std::remove_cvref_t<map_ref_type>;
-        using value_type = typename map_type::value_type;
-        using index_type = value_type;
+        using index_type = typename map_type::descriptor_type;
+        using value_type = typename map_type::sorted_type::value_type;
 
     private:
         map_ref_type ref;
 
+        static std::generator<const name_type &> __Names(const map_type &map)
+        {
+            for (const auto &[n, i] : map.Sorted())
+            {
+                co_yield n;
+            }
+        }
+
+        static std::generator<index_type> __Indices(const map_type &map)
+        {
+            for (const auto &[n, i] : map.Sorted())
+            {
+                co_yield i;
+            }
+        }
+
     public:
         ~Access() = default;
 
@@ -73,43 +510,65 @@ public:
             return self.ref;
         }
 
+        /**
+         * @brief Names in name order. The coroutine holds the map itself, not this `Access`, so
+         * `for (auto &n : g.Vertices().Names())` outlives the temporary.
+         *
+         */
         std::generator<const name_type &> Names() const
         {
-            for (const auto &[n, i] : ref)
-            {
-                co_yield n;
-            }
+            return __Names(ref);
         }
 
+        /**
+         * @brief Indices in name order
+         *
+         */
         std::generator<index_type> Indices() const
         {
-            for (const auto &[n, i] : ref)
-            {
-                co_yield i;
-            }
+            return __Indices(ref);
+        }
+
+        /**
+         * @brief Names in handle order, without a coroutine frame
+         *
+         */
+        auto NamesView() const
+        {
+            return std::views::all(std::as_const(ref).Names());
+        }
+
+        /**
+         * @brief Indices in handle order, without a coroutine frame
+         *
+         */
+        auto IndicesView() const
+        {
+            return std::views::all(std::as_const(ref).Descriptors());
         }
 
         size_t Size() const
         {
-            return ref.size();
+            return ref.Size();
         }
 
-        template <typename __self>
-        decltype(auto) Begin(this __self &&self)
+        /**
+         * @brief First `(name, index)` pair in name order
+         *
+         */
+        auto Begin() const
         {
-            return self.ref.begin();
+            return ref.Sorted().begin();
         }
 
-        template <typename __self>
-        decltype(auto) End(this __self &&self)
+        auto End() const
         {
-            return self.ref.end();
+            return ref.Sorted().end();
         }
 
-        template <typename __self>
-        decltype(auto) Iterators(this __self &&self)
+        auto Iterators() const
         {
-            return std::make_tuple(self.Begin(), self.End());
+            return std::make_tuple(Begin(), End());
         }
     };
 
@@ -130,9 +589,81 @@ private:
 private:
     Graph graph;
     vertex_map_type vertices;
-    reverse_vertex_map_type rvertices;
     edge_map_type edges;
-    reverse_edge_map_type redges;
+
+    name_id_type __VertexId(const name_type &name) const
+    {
+        const auto id = vertices.Find(name);
+        if (id == vertex_map_type::npos)
+        {
+            AGTB_THROW(std::out_of_range, std::format("No vertex named {}", name));
+        }
+        return id;
+    }
+
+    name_id_type __EdgeId(const name_type &name) const
+    {
+        const auto id = edges.Find(name);
+        if (id == edge_map_type::npos)
+        {
+            AGTB_THROW(std::out_of_range, std::format("No edge named {}", name));
+        }
+        return id;
+    }
+
+    vertex_index_type __VertexIndex(const name_type &name) const
+    {
+        return vertices.Descriptor(__VertexId(name));
+    }
+
+    edge_index_type __EdgeIndex(const name_type &name) const
+    {
+        return edges.Descriptor(__EdgeId(name));
+    }
+
+    template <typename __property>
+    edge_index_type __AddEdge(const name_type &beg, const name_type &end, const name_type &name, const __property &property, bool *add_status_ptr)
+    {
+        if (const auto id = edges.Find(name); id != edge_map_type::npos)
+        {
+            return edges.Descriptor(id);
+        }
+
+        const auto beg_id = vertices.Find(beg), end_id = vertices.Find(end);
+        if (beg_id == vertex_map_type::npos || end_id == vertex_map_type::npos)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("No vertex `{}` or `{}`", beg, end));
+        }
+
+        const auto id = static_cast<name_id_type>(edges.Size());
+        auto pair = boost::add_edge(vertices.Descriptor(beg_id), vertices.Descriptor(end_id), StoredEdgeProperty(id, property), graph);
+
+        if (add_status_ptr != nullptr)
+        {
+            *add_status_ptr = pair.second;
+        }
+
+        // Parallel edge rejected by the edge container: the existing edge keeps its own name
+        if (pair.second)
+        {
+            edges.Insert(name, pair.first);
+        }
+        return pair.first;
+    }
+
+    template <typename __property>
+    vertex_index_type __AddVertex(const name_type &name, const __property &property)
+    {
+        if (const auto id = vertices.Find(name); id != vertex_map_type::npos)
+        {
+            return vertices.Descriptor(id);
+        }
+
+        const auto id = static_cast<name_id_type>(vertices.Size());
+        vertex_index_type idx = boost::add_vertex(StoredVertexProperty(id, property), graph);
+        vertices.Insert(name, idx);
+        return idx;
+    }
 
 public:
     ~NamedGraph() = default;
@@ -145,11 +676,41 @@ public:
     }
 
     template <typename __return>
-    __return ApplyUnWrap(std::function<__return(Graph &, vertex_map_type &, reverse_vertex_map_type &, edge_map_type &, reverse_edge_map_type &)> apply_to_all_wrapped)
+    __return ApplyUnWrap(std::function<__return(Graph &, vertex_map_type &, edge_map_type &)> apply_to_all_wrapped)
     {
         return apply_to_all_wrapped(graph, vertices, edges);
     }
 
+    /**
+     * @brief Old form on name-sorted copies of the maps, changes to the maps are not written back
+     *
+     */
+    template <typename __return>
+    [[deprecated("Use the `(Graph &, vertex_map_type &, edge_map_type &)` form")]]
+    __return ApplyUnWrap(
+        std::function<__return(
+            Graph &,
+            sorted_vertex_map_type &,
+            std::map<vertex_index_type, name_type> &,
+            sorted_edge_map_type &,
+            std::map<edge_index_type, name_type> &)>
+            apply_to_all_wrapped)
+    {
+        sorted_vertex_map_type vmap = vertices.Sorted();
+        sorted_edge_map_type emap = edges.Sorted();
+        std::map<vertex_index_type, name_type> rvmap{};
+        std::map<edge_index_type, name_type> remap{};
+        for (const auto &[n, i] : vmap)
+        {
+            rvmap.emplace(i, n);
+        }
+        for (const auto &[n, i] : emap)
+        {
+            remap.emplace(i, n);
+        }
+        return apply_to_all_wrapped(graph, vmap, rvmap, emap, remap);
+    }
+
     template <typename __self>
     decltype(auto) Vertices(this __self &&self)
     {
@@ -164,115 +725,73 @@ public:
 
     vertex_index_type AddVertex(const name_type &name)
     {
-        if (vertices.contains(name))
-        {
-            return vertices.at(name);
-        }
-
-        vertex_index_type idx = boost::add_vertex(graph);
-        vertices.insert_or_assign(name, idx);
-        rvertices.insert_or_assign(idx, name);
-        return idx;
+        return __AddVertex(name, VertexProperty{});
     }
 
     vertex_index_type AddVertex(const name_type &name, const VertexProperty &property)
     {
-        if (vertices.contains(name))
-        {
-            return vertices.at(name);
-        }
-
-        vertex_index_type idx = boost::add_vertex(property, graph);
-        vertices.insert_or_assign(name, idx);
-        rvertices.insert_or_assign(idx, name);
-        return idx;
+        return __AddVertex(name, property);
     }
 
-    inline bool ContainsVertex(const name_type &name)
+    inline bool ContainsVertex(const name_type &name) const
     {
-        return vertices.contains(name);
+        return vertices.Contains(name);
     }
 
     inline void RemoveVertex(const name_type &name)
     {
-        vertex_index_type tar = vertices.at(name);
-        boost::remove_vertex(tar, graph);
-        vertices.erase(name);
-        rvertices.erase(tar);
-    }
-
-    edge_index_type AddEdge(const name_type &beg, const name_type &end, const name_type &name, bool *add_status_ptr = nullptr)
-    {
-        if (edges.contains(name))
+        const name_id_type id = __VertexId(name);
+        const vertex_index_type tar = vertices.Descriptor(id);
+        if (vertices.Erase(id) != vertex_map_type::npos)
         {
-            return edges.at(name);
+            boost::put(boost::vertex_name, graph, vertices.Descriptor(id), id);
         }
+        boost::remove_vertex(tar, graph);
 
-        if (!(vertices.contains(beg) && vertices.contains(end)))
-        {
-            AGTB_THROW(std::invalid_argument, std::format("No vertex `{}` or `{}`", beg, end));
-        }
-
-        vertex_index_type beg_idx = vertices.at(beg), end_idx = vertices.at(end);
-        auto pair = boost::add_edge(beg_idx, end_idx, graph);
-
-        if (add_status_ptr != nullptr)
+        // Vertex descriptors (and the vertices stored in edge descriptors) are renumbered by vecS
+        if constexpr (std::is_same_v<VertexListS, boost::vecS>)
         {
-            *add_status_ptr = pair.second;
+            for (auto [it, end] = boost::vertices(graph); it != end; ++it)
+            {
+                vertices.Descriptor(boost::get(boost::vertex_name, graph, *it)) = *it;
+            }
+            for (auto [it, end] = boost::edges(graph); it != end; ++it)
+            {
+                edges.Descriptor(boost::get(boost::edge_name, graph, *it)) = *it;
+            }
         }
+    }
 
-        edges.insert_or_assign(name, pair.first);
-        redges.insert_or_assign(pair.first, name);
-        return pair.first;
+    edge_index_type AddEdge(const name_type &beg, const name_type &end, const name_type &name, bool *add_status_ptr = nullptr)
+    {
+        return __AddEdge(beg, end, name, EdgeProperty{}, add_status_ptr);
     }
 
     edge_index_type AddEdge(const name_type &beg, const name_type &end, const name_type &name, const EdgeProperty &property, bool *add_status_ptr = nullptr)
     {
-        if (edges.contains(name))
-        {
-            return edges.at(name);
-        }
-
-        if (!(vertices.contains(beg) && vertices.contains(end)))
-        {
-            AGTB_THROW(std::invalid_argument, std::format("No vertex `{}` or `{}`", beg, end));
-        }
-
-        vertex_index_type beg_idx = vertices.at(beg), end_idx = vertices.at(end);
-        auto pair = boost::add_edge(beg_idx, end_idx, property, graph);
-
-        if (add_status_ptr != nullptr)
-        {
-            *add_status_ptr = pair.second;
-        }
-
-        edges.insert_or_assign(name, pair.first);
-        redges.insert_or_assign(pair.first, name);
-        return pair.first;
+        return __AddEdge(beg, end, name, property, add_status_ptr);
     }
 
     inline void RemoveEdge(const name_type &name)
     {
-        edge_index_type tar = edges.at(name);
+        const name_id_type id = __EdgeId(name);
+        const edge_index_type tar = edges.Descriptor(id);
+        if (edges.Erase(id) != edge_map_type::npos)
+        {
+            boost::put(boost::edge_name, graph, edges.Descriptor(id), id);
+        }
         boost::remove_edge(tar, graph);
-        edges.erase(name);
-        redges.erase(tar);
     }
 
-    inline bool ContainsEdge(const name_type &name)
+    inline bool ContainsEdge(const name_type &name) const
     {
-        return edges.contains(name);
+        return edges.Contains(name);
     }
 
     template <typename __self>
     decltype(auto) Vertex(this __self &&self, const name_type &name)
     {
-        if (!self.vertices.contains(name))
-        {
-            AGTB_THROW(std::out_of_range, std::format("No vertex named {}", name));
-        }
-
-        return self.graph[self.vertices.at(name)];
+        return self.graph[self.__VertexIndex(name)];
     }
 
     template <typename __self>
@@ -284,7 +803,7 @@ public:
     template <typename __self>
     decltype(auto) InEdges(this __self &&self, const name_type &name)
     {
-        auto vidx = self.vertices.at(name);
+        auto vidx = self.__VertexIndex(name);
         return boost::in_edges(vidx, self.graph);
     }
 
@@ -297,7 +816,7 @@ public:
     template <typename __self>
     decltype(auto) OutEdges(this __self &&self, const name_type &name)
     {
-        auto vidx = self.vertices.at(name);
+        auto vidx = self.__VertexIndex(name);
         return boost::out_edges(vidx, self.graph);
     }
 
@@ -310,7 +829,7 @@ public:
     template <typename __self>
     decltype(auto) AdjacentVertices(this __self &&self, const name_type &name)
     {
-        auto vidx = self.vertices.at(name);
+        auto vidx = self.__VertexIndex(name);
         return boost::adjacent_vertices(vidx, self.graph);
     }
 
@@ -323,12 +842,7 @@ public:
     template <typename __self>
     decltype(auto) Edge(this __self &&self, const name_type &name)
     {
-        if (!self.edges.contains(name))
-        {
-            AGTB_THROW(std::out_of_range, std::format("No edge named {}", name));
-        }
-
-        return self.graph[self.edges.at(name)];
+        return self.graph[self.__EdgeIndex(name)];
     }
 
     template <typename __self>
@@ -337,41 +851,34 @@ public:
         return self.graph[eidx];
     }
 
-    const name_type &NameOf(const vertex_index_type &vidx)
+    const name_type &NameOf(const vertex_index_type &vidx) const
     {
-        return rvertices.at(vidx);
+        return vertices.Name(boost::get(boost::vertex_name, graph, vidx));
     }
 
-    const name_type &NameOf(const edge_index_type &eidx)
+    const name_type &NameOf(const edge_index_type &eidx) const
     {
-        return redges.at(eidx);
+        return edges.Name(boost::get(boost::edge_name, graph, eidx));
     }
 
     decltype(auto) Source(const name_type &name) const
     {
-        if (!edges.contains(name))
-        {
-            AGTB_THROW(std::out_of_range, std::format("No edge named {}", name));
-        }
-
-        return boost::source(edges.at(name), graph);
+        return boost::source(__EdgeIndex(name), graph);
     }
 
     decltype(auto) Target(const name_type &name) const
     {
-        return boost::target(edges.at(name), graph);
+        return boost::target(__EdgeIndex(name), graph);
     }
 
-    name_type SourceName(const name_type &name) const
+    const name_type &SourceName(const name_type &name) const
     {
-        vertex_index_type tar = Source(name);
-        return rvertices.at(tar);
+        return NameOf(Source(name));
     }
 
-    name_type TargetName(const name_type &name) const
+    const name_type &TargetName(const name_type &name) const
     {
-        vertex_index_type tar = Target(name);
-        return rvertices.at(tar);
+        return NameOf(Target(name));
     }
 
     template <typename __self>
@@ -386,10 +893,149 @@ public:
         return self.Vertex(self.Target(name));
     }
 
+    /**
+     * @brief Handle of a vertex name, for hot loops that should not hash names repeatedly
+     *
+     */
+    VertexHandle FindVertex(const name_type &name) const
+    {
+        return VertexHandle{__VertexId(name)};
+    }
+
+    EdgeHandle FindEdge(const name_type &name) const
+    {
+        return EdgeHandle{__EdgeId(name)};
+    }
+
+    VertexHandle Handle(const vertex_index_type &vidx) const
+    {
+        return VertexHandle{boost::get(boost::vertex_name, graph, vidx)};
+    }
+
+    EdgeHandle Handle(const edge_index_type &eidx) const
+    {
+        return EdgeHandle{boost::get(boost::edge_name, graph, eidx)};
+    }
+
+    vertex_index_type Index(VertexHandle vh) const
+    {
+        return vertices.Descriptor(vh.id);
+    }
+
+    edge_index_type Index(EdgeHandle eh) const
+    {
+        return edges.Descriptor(eh.id);
+    }
+
+    /**
+     * @brief All vertex handles `0..n` in the order of `Vertices().Names()`
+     *
+     */
+    auto VertexHandles() const
+    {
+        return std::views::iota(name_id_type{0}, static_cast<name_id_type>(vertices.Size())) |
+               std::views::transform([](name_id_type id)
+                                     { return VertexHandle{id}; });
+    }
+
+    auto EdgeHandles() const
+    {
+        return std::views::iota(name_id_type{0}, static_cast<name_id_type>(edges.Size())) |
+               std::views::transform([](name_id_type id)
+                                     { return EdgeHandle{id}; });
+    }
+
+    template <typename __self>
+    decltype(auto) Vertex(this __self &&self, VertexHandle vh)
+    {
+        return self.graph[self.vertices.Descriptor(vh.id)];
+    }
+
+    template <typename __self>
+    decltype(auto) Edge(this __self &&self, EdgeHandle eh)
+    {
+        return self.graph[self.edges.Descriptor(eh.id)];
+    }
+
+    const name_type &NameOf(VertexHandle vh) const
+    {
+        return vertices.Name(vh.id);
+    }
+
+    const name_type &NameOf(EdgeHandle eh) const
+    {
+        return edges.Name(eh.id);
+    }
+
+    VertexHandle SourceHandle(EdgeHandle eh) const
+    {
+        return Handle(boost::source(edges.Descriptor(eh.id), graph));
+    }
+
+    VertexHandle TargetHandle(EdgeHandle eh) const
+    {
+        return Handle(boost::target(edges.Descriptor(eh.id), graph));
+    }
+
+    /**
+     * @brief Snapshot the topology (and the edge fields given as member pointers, e.g. `&EdgeProperty::len`) for
+     * read-heavy algorithms, see `FrozenGraph`
+     *
+     */
+    template <typename... __field_types>
+    FrozenGraph<__field_types...> Freeze(__field_types EdgeProperty::*...edge_fields) const
+    {
+        const size_t n = edges.Size();
+        std::vector<VertexHandle> sources(n), targets(n);
+        std::tuple<std::vector<__field_types>...> fields{std::vector<__field_types>(n)...};
+
+        for (size_t e = 0; e != n; ++e)
+        {
+            const auto &eidx = edges.Descriptor(e);
+            sources[e] = Handle(boost::source(eidx, graph));
+            targets[e] = Handle(boost::target(eidx, graph));
+            const auto &property = graph[eidx];
+            [&]<size_t... __idx>(std::index_sequence<__idx...>)
+            {
+                ((std::get<__idx>(fields)[e] = property.*edge_fields), ...);
+            }(std::index_sequence_for<__field_types...>{});
+        }
+
+        // Keep the adjacency order of the graph itself
+        std::vector<EdgeHandle> out_order{}, in_order{};
+        if constexpr (!std::is_same_v<DirectedS, boost::undirectedS>)
+        {
+            out_order.reserve(n);
+            for (const auto &vidx : vertices.Descriptors())
+            {
+                for (auto [it, end] = boost::out_edges(vidx, graph); it != end; ++it)
+                {
+                    out_order.emplace_back(Handle(*it));
+                }
+            }
+        }
+        if constexpr (std::is_same_v<DirectedS, boost::bidirectionalS>)
+        {
+            in_order.reserve(n);
+            for (const auto &vidx : vertices.Descriptors())
+            {
+                for (auto [it, end] = boost::in_edges(vidx, graph); it != end; ++it)
+                {
+                    in_order.emplace_back(Handle(*it));
+                }
+            }
+        }
+
+        return std::apply(
+            [&](auto &...columns)
+            { return FrozenGraph<__field_types...>(vertices.Size(), std::move(sources), std::move(targets), out_order, in_order, std::move(columns)...); },
+            fields);
+    }
+
     bool ModiftyVertex(const name_type &edge_name, const name_type &old_name, const name_type &new_name, const VertexProperty &new_prop)
     {
-        const auto &tar_name = this->TargetName(edge_name);
-        const auto &src_name = this->SourceName(edge_name);
+        const name_type tar_name = this->TargetName(edge_name);
+        const name_type src_name = this->SourceName(edge_name);
         EdgeProperty prop = this->Edge(edge_name);
 
         this->RemoveEdge(edge_name);
@@ -417,8 +1063,8 @@ public:
     {
         // std::println("{}", "in modifing");
 
-        const auto &tar_name = this->TargetName(edge_name);
-        const auto &src_name = this->SourceName(edge_name);
+        const name_type tar_name = this->TargetName(edge_name);
+        const name_type src_name = this->SourceName(edge_name);
         EdgeProperty prop = this->Edge(edge_name);
         this->RemoveEdge(edge_name);
         // std::println("remove edge {}", edge_name);
@@ -473,6 +1119,36 @@ public:
         }
     }
 
+    /**
+     * @brief Names of in edges of a vertex, a lazy view over the graph (no allocation) valid while the graph is
+     * unchanged, see `InEdgesOf`
+     *
+     */
+    auto InEdgesView(const name_type &vert_name) const
+    {
+        auto [it, end] = boost::in_edges(__VertexIndex(vert_name), graph);
+        return std::ranges::subrange(it, end) |
+               std::views::transform([this](const edge_index_type &eidx) -> const name_type &
+                                     { return NameOf(eidx); });
+    }
+
+    auto OutEdgesView(const name_type &vert_name) const
+    {
+        auto [it, end] = boost::out_edges(__VertexIndex(vert_name), graph);
+        return std::ranges::subrange(it, end) |
+               std::views::transform([this](const edge_index_type &eidx) -> const name_type &
+                                     { return NameOf(eidx); });
+    }
+
+    /**
+     * @brief In edges then out edges, see `EdgesOf`
+     *
+     */
+    auto EdgesView(const name_type &vert_name) const
+    {
+        return detail::NamedGraph::ConcatView(InEdgesView(vert_name), OutEdgesView(vert_name));
+    }
+
 private:
     class VertexAdder
     {
@@ -556,7 +1232,10 @@ AGTB_CONTAINER_END
 
 AGTB_BEGIN
 
+using Container::EdgeHandle;
+using Container::FrozenGraph;
 using Container::NamedGraph;
+using Container::VertexHandle;
 
 AGTB_END
 
@@ -17,7 +17,7 @@ namespace EllipsoidMath
         double M, N;
         double R()
         {
-            return gcem::sqrt(M * N);
+            return Math::sqrt(M * N);
         }
     };
 
@@ -102,12 +102,12 @@ namespace EllipsoidMath
     CurvatureRadiusCollection PrincipleCurvatureRadiiImpl(Latitude<__unit> B)
     {
         using ellipsoid_geometry = __ellipsoid_geometry;
-        double sinBp2 = gcem::pow(B.Sin(), 2),
+        double sinBp2 = Math::pow(B.Sin(), 2),
                a = ellipsoid_geometry::a,
                e1_2 = ellipsoid_geometry::e1_2,
                k = 1.0 - e1_2 * sinBp2;
-        double M = a * (1.0 - e1_2) * gcem::pow(k, -1.5),
-               N = a * gcem::pow(k, -0.5);
+        double M = a * (1.0 - e1_2) * Math::pow(k, -1.5),
+               N = a * Math::pow(k, -0.5);
         return {
             .M = M,
             .N = N};
@@ -171,9 +171,9 @@ namespace EllipsoidMath
                a4 = coeff::a4,
                a6 = coeff::a6;
         double B = _B.Rad(),
-               sin2B = gcem::sin(2 * B),
-               sin4B = gcem::sin(4 * B),
-               sin6B = gcem::sin(6 * B);
+               sin2B = Math::sin(2 * B),
+               sin4B = Math::sin(4 * B),
+               sin6B = Math::sin(6 * B);
         double X = a0 * Utils::Angles::ToDegrees(B) -
                    a2 * sin2B +
                    a4 * sin4B -
@@ -211,9 +211,9 @@ namespace EllipsoidMath
         {
             Bf_cur = Bf_next;
             FB =
-                -coeff::a2 * gcem::sin(2 * Bf_cur) +
-                coeff::a4 * gcem::sin(4 * Bf_cur) -
-                coeff::a6 * gcem::sin(6 * Bf_cur);
+                -coeff::a2 * Math::sin(2 * Bf_cur) +
+                coeff::a4 * Math::sin(4 * Bf_cur) -
+                coeff::a6 * Math::sin(6 * Bf_cur);
             Bf_next = FromDMS((len - FB) / coeff::a0); // deg -> rad
         } while (Bf_next - Bf_cur >= iter_threshold);
         return Bf_cur + dB; // return rad
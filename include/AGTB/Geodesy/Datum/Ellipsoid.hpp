@@ -5,7 +5,7 @@
 
 #include <concepts>
 
-#include <gcem.hpp>
+#include "../../Utils/FastMath.hpp"
 
 AGTB_GEODESY_BEGIN
 
@@ -106,10 +106,10 @@ struct LatitudeConstants
     using ellipsoid_geometry = __ellipsoid_geometry;
     constexpr LatitudeConstants(Latitude<Units::Radian> _B) : B(_B.Rad())
     {
-        t = gcem::tan(B);
-        nu_2 = ellipsoid_geometry::e2_2 * gcem::pow(gcem::cos(B), 2);
-        W = gcem::sqrt(1 - ellipsoid_geometry::e1_2 * gcem::pow(gcem::sin(B), 2));
-        V = gcem::sqrt(1 + nu_2);
+        t = Math::tan(B);
+        nu_2 = ellipsoid_geometry::e2_2 * Math::pow(Math::cos(B), 2);
+        W = Math::sqrt(1 - ellipsoid_geometry::e1_2 * Math::pow(Math::sin(B), 2));
+        V = Math::sqrt(1 + nu_2);
     }
 };
 
@@ -4,7 +4,7 @@
 #include "Units.hpp"
 #include "../../Utils/Angles.hpp"
 
-#include <gcem.hpp>
+#include "../../Utils/FastMath.hpp"
 
 AGTB_GEODESY_BEGIN
 
@@ -82,15 +82,15 @@ namespace detail
 
         constexpr double Sin() const noexcept
         {
-            return gcem::sin(Rad());
+            return Math::sin(Rad());
         }
         constexpr double Cos() const noexcept
         {
-            return gcem::cos(Rad());
+            return Math::cos(Rad());
         }
         constexpr double Tan() const noexcept
         {
-            return gcem::tan(Rad());
+            return Math::tan(Rad());
         }
 
         Utils::Angles::Angle ToAngle() const noexcept
@@ -116,7 +116,7 @@ public:
 
     virtual constexpr bool IsValid() const noexcept override
     {
-        return gcem::abs(this->Rad()) <= max;
+        return Math::abs(this->Rad()) <= max;
     }
 
     Latitude(double rad) : detail::GeoLatLonBase<__unit, Latitude>(rad)
@@ -148,7 +148,7 @@ public:
 
     virtual constexpr bool IsValid() const noexcept override
     {
-        return gcem::abs(this->Rad()) <= max;
+        return Math::abs(this->Rad()) <= max;
     }
 
     Longitude(double rad) : detail::GeoLatLonBase<__unit, Longitude>(rad)
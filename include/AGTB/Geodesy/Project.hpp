@@ -55,6 +55,17 @@ struct Projector<GeoCS::Geodetic, ProjCS::GaussKruger>
         return Projection::GaussKruger::GeodeticToGaussProj<__config::ellipsoid, __config::zone_interval, __config::unit>(gc, custom_zone);
     }
 
+    /**
+     * @brief Project many geodetic coordinates (radian) at once, see `GeodeticToGaussProjBatch`
+     *
+     */
+    template <Projection::ConfigConcept::GeodeticGaussKruger __config, Math::Simd::Precision __precision = Math::Simd::Full>
+    static inline void ProjectBatch(std::span<const double> B, std::span<const double> L,
+                                    std::span<double> x, std::span<double> y, std::span<int> zone, int custom_zone = 0)
+    {
+        Projection::GaussKruger::GeodeticToGaussProjBatch<__config::ellipsoid, __config::zone_interval, __precision>(B, L, x, y, zone, custom_zone);
+    }
+
     template <Projection::ConfigConcept::GeodeticGaussKruger __config>
     static inline __config::ProjCoord ReProject(const __config::ProjCoord &pc, int tar_zone)
     {
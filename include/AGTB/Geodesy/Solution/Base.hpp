@@ -2,6 +2,7 @@
 #define __AGTB_GEODESY_SOLUTION_BASE_HPP__
 
 #include "../Datum.hpp"
+#include "../../Utils/CpuDispatch.hpp"
 
 AGTB_GEODESY_BEGIN
 
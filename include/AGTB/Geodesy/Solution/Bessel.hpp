@@ -19,11 +19,11 @@ namespace Solution::Bessel
         {
             double
                 k2 = e2_2 * cosA0p2,
-                k4 = gcem::pow(k2, 2),
-                k6 = gcem::pow(k2, 3),
-                e4 = gcem::pow(e2, 2),
-                e6 = gcem::pow(e2, 3),
-                cosA0p4 = gcem::pow(cosA0p2, 2);
+                k4 = Math::pow(k2, 2),
+                k6 = Math::pow(k2, 3),
+                e4 = Math::pow(e2, 2),
+                e6 = Math::pow(e2, 3),
+                cosA0p4 = Math::pow(cosA0p2, 2);
 
             A = b * (1 +
                      k2 / 4.0 -
@@ -46,7 +46,7 @@ namespace Solution::Bessel
 
     double RefineLambda(double lambda, double sinA1, double tan_lambda)
     {
-        double abs_lambda = gcem::abs(lambda);
+        double abs_lambda = Math::abs(lambda);
 
         if (sinA1 > 0 && tan_lambda > 0)
         {
@@ -72,7 +72,7 @@ namespace Solution::Bessel
 
     double RefineA2(double A2, double sinA1, double tanA2)
     {
-        double absA2 = gcem::abs(A2);
+        double absA2 = Math::abs(A2);
 
         if (sinA1 < 0 && tanA2 > 0)
         {
@@ -98,7 +98,7 @@ namespace Solution::Bessel
 
     template <Ellipsoids __ellipsoid, Units __unit>
         requires Concept::EllipsoidGeometry<EllipsoidGeometry<__ellipsoid>>
-    ForwardResult<__unit> ForwardSolve(Longitude<__unit> L1, Latitude<__unit> B1, double S, Angle a_forward)
+    AGTB_MULTIVERSION ForwardResult<__unit> ForwardSolve(Longitude<__unit> L1, Latitude<__unit> B1, double S, Angle a_forward)
     {
         using ellipsoid_geometry = EllipsoidGeometry<__ellipsoid>;
         LatitudeConstants<ellipsoid_geometry> lc(B1);
@@ -107,15 +107,15 @@ namespace Solution::Bessel
             e2 = ellipsoid_geometry::e1_2,
             sinB1 = B1.Sin(),
             cosB1 = B1.Cos(),
-            sinu1 = sinB1 * gcem::sqrt(1 - e2) / W1,
+            sinu1 = sinB1 * Math::sqrt(1 - e2) / W1,
             cosu1 = cosB1 / W1,
             sinA1 = a_forward.Sin(),
             cosA1 = a_forward.Cos(),
             sinA0 = cosu1 * sinA1,
-            sinA0p2 = gcem::pow(sinA0, 2),
+            sinA0p2 = Math::pow(sinA0, 2),
             cosA0p2 = 1 - sinA0p2,
             cot_sigma1 = cosu1 * cosA1 / sinu1,
-            cot_sigma1p2 = gcem::pow(cot_sigma1, 2),
+            cot_sigma1p2 = Math::pow(cot_sigma1, 2),
             sin_2sigma1 = 2.0 * cot_sigma1 / (cot_sigma1p2 + 1),
             cos_2sigma1 = (cot_sigma1p2 - 1) / (cot_sigma1p2 + 1);
 
@@ -129,27 +129,27 @@ namespace Solution::Bessel
 
         double
             sigma0 = (S - (B + C * cos_2sigma1) * sin_2sigma1) / A,
-            sin_2sigma0 = gcem::sin(2 * sigma0),
-            cos_2sigma0 = gcem::cos(2 * sigma0),
+            sin_2sigma0 = Math::sin(2 * sigma0),
+            cos_2sigma0 = Math::cos(2 * sigma0),
             sin_2_sigma1_a_sigma0 = sin_2sigma1 * cos_2sigma0 + cos_2sigma1 * sin_2sigma0,
             cos_2_sigma1_a_sigma0 = cos_2sigma1 * cos_2sigma0 - sin_2sigma1 * sin_2sigma0,
             sigma = sigma0 + (B + 5 * C * cos_2_sigma1_a_sigma0) * sin_2_sigma1_a_sigma0 / A,
-            sin_sigma = gcem::sin(sigma),
-            cos_sigma = gcem::cos(sigma),
+            sin_sigma = Math::sin(sigma),
+            cos_sigma = Math::cos(sigma),
             delta = (alpha * sigma + beta * (sin_2_sigma1_a_sigma0 - sin_2sigma1)) * sinA0,
             sinu2 = sinu1 * cos_sigma + cosu1 * cosA1 * sin_sigma,
-            sinu2p2 = gcem::pow(sinu2, 2),
-            B2 = gcem::atan(
-                sinu2 / (gcem::sqrt(1 - e2) * gcem::sqrt(1 - sinu2p2))),
-            lambda = gcem::atan(
+            sinu2p2 = Math::pow(sinu2, 2),
+            B2 = Math::atan(
+                sinu2 / (Math::sqrt(1 - e2) * Math::sqrt(1 - sinu2p2))),
+            lambda = Math::atan(
                 (sinA1 * sin_sigma) / (cosu1 * cos_sigma - sinu1 * sin_sigma * cosA1)),
-            tan_lambda = gcem::tan(lambda);
+            tan_lambda = Math::tan(lambda);
         lambda = RefineLambda(lambda, sinA1, tan_lambda);
         double
             L2 = L1.Rad() + lambda - delta,
-            A2 = gcem::atan(
+            A2 = Math::atan(
                 cosu1 * sinA1 / (cosu1 * cos_sigma * cosA1 - sinu1 * sin_sigma)),
-            tanA2 = gcem::tan(A2);
+            tanA2 = Math::tan(A2);
         A2 = RefineA2(A2, sinA1, tanA2);
 
         // std::println(
@@ -164,7 +164,7 @@ namespace Solution::Bessel
 
     double RefineA1(double A1, double p, double q)
     {
-        double absA1 = gcem::abs(A1);
+        double absA1 = Math::abs(A1);
 
         if (p > 0 && q > 0)
         {
@@ -190,7 +190,7 @@ namespace Solution::Bessel
 
     double RefineSigma(double sigma, double cos_sigma)
     {
-        double abs_sigma = gcem::abs(sigma);
+        double abs_sigma = Math::abs(sigma);
 
         if (cos_sigma > 0)
         {
@@ -208,7 +208,7 @@ namespace Solution::Bessel
 
     template <Ellipsoids __ellipsoid, Units __unit>
         requires Concept::EllipsoidGeometry<EllipsoidGeometry<__ellipsoid>>
-    InverseResult InverseSolve(Longitude<__unit> L1, Latitude<__unit> B1, Longitude<__unit> L2, Latitude<__unit> B2, double epsilon = 1e-5)
+    AGTB_MULTIVERSION InverseResult InverseSolve(Longitude<__unit> L1, Latitude<__unit> B1, Longitude<__unit> L2, Latitude<__unit> B2, double epsilon = 1e-5)
     {
         using ellipsoid_geometry = EllipsoidGeometry<__ellipsoid>;
         LatitudeConstants<ellipsoid_geometry> lc1(B1), lc2(B2);
@@ -221,7 +221,7 @@ namespace Solution::Bessel
             sinB2 = B2.Sin(),
             cosB2 = B2.Cos(),
             e2 = ellipsoid_geometry::e1_2,
-            sqrt_1_s_e2 = gcem::sqrt(1 - e2),
+            sqrt_1_s_e2 = Math::sqrt(1 - e2),
             sinu1 = sinB1 * sqrt_1_s_e2 / W1,
             sinu2 = sinB2 * sqrt_1_s_e2 / W2,
             cosu1 = cosB1 / W1,
@@ -251,27 +251,26 @@ namespace Solution::Bessel
         {
             delta_p = delta;
             lambda_p = lambda;
-            double
-                cos_lambda = gcem::cos(lambda),
-                sin_lambda = gcem::sin(lambda);
+            double cos_lambda, sin_lambda;
+            Math::sincos(lambda, sin_lambda, cos_lambda);
 
             double
                 p = cosu2 * sin_lambda,
                 q = b1 - b2 * cos_lambda;
-            A1 = gcem::atan(p / q);
+            A1 = Math::atan(p / q);
             A1 = RefineA1(A1, p, q);
 
+            double sinA1, cosA1;
+            Math::sincos(A1, sinA1, cosA1);
             double
-                sinA1 = gcem::sin(A1),
-                cosA1 = gcem::cos(A1),
                 sin_sigma = p * sinA1 + q * cosA1,
                 cos_sigma = a1 + a2 * cos_lambda;
-            sigma = gcem::atan(sin_sigma / cos_sigma);
+            sigma = Math::atan(sin_sigma / cos_sigma);
             sigma = RefineSigma(sigma, cos_sigma);
 
             sinA0 = cosu1 * sinA1;
             double
-                sinA0p2 = gcem::pow(sinA0, 2),
+                sinA0p2 = Math::pow(sinA0, 2),
                 cosA0p2 = 1 - sinA0p2;
             x = 2 * a1 - cosA0p2 * cos_sigma;
 
@@ -287,18 +286,18 @@ namespace Solution::Bessel
             //              i++, sin_lambda, p, q, Angle::FromRad(A1).ToString(), sigma, sinA0, x, alpha, delta * rad2sec, beta_prime);
         } while (
             !(
-                gcem::abs(delta - delta_p) < epsilon &&
-                gcem::abs(lambda - lambda_p) < epsilon));
+                Math::abs(delta - delta_p) < epsilon &&
+                Math::abs(lambda - lambda_p) < epsilon));
 
         double
-            sinA0p2 = gcem::pow(sinA0, 2),
+            sinA0p2 = Math::pow(sinA0, 2),
             cosA0p2 = 1 - sinA0p2,
-            cosA0p4 = gcem::pow(cosA0p2, 2),
-            x2 = gcem::pow(x, 2),
-            cos_sigma = gcem::cos(sigma),
-            sin_sigma = gcem::sin(sigma),
-            sin_lambda = gcem::sin(lambda),
-            cos_lambda = gcem::cos(lambda),
+            cosA0p4 = Math::pow(cosA0p2, 2),
+            x2 = Math::pow(x, 2),
+            cos_sigma = Math::cos(sigma),
+            sin_sigma = Math::sin(sigma),
+            sin_lambda = Math::sin(lambda),
+            cos_lambda = Math::cos(lambda),
             y = (cosA0p4 - 2 * x2) * cos_sigma;
 
         CoeffSolver<__ellipsoid> coeff_solver(cosA0p2);
@@ -307,7 +306,7 @@ namespace Solution::Bessel
             B_pp = 2 * coeff_solver.B / cosA0p2,
             C_pp = 2 * coeff_solver.C / cosA0p4,
             S = A * sigma + (B_pp * x + C_pp * y) * sin_sigma,
-            A2 = gcem::atan(
+            A2 = Math::atan(
                 cosu1 * sin_lambda / (b1 * cos_lambda - b2));
         double d180r = 180 * deg2rad;
         A2 = (A1 < d180r ? 1 : -1) * d180r + A2;
@@ -322,6 +321,12 @@ namespace Solution::Bessel
             .s = S};
     }
 
+    namespace detail
+    {
+        inline const bool solutions_registered =
+            Utils::detail::CpuDispatch::Register("Geodesy::Solution::Bessel::ForwardSolve", Utils::detail::CpuDispatch::Kind::Clones) &&
+            Utils::detail::CpuDispatch::Register("Geodesy::Solution::Bessel::InverseSolve", Utils::detail::CpuDispatch::Kind::Clones);
+    }
 }
 
 AGTB_GEODESY_END
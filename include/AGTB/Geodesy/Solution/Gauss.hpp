@@ -28,15 +28,15 @@ namespace Solution::Gauss
             double N = crc.N;
 
             double
-                p2 = gcem::pow(ps, 2),
-                p3 = gcem::pow(ps, 3),
-                V2 = gcem::pow(V, 2),
-                V4 = gcem::pow(V, 4),
-                V6 = gcem::pow(V, 6),
-                n4 = gcem::pow(n2, 2),
-                t2 = gcem::pow(t, 2),
-                cosB2 = gcem::pow(cosB, 2),
-                cosB3 = gcem::pow(cosB, 3);
+                p2 = Math::pow(ps, 2),
+                p3 = Math::pow(ps, 3),
+                V2 = Math::pow(V, 2),
+                V4 = Math::pow(V, 4),
+                V6 = Math::pow(V, 6),
+                n4 = Math::pow(n2, 2),
+                t2 = Math::pow(t, 2),
+                cosB2 = Math::pow(cosB, 2),
+                cosB3 = Math::pow(cosB, 3);
 
             r01 = N / ps * cosB;
             r21 = (N * cosB) / (24 * p3 * V4) * (1 + n2 - 9 * n2 * t2 + n4);
@@ -53,17 +53,17 @@ namespace Solution::Gauss
 
         inline double U(double dLs, double dBs) const noexcept
         {
-            return r01 * dLs + r21 * gcem::pow(dBs, 2) * dLs + r03 * gcem::pow(dLs, 3);
+            return r01 * dLs + r21 * Math::pow(dBs, 2) * dLs + r03 * Math::pow(dLs, 3);
         }
 
         inline double V(double dLs, double dBs) const noexcept
         {
-            return S10 * dBs + S12 * dBs * gcem::pow(dLs, 2) + S30 * gcem::pow(dBs, 3);
+            return S10 * dBs + S12 * dBs * Math::pow(dLs, 2) + S30 * Math::pow(dBs, 3);
         }
 
         inline double DeltaAs(double dLs, double dBs) const noexcept
         {
-            return t01 * dLs + t21 * gcem::pow(dBs, 2) * dLs + t03 * gcem::pow(dLs, 3);
+            return t01 * dLs + t21 * Math::pow(dBs, 2) * dLs + t03 * Math::pow(dLs, 3);
         }
     };
 
@@ -97,7 +97,7 @@ namespace Solution::Gauss
 
     template <Ellipsoids __ellipsoid, Units __unit>
         requires Concept::EllipsoidGeometry<EllipsoidGeometry<__ellipsoid>>
-    InverseResult InverseSolve(Longitude<__unit> L1, Latitude<__unit> B1, Longitude<__unit> L2, Latitude<__unit> B2)
+    AGTB_MULTIVERSION InverseResult InverseSolve(Longitude<__unit> L1, Latitude<__unit> B1, Longitude<__unit> L2, Latitude<__unit> B2)
     {
         double
             dLs = ToSeconds(L2.Rad() - L1.Rad()),
@@ -113,13 +113,13 @@ namespace Solution::Gauss
             tanA = U / V;
 
         double
-            c = gcem::abs(V / U),
-            T = (gcem::abs(dBs) >= gcem::abs(dLs)) ? gcem::atan(U / V) : std::numbers::pi / 4.0 + gcem::atan((1.0 - c) / (1.0 + c)),
+            c = Math::abs(V / U),
+            T = (Math::abs(dBs) >= Math::abs(dLs)) ? Math::atan(U / V) : std::numbers::pi / 4.0 + Math::atan((1.0 - c) / (1.0 + c)),
             Am_rad = ComputeAmRadFromT(T, dBs, dLs),
             Am = Am_rad * rad2sec;
 
         double
-            S = (U / gcem::sin(Am_rad) + V / gcem::cos(Am_rad)) / 2.0,
+            S = (U / Math::sin(Am_rad) + V / Math::cos(Am_rad)) / 2.0,
             A12 = Am - dAs / 2.0,
             d180s = 180 * 3600,
             A21 = Am + dAs / 2.0 + (A12 < d180s ? 1 : -1) * d180s;
@@ -144,7 +144,7 @@ namespace Solution::Gauss
 
     template <Ellipsoids __ellipsoid, Units __unit>
         requires Concept::EllipsoidGeometry<EllipsoidGeometry<__ellipsoid>>
-    ForwardResult<__unit> ForwardSolve(Longitude<__unit> L, Latitude<__unit> B, double S, Angle a_forward, double epsilon = 1e-5)
+    AGTB_MULTIVERSION ForwardResult<__unit> ForwardSolve(Longitude<__unit> L, Latitude<__unit> B, double S, Angle a_forward, double epsilon = 1e-5)
     {
         double dB0, dL0, dA0;
         InitForwardSolveIteration<__ellipsoid>(L, B, S, a_forward, dB0, dL0, dA0);
@@ -166,20 +166,20 @@ namespace Solution::Gauss
             CurvatureRadiusCollection crc = PrincipleCurvatureRadii<__ellipsoid, __unit>(Bm * sec2rad);
             double
                 N = crc.N,
-                N2 = gcem::pow(N, 2),
+                N2 = Math::pow(N, 2),
                 V = lc.V,
-                V2 = gcem::pow(V, 2),
-                S2 = gcem::pow(S, 2),
+                V2 = Math::pow(V, 2),
+                S2 = Math::pow(S, 2),
                 t = lc.t,
-                t2 = gcem::pow(t, 2),
+                t2 = Math::pow(t, 2),
                 n2 = lc.nu_2,
-                n4 = gcem::pow(n2, 2),
+                n4 = Math::pow(n2, 2),
                 p = rho<Units::Second>,
-                cosA = gcem::cos(Am * sec2rad),
-                cosA2 = gcem::pow(cosA, 2),
-                sinA = gcem::sin(Am * sec2rad),
-                sinA2 = gcem::pow(sinA, 2),
-                secB = 1.0 / gcem::cos(Bm * sec2rad);
+                cosA = Math::cos(Am * sec2rad),
+                cosA2 = Math::pow(cosA, 2),
+                sinA = Math::sin(Am * sec2rad),
+                sinA2 = Math::pow(sinA, 2),
+                secB = 1.0 / Math::cos(Bm * sec2rad);
 
             dB = V2 / N * p * S * cosA * (1 + S2 / (24 * N2) * (sinA2 * (2 + 3 * t2 + 3 * n2 * t2) + 3 * n2 * cosA2 * (-1 + t2 - n2 - 4 * t2 * n2)));
             dL = p / N * S * secB * sinA * (1 + S2 / (24 * N2) * (sinA2 * t2 - cosA2 * (1 + n2 - 9 * t2 * n2 + n4)));
@@ -188,9 +188,9 @@ namespace Solution::Gauss
             Bm = B.Rad() * rad2sec + dB / 2.0;
             Am = a_forward.Rad() * rad2sec + dA / 2.0;
         } while (
-            !((gcem::abs(dB - dBp) < epsilon) &&
-              (gcem::abs(dL - dLp) < epsilon) &&
-              (gcem::abs(dA - dAp) < epsilon)));
+            !((Math::abs(dB - dBp) < epsilon) &&
+              (Math::abs(dL - dLp) < epsilon) &&
+              (Math::abs(dA - dAp) < epsilon)));
 
         Longitude<> L_tar(L.Rad() + dL * sec2rad);
         Latitude<> B_tar(B.Rad() + dB * sec2rad);
@@ -199,6 +199,13 @@ namespace Solution::Gauss
         return {
             L_tar, B_tar, a_backward};
     }
+
+    namespace detail
+    {
+        inline const bool solutions_registered =
+            Utils::detail::CpuDispatch::Register("Geodesy::Solution::Gauss::ForwardSolve", Utils::detail::CpuDispatch::Kind::Clones) &&
+            Utils::detail::CpuDispatch::Register("Geodesy::Solution::Gauss::InverseSolve", Utils::detail::CpuDispatch::Kind::Clones);
+    }
 }
 
 AGTB_GEODESY_END
@@ -5,5 +5,8 @@
 #include "IO/CSV.hpp"
 #include "IO/JSON.hpp"
 #include "IO/Adjustment.hpp"
+#include "IO/ColumnarBinary.hpp"
+#include "IO/CSVBatchReader.hpp"
+#include "IO/CSVWriter.hpp"
 
 #endif
\ No newline at end of file
@@ -3,15 +3,30 @@
 
 #include "../details/Macros.hpp"
 #include "../Container/DataFrame.hpp"
+#include "../Container/ColumnarDataFrame.hpp"
 #include "../Utils/CharConv.hpp"
+#include "../Utils/Parallel.hpp"
+#include "../Utils/MappedFile.hpp"
+#include "../Utils/CpuDispatch.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <boost/iostreams/stream.hpp>
 #include <boost/iostreams/device/file.hpp>
 #include <boost/algorithm/string.hpp> // For split, trim
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 AGTB_IO_BEGIN
 
 /**
@@ -51,11 +66,11 @@ DataFrame<__value_type, __row_key_type, __col_key_type> ReadCSV(
     while (std::getline(file_stream, line))
     {
         line_number++;
-        std::vector<std::string> fields;
-        boost::split(fields, line, boost::is_any_of(separator), boost::token_compress_on);
 
         if (has_header && headers.empty())
         {
+            std::vector<std::string> fields;
+            boost::split(fields, line, boost::is_any_of(separator), boost::token_compress_on);
             headers.reserve(fields.size());
             for (auto &field : fields)
             {
@@ -67,23 +82,20 @@ DataFrame<__value_type, __row_key_type, __col_key_type> ReadCSV(
 
         if constexpr (std::same_as<__value_type, std::string>)
         {
+            std::vector<std::string> fields;
+            boost::split(fields, line, boost::is_any_of(separator), boost::token_compress_on);
             data_rows.push_back(std::move(fields));
             row_names.emplace_back(std::to_string(data_rows.size() - 1));
         }
-        else if (fields.size() > 0)
+        else
         {
             std::vector<__value_type> row_data;
-            row_data.reserve(fields.size());
-            for (auto &field : fields)
+            row_data.reserve(headers.size());
+            std::string_view bad_field{};
+            if (!Utils::ParseDelimited<__value_type>(line, separator, row_data, bad_field))
             {
-                boost::trim(field);
-                __value_type converted_value;
-                if (!FromString<__value_type>(field, converted_value))
-                {
-                    AGTB_THROW(std::invalid_argument,
-                               std::format("Cannot convert field '{}' at line {} to type", field, line_number));
-                }
-                row_data.push_back(converted_value);
+                AGTB_THROW(std::invalid_argument,
+                           std::format("Cannot convert field '{}' at line {} to type", bad_field, line_number));
             }
             data_rows.push_back(std::move(row_data));
             row_names.emplace_back(std::to_string(data_rows.size() - 1));
@@ -146,6 +158,709 @@ DataFrame<__value_type, __row_key_type, __col_key_type> ReadCSV(
     return df;
 }
 
+namespace detail::CSV
+{
+    /**
+     * @brief Whole file in one string
+     *
+     */
+    inline std::string ReadFile(const std::string &fname)
+    {
+        std::ifstream file(fname, std::ios_base::in | std::ios_base::binary);
+        if (!file)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Cannot open file: {}", fname));
+        }
+        file.seekg(0, std::ios_base::end);
+        std::string content(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0, std::ios_base::beg);
+        file.read(content.data(), content.size());
+        return content;
+    }
+
+    /**
+     * @brief Integer if every field is one, real if every non-empty field is a number (empty fields become NaN),
+     * otherwise string
+     *
+     */
+    inline Container::ColumnType InferColumnType(const std::vector<std::string_view> &cells)
+    {
+        bool integer = true, real = true;
+        for (std::string_view cell : cells)
+        {
+            std::int64_t i;
+            double d;
+            if (integer && !Utils::FromStringExact(cell, i))
+            {
+                integer = false;
+            }
+            if (!integer && !cell.empty() && !Utils::FromStringExact(cell, d))
+            {
+                real = false;
+                break;
+            }
+        }
+        return integer ? Container::ColumnType::Integer
+                       : (real ? Container::ColumnType::Real : Container::ColumnType::String);
+    }
+
+    template <typename __value_type>
+    std::vector<__value_type> ConvertColumn(const std::vector<std::string_view> &cells, std::string_view key)
+    {
+        std::vector<__value_type> values(cells.size());
+        for (size_t r = 0; r != cells.size(); ++r)
+        {
+            if constexpr (std::same_as<__value_type, std::string>)
+            {
+                values[r] = cells[r];
+            }
+            else if (cells[r].empty() && std::floating_point<__value_type>)
+            {
+                values[r] = std::numeric_limits<__value_type>::quiet_NaN();
+            }
+            else if (!Utils::FromStringExact(cells[r], values[r]))
+            {
+                AGTB_THROW(std::invalid_argument, std::format("Cannot convert field '{}' at row {} of column {}", cells[r], r, key));
+            }
+        }
+        return values;
+    }
+}
+
+/**
+ * @brief Read Csv file to a `ColumnarDataFrame`, each column parsed once into its own type. Types are inferred
+ * (integer, real, string) unless given in `types` by column key, e.g. numeric point names kept as string.
+ * Fields are split and trimmed as in `ReadCSV`, blank lines are skipped, missing fields are empty.
+ *
+ * @tparam __row_key_type
+ * @tparam __col_key_type
+ * @param fname
+ * @param separator
+ * @param has_header
+ * @param types
+ * @return ColumnarDataFrame<__row_key_type, __col_key_type>
+ */
+template <typename __row_key_type = std::string, typename __col_key_type = std::string>
+Container::ColumnarDataFrame<__row_key_type, __col_key_type> ReadColumnarCSV(
+    const std::string &fname,
+    std::string separator = ",",
+    bool has_header = true,
+    const std::unordered_map<std::string, Container::ColumnType> &types = {})
+{
+    using DataFrameType = Container::ColumnarDataFrame<__row_key_type, __col_key_type>;
+    using Container::ColumnType;
+
+    const std::string content = detail::CSV::ReadFile(fname);
+    const std::string_view text = content;
+
+    std::vector<std::string> headers{};
+    std::vector<std::vector<std::string_view>> cells{};
+    std::vector<std::string_view> fields{};
+    bool header_pending = has_header;
+
+    for (size_t begin = 0; begin < text.size();)
+    {
+        const size_t end = std::min(text.find('\n', begin), text.size());
+        const std::string_view line = text.substr(begin, end - begin);
+        begin = end + 1;
+        if (line.find_first_not_of(" \t\r\v\f") == std::string_view::npos)
+        {
+            continue;
+        }
+
+        fields.clear();
+        Utils::SplitDelimited(line, separator, fields);
+        if (header_pending)
+        {
+            headers.assign(fields.begin(), fields.end());
+            header_pending = false;
+            continue;
+        }
+        if (cells.empty())
+        {
+            cells.resize(has_header ? headers.size() : fields.size());
+        }
+        for (size_t c = 0; c != cells.size(); ++c)
+        {
+            cells[c].emplace_back(c < fields.size() ? fields[c] : std::string_view{});
+        }
+    }
+
+    if (cells.empty())
+    {
+        return DataFrameType();
+    }
+    if (!has_header)
+    {
+        for (size_t c = 0; c != cells.size(); ++c)
+        {
+            headers.emplace_back("Col" + std::to_string(c));
+        }
+    }
+
+    std::vector<typename DataFrameType::column_type> columns(cells.size());
+    Utils::ParallelFor(
+        cells.size(),
+        [&](size_t c)
+        {
+            auto it = types.find(headers[c]);
+            switch (it != types.end() ? it->second : detail::CSV::InferColumnType(cells[c]))
+            {
+            case ColumnType::String:
+                columns[c] = detail::CSV::ConvertColumn<std::string>(cells[c], headers[c]);
+                break;
+            case ColumnType::Integer:
+                columns[c] = detail::CSV::ConvertColumn<std::int64_t>(cells[c], headers[c]);
+                break;
+            default:
+                columns[c] = detail::CSV::ConvertColumn<double>(cells[c], headers[c]);
+                break;
+            }
+        });
+
+    const size_t num_rows = cells.front().size();
+    DataFrameType df(num_rows);
+    for (size_t c = 0; c != columns.size(); ++c)
+    {
+        std::visit(
+            [&](auto &col)
+            { df.AddColumn(static_cast<__col_key_type>(headers[c]), std::move(col)); },
+            columns[c]);
+    }
+    return df;
+}
+
+namespace detail::CSV
+{
+    constexpr std::string_view spaces = " \t\r\n\v\f";
+
+    inline std::string_view Trim(std::string_view field) noexcept
+    {
+        const size_t first = field.find_first_not_of(spaces);
+        return first == std::string_view::npos ? std::string_view{} : field.substr(first, field.find_last_not_of(spaces) - first + 1);
+    }
+
+    constexpr std::string_view blanks = " \t\r\v\f";
+
+    /**
+     * @brief A line of only blanks is skipped whatever the separator, even if blanks are separators
+     *
+     */
+    inline bool IsBlank(std::string_view line) noexcept
+    {
+        return line.find_first_not_of(blanks) == std::string_view::npos;
+    }
+
+    /**
+     * @brief Start of the first line at or after `pos` that is not `IsBlank`, `end` if none
+     *
+     */
+    inline size_t SkipBlankLines(std::string_view text, size_t pos, size_t end) noexcept
+    {
+        while (pos < end)
+        {
+            const size_t first = std::min(text.find_first_not_of(blanks, pos), end);
+            if (first == end || text[first] != '\n')
+            {
+                return first == end ? end : pos;
+            }
+            pos = first + 1;
+        }
+        return end;
+    }
+
+    /**
+     * @brief Bit `i` is set if `block[i]` is `'\n'` or one of `separators`, for a block of 64 bytes
+     *
+     */
+    inline std::uint64_t DelimiterMask(const char *block, std::string_view separators) noexcept
+    {
+        std::uint64_t mask = 0;
+#if defined(__SSE2__)
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (int k = 0; k != 4; ++k)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * k));
+            __m128i hit = _mm_cmpeq_epi8(bytes, newline);
+            for (const char s : separators)
+            {
+                hit = _mm_or_si128(hit, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(s)));
+            }
+            mask |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(hit))) << (16 * k);
+        }
+#else
+        for (int i = 0; i != 64; ++i)
+        {
+            if (block[i] == '\n' || separators.find(block[i]) != std::string_view::npos)
+            {
+                mask |= std::uint64_t{1} << i;
+            }
+        }
+#endif
+        return mask;
+    }
+
+#if AGTB_CPU_DISPATCH
+    AGTB_TARGET_V3 inline std::uint64_t DelimiterMaskV3(const char *block, std::string_view separators) noexcept
+    {
+        std::uint64_t mask = 0;
+        const __m256i newline = _mm256_set1_epi8('\n');
+        for (int k = 0; k != 2; ++k)
+        {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * k));
+            __m256i hit = _mm256_cmpeq_epi8(bytes, newline);
+            for (const char s : separators)
+            {
+                hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(s)));
+            }
+            mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(hit))) << (32 * k);
+        }
+        return mask;
+    }
+#endif
+
+    inline const bool delimiter_mask_registered =
+        Utils::detail::CpuDispatch::Register("IO::ReadColumnarCSVMapped::DelimiterMask", Utils::detail::CpuDispatch::Kind::Explicit);
+
+    /**
+     * @brief Finds delimiters (`'\n'` or a separator) of `text` in increasing positions, 64 bytes per mask
+     *
+     */
+    class DelimiterScanner
+    {
+    public:
+        using mask_function = std::uint64_t (*)(const char *, std::string_view) noexcept;
+
+        DelimiterScanner(std::string_view text, std::string_view separators)
+            : text_(text), separators_(separators), mask_(&DelimiterMask)
+        {
+#if AGTB_CPU_DISPATCH
+            if (Utils::ActiveCpuPath() != Utils::CpuPath::Default)
+            {
+                mask_ = &DelimiterMaskV3;
+            }
+#endif
+        }
+
+        /**
+         * @brief First delimiter at or after `pos`, `text.size()` if none
+         *
+         */
+        size_t Next(size_t pos)
+        {
+            if (pos >= text_.size())
+            {
+                return text_.size();
+            }
+            size_t block = pos & ~size_t{63};
+            if (block != block_)
+            {
+                __Load(block);
+            }
+            std::uint64_t bits = bits_ & (~std::uint64_t{0} << (pos - block));
+            while (bits == 0)
+            {
+                block += 64;
+                if (block >= text_.size())
+                {
+                    return text_.size();
+                }
+                __Load(block);
+                bits = bits_;
+            }
+            return std::min(block + std::countr_zero(bits), text_.size());
+        }
+
+    private:
+        void __Load(size_t block)
+        {
+            block_ = block;
+            if (block + 64 <= text_.size())
+            {
+                bits_ = mask_(text_.data() + block, separators_);
+                return;
+            }
+            char tail[64]{};
+            std::memcpy(tail, text_.data() + block, text_.size() - block);
+            bits_ = mask_(tail, separators_);
+        }
+
+        std::string_view text_;
+        std::string_view separators_;
+        mask_function mask_;
+        size_t block_ = std::numeric_limits<size_t>::max();
+        std::uint64_t bits_ = 0;
+    };
+
+    /**
+     * @brief Ends of `chunks` pieces of `text`, each moved forward to just after a `'\n'`
+     *
+     */
+    inline std::vector<size_t> ChunkBounds(std::string_view text, size_t chunks)
+    {
+        std::vector<size_t> bounds{0};
+        for (size_t k = 1; k < chunks; ++k)
+        {
+            const size_t at = std::max(bounds.back(), text.size() / chunks * k);
+            const size_t newline = text.find('\n', at);
+            if (newline == std::string_view::npos)
+            {
+                break;
+            }
+            if (newline + 1 > bounds.back())
+            {
+                bounds.push_back(newline + 1);
+            }
+        }
+        if (bounds.back() != text.size())
+        {
+            bounds.push_back(text.size());
+        }
+        return bounds;
+    }
+
+    /**
+     * @brief Rows `ParseChunk` finds in `text`
+     *
+     */
+    inline size_t CountRows(std::string_view text)
+    {
+        size_t rows = 0;
+        for (size_t begin = SkipBlankLines(text, 0, text.size()); begin < text.size(); begin = SkipBlankLines(text, begin, text.size()))
+        {
+            ++rows;
+            begin = std::min(text.find('\n', begin), text.size()) + 1;
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Typed destination of one column. Columns not `active` in a pass are skipped.
+     *
+     */
+    struct MappedColumn
+    {
+        Container::ColumnType type = Container::ColumnType::String;
+        bool fixed = false;
+        bool active = true;
+        std::string *strings = nullptr;
+        std::int64_t *integers = nullptr;
+        double *reals = nullptr;
+    };
+
+    /**
+     * @brief Convert `field` at `row` into its column. A field not fitting `type` demotes it (integer -> real ->
+     * string) unless the column type is `fixed`, after which the column is only checked, not stored. Errors report
+     * `row_offset + row`.
+     *
+     */
+    inline void ConvertField(const MappedColumn &column, Container::ColumnType &type, std::string_view field,
+                             size_t row, std::string_view key, size_t row_offset = 0)
+    {
+        using Container::ColumnType;
+        const bool store = type == column.type;
+        switch (type)
+        {
+        case ColumnType::Integer:
+        {
+            std::int64_t value;
+            if (Utils::FromStringExact(field, value))
+            {
+                if (store)
+                {
+                    column.integers[row] = value;
+                }
+                return;
+            }
+            double real;
+            type = field.empty() || Utils::FromStringExact(field, real) ? ColumnType::Real : ColumnType::String;
+            break;
+        }
+        case ColumnType::Real:
+        {
+            double value;
+            if (field.empty() || Utils::FromStringExact(field, value))
+            {
+                if (store)
+                {
+                    column.reals[row] = field.empty() ? std::numeric_limits<double>::quiet_NaN() : value;
+                }
+                return;
+            }
+            type = ColumnType::String;
+            break;
+        }
+        default:
+            if (store)
+            {
+                column.strings[row] = field;
+            }
+            return;
+        }
+        if (column.fixed)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Cannot convert field '{}' at row {} of column {}", field, row_offset + row, key));
+        }
+    }
+
+    /**
+     * @brief Tokenize the rows of `text[begin, end)` and convert their fields into rows `[row, row_end)`, counted
+     * by `CountRows` beforehand. Fields are split and trimmed as by `Utils::SplitDelimited`.
+     *
+     */
+    inline void ParseChunk(std::string_view text, size_t begin, size_t end, std::string_view separators, size_t row,
+                           size_t row_end, std::span<const MappedColumn> columns, std::span<Container::ColumnType> types,
+                           std::span<const std::string> keys, size_t row_offset = 0)
+    {
+        DelimiterScanner scanner(text, separators);
+        const size_t cols = columns.size();
+        auto emit = [&](size_t c, std::string_view field)
+        {
+            if (columns[c].active)
+            {
+                ConvertField(columns[c], types[c], field, row, keys[c], row_offset);
+            }
+        };
+
+        for (size_t pos = SkipBlankLines(text, begin, end); pos < end; pos = SkipBlankLines(text, pos, end))
+        {
+            if (row == row_end)
+            {
+                AGTB_THROW(std::runtime_error, std::format("More rows than the {} counted at row {}", row_end, row_offset + row));
+            }
+            size_t c = 0, field_begin = pos;
+            while (true)
+            {
+                const size_t delimiter = std::min(scanner.Next(field_begin), end);
+                const std::string_view field = Trim(text.substr(field_begin, delimiter - field_begin));
+                const bool line_end = delimiter == end || text[delimiter] == '\n';
+                if (c < cols)
+                {
+                    emit(c, field);
+                }
+                ++c;
+                if (line_end)
+                {
+                    for (; c < cols; ++c)
+                    {
+                        emit(c, {});
+                    }
+                    ++row;
+                    pos = delimiter + 1;
+                    break;
+                }
+                field_begin = delimiter + 1;
+                while (field_begin < end && separators.find(text[field_begin]) != std::string_view::npos)
+                {
+                    ++field_begin;
+                }
+            }
+        }
+        if (row != row_end)
+        {
+            AGTB_THROW(std::runtime_error, std::format("{} rows parsed, {} counted", row_offset + row, row_offset + row_end));
+        }
+    }
+
+    /**
+     * @brief `InferColumnType` of each of `cols` columns over the first `max_rows` non-blank rows of `text`
+     *
+     */
+    inline std::vector<Container::ColumnType> InferColumnTypes(std::string_view text, std::string_view separators,
+                                                               size_t cols, size_t max_rows)
+    {
+        std::vector<std::vector<std::string_view>> cells(cols);
+        std::vector<std::string_view> fields{};
+        for (size_t begin = 0, rows = 0; begin < text.size() && rows != max_rows;)
+        {
+            const size_t end = std::min(text.find('\n', begin), text.size());
+            const std::string_view line = text.substr(begin, end - begin);
+            begin = end + 1;
+            if (IsBlank(line))
+            {
+                continue;
+            }
+            fields.clear();
+            Utils::SplitDelimited(line, separators, fields);
+            for (size_t c = 0; c != cols; ++c)
+            {
+                cells[c].emplace_back(c < fields.size() ? fields[c] : std::string_view{});
+            }
+            ++rows;
+        }
+        std::vector<Container::ColumnType> types(cols);
+        std::ranges::transform(cells, types.begin(), InferColumnType);
+        return types;
+    }
+
+    inline int Rank(Container::ColumnType type) noexcept
+    {
+        switch (type)
+        {
+        case Container::ColumnType::Integer:
+            return 2;
+        case Container::ColumnType::Real:
+            return 1;
+        default:
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief `ReadColumnarCSV` for large files. The file is memory mapped and cut into newline-aligned chunks that are
+ * parsed in parallel: delimiters are found 64 bytes at a time with SIMD compares, fields are trimmed views into
+ * the mapping and numbers are converted by `std::from_chars` straight into preallocated columns. Types are
+ * inferred from the first rows; a later field that does not fit demotes its column, which is then parsed again.
+ * Result is the same as `ReadColumnarCSV`.
+ *
+ * @tparam __row_key_type
+ * @tparam __col_key_type
+ * @param fname
+ * @param separator
+ * @param has_header
+ * @param types
+ * @param threads `0` means `Utils::HardwareThreads()`
+ * @return ColumnarDataFrame<__row_key_type, __col_key_type>
+ */
+template <typename __row_key_type = std::string, typename __col_key_type = std::string>
+Container::ColumnarDataFrame<__row_key_type, __col_key_type> ReadColumnarCSVMapped(
+    const std::string &fname,
+    std::string separator = ",",
+    bool has_header = true,
+    const std::unordered_map<std::string, Container::ColumnType> &types = {},
+    size_t threads = 0)
+{
+    using DataFrameType = Container::ColumnarDataFrame<__row_key_type, __col_key_type>;
+    using Container::ColumnType;
+    constexpr size_t sample_rows = 1024;
+
+    const Utils::MappedFile file(fname);
+    file.Advise(Utils::MappedFile::Access::Sequential);
+    const std::string_view text = file.View();
+
+    // First non-blank line is the header or fixes the number of columns
+    std::vector<std::string_view> fields{};
+    size_t body = 0;
+    while (body < text.size() && fields.empty())
+    {
+        const size_t end = std::min(text.find('\n', body), text.size());
+        const std::string_view line = text.substr(body, end - body);
+        if (!detail::CSV::IsBlank(line))
+        {
+            Utils::SplitDelimited(line, separator, fields);
+            body = has_header ? end + 1 : body;
+            break;
+        }
+        body = end + 1;
+    }
+    const std::string_view rows_text = text.substr(std::min(body, text.size()));
+
+    std::vector<std::string> headers{};
+    for (size_t c = 0; c != fields.size(); ++c)
+    {
+        headers.emplace_back(has_header ? std::string(fields[c]) : "Col" + std::to_string(c));
+    }
+
+    threads = threads == 0 ? Utils::HardwareThreads() : threads;
+    const size_t chunks = std::max<size_t>(1, std::min(rows_text.size() >> 16, std::max(rows_text.size() >> 22, 4 * threads)));
+    const std::vector<size_t> bounds = detail::CSV::ChunkBounds(rows_text, chunks);
+    std::vector<size_t> first_rows(bounds.size(), 0);
+    Utils::ParallelFor(
+        bounds.size() - 1,
+        [&](size_t k)
+        { first_rows[k + 1] = detail::CSV::CountRows(rows_text.substr(bounds[k], bounds[k + 1] - bounds[k])); },
+        threads);
+    for (size_t k = 1; k != first_rows.size(); ++k)
+    {
+        first_rows[k] += first_rows[k - 1];
+    }
+    const size_t rows = first_rows.back();
+    if (rows == 0)
+    {
+        return DataFrameType();
+    }
+
+    // Types of the leading rows, demoted later if needed
+    const size_t cols = headers.size();
+    std::vector<detail::CSV::MappedColumn> columns(cols);
+    const auto sampled = detail::CSV::InferColumnTypes(rows_text, separator, cols, sample_rows);
+    for (size_t c = 0; c != cols; ++c)
+    {
+        auto it = types.find(headers[c]);
+        columns[c].fixed = it != types.end();
+        columns[c].type = columns[c].fixed ? it->second : sampled[c];
+    }
+
+    std::vector<typename DataFrameType::column_type> values(cols);
+    std::vector<ColumnType> chunk_types((bounds.size() - 1) * cols);
+    while (true)
+    {
+        for (size_t c = 0; c != cols; ++c)
+        {
+            auto &column = columns[c];
+            if (!column.active)
+            {
+                continue;
+            }
+            switch (column.type)
+            {
+            case ColumnType::String:
+                column.strings = values[c].template emplace<std::vector<std::string>>(rows).data();
+                break;
+            case ColumnType::Integer:
+                column.integers = values[c].template emplace<std::vector<std::int64_t>>(rows).data();
+                break;
+            default:
+                column.reals = values[c].template emplace<std::vector<double>>(rows).data();
+                break;
+            }
+        }
+
+        Utils::ParallelFor(
+            bounds.size() - 1,
+            [&](size_t k)
+            {
+                const std::span<ColumnType> local(chunk_types.data() + k * cols, cols);
+                for (size_t c = 0; c != cols; ++c)
+                {
+                    local[c] = columns[c].type;
+                }
+                detail::CSV::ParseChunk(rows_text, bounds[k], bounds[k + 1], separator, first_rows[k], first_rows[k + 1], columns, local, headers);
+            },
+            threads);
+
+        // Demoted columns are parsed again, the others are complete
+        bool demoted = false;
+        for (size_t c = 0; c != cols; ++c)
+        {
+            ColumnType type = columns[c].type;
+            for (size_t k = 0; k + 1 < bounds.size(); ++k)
+            {
+                const ColumnType local = chunk_types[k * cols + c];
+                type = detail::CSV::Rank(local) < detail::CSV::Rank(type) ? local : type;
+            }
+            columns[c].active = type != columns[c].type;
+            columns[c].type = type;
+            demoted = demoted || columns[c].active;
+        }
+        if (!demoted)
+        {
+            break;
+        }
+    }
+
+    DataFrameType df(rows);
+    for (size_t c = 0; c != cols; ++c)
+    {
+        std::visit(
+            [&](auto &col)
+            { df.AddColumn(static_cast<__col_key_type>(headers[c]), std::move(col)); },
+            values[c]);
+    }
+    return df;
+}
+
 AGTB_IO_END
 
 #endif
\ No newline at end of file
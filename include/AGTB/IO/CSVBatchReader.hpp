@@ -0,0 +1,481 @@
+#ifndef __AGTB_IO_CSV_BATCH_READER_HPP__
+#define __AGTB_IO_CSV_BATCH_READER_HPP__
+
+#include "../details/Macros.hpp"
+#include "CSV.hpp"
+
+#include <array>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+AGTB_IO_BEGIN
+
+namespace detail::CSVBatchReader
+{
+    struct Options
+    {
+        std::string separator = ",";
+        bool has_header = true;
+        std::unordered_map<std::string, Container::ColumnType> types{};
+        /**
+         * @brief Read and parse the next batch on a background thread
+         *
+         */
+        bool prefetch = true;
+        /**
+         * @brief Threads parsing one batch, `0` means `Utils::HardwareThreads()`
+         *
+         */
+        size_t threads{0};
+        /**
+         * @brief Bytes per read from the file
+         *
+         */
+        size_t read_bytes = 1 << 20;
+    };
+}
+
+/**
+ * @brief Rows `[FirstRow(), FirstRow() + Rows())` of a file read by `CSVBatchReader`. Columns are typed spans into
+ * buffers of the reader, valid until the next batch is requested.
+ *
+ */
+class CSVBatch
+{
+public:
+    size_t Rows() const noexcept
+    {
+        return rows;
+    }
+
+    size_t Cols() const noexcept
+    {
+        return types.size();
+    }
+
+    /**
+     * @brief Position in the file (blank lines not counted) of the first row of this batch
+     *
+     */
+    size_t FirstRow() const noexcept
+    {
+        return first_row;
+    }
+
+    const std::vector<std::string> &ColKeys() const noexcept
+    {
+        return *keys;
+    }
+
+    size_t ColIndex(std::string_view key) const
+    {
+        auto it = std::ranges::find(*keys, key);
+        if (it == keys->end())
+        {
+            AGTB_THROW(std::out_of_range, std::format("{}{}", "Column key not found: ", key));
+        }
+        return std::distance(keys->begin(), it);
+    }
+
+    Container::ColumnType TypeOf(size_t col_idx) const
+    {
+        return types.at(col_idx);
+    }
+
+    Container::ColumnType TypeOf(std::string_view key) const
+    {
+        return TypeOf(ColIndex(key));
+    }
+
+    /**
+     * @brief Typed column, throws if the column holds another type
+     *
+     */
+    template <Container::detail::ColumnarDataFrame::ColumnValue T>
+    std::span<const T> Column(size_t col_idx) const
+    {
+        if (TypeOf(col_idx) != Container::detail::ColumnarDataFrame::ColumnTypeOf<T>())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Column {} holds {}, not {}", (*keys)[col_idx],
+                                                          Container::ToString(TypeOf(col_idx)),
+                                                          Container::ToString(Container::detail::ColumnarDataFrame::ColumnTypeOf<T>())));
+        }
+        return std::span<const T>(std::get<std::vector<T>>(columns[col_idx])).first(rows);
+    }
+
+    template <Container::detail::ColumnarDataFrame::ColumnValue T>
+    std::span<const T> Column(std::string_view key) const
+    {
+        return Column<T>(ColIndex(key));
+    }
+
+private:
+    friend class CSVBatchReader;
+
+    const std::vector<std::string> *keys = nullptr;
+    std::vector<Container::ColumnType> types{};
+    std::vector<Container::detail::ColumnarDataFrame::Column> columns{};
+    std::string text{};
+    size_t rows = 0;
+    size_t first_row = 0;
+};
+
+/**
+ * @brief Stream a Csv file in batches of at most `batch_rows` rows, so files larger than memory can be processed.
+ * Only one batch of text and two batches of columns are held, both reused from batch to batch. With `prefetch`
+ * the next batch is read and parsed on a background thread while the current one is processed.
+ *
+ * Fields are split and trimmed as in `ReadColumnarCSV`. Column types are inferred from the first batch unless
+ * given in `types`; numeric columns are inferred as `Real` (a later `100.5` may follow `100, 101`), `Integer` only
+ * when given. A later field that does not fit its column throws `std::invalid_argument`.
+ *
+ * ```
+ * IO::CSVBatchReader reader("points.csv", 1 << 16);
+ * for (const auto &batch : reader)
+ * {
+ *     projector::ProjectBatch<config>(batch.Column<double>("B"), batch.Column<double>("L"), x, y, zone);
+ * }
+ * ```
+ *
+ */
+class CSVBatchReader
+{
+public:
+    using Options = detail::CSVBatchReader::Options;
+
+    /**
+     * @brief Input iterator over the remaining batches, `begin()` advances the reader
+     *
+     */
+    class iterator
+    {
+    public:
+        using value_type = CSVBatch;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(CSVBatchReader *reader) : reader_(reader) {}
+
+        const CSVBatch &operator*() const
+        {
+            return reader_->Batch();
+        }
+
+        const CSVBatch *operator->() const
+        {
+            return &reader_->Batch();
+        }
+
+        iterator &operator++()
+        {
+            reader_ = reader_->Next() ? reader_ : nullptr;
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        friend bool operator==(const iterator &it, std::default_sentinel_t) noexcept
+        {
+            return it.reader_ == nullptr;
+        }
+
+    private:
+        CSVBatchReader *reader_ = nullptr;
+    };
+
+    CSVBatchReader(const std::string &fname, size_t batch_rows, Options options = {})
+        : file_(fname, std::ios_base::in | std::ios_base::binary), batch_rows_(batch_rows), options_(std::move(options))
+    {
+        if (!file_)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Cannot open file: {}", fname));
+        }
+        if (batch_rows_ == 0)
+        {
+            AGTB_THROW(std::invalid_argument, "Batch of 0 rows");
+        }
+
+        // First non-blank line is the header or fixes the number of columns
+        std::string &text = batches_[1].text;
+        std::vector<std::string_view> fields{};
+        if (__ReadRows(text, 1) == 1)
+        {
+            Utils::SplitDelimited(detail::CSV::Trim(text), options_.separator, fields);
+        }
+        for (size_t c = 0; c != fields.size(); ++c)
+        {
+            keys_.emplace_back(options_.has_header ? std::string(fields[c]) : "Col" + std::to_string(c));
+        }
+        if (!options_.has_header)
+        {
+            carry_.insert(0, text);
+        }
+
+        // Types of the first batch, fixed for the whole file. Integers seen so far may be followed by reals, so only
+        // `types` makes a column Integer
+        __ReadRows(text, batch_rows_);
+        const auto inferred = detail::CSV::InferColumnTypes(text, options_.separator, keys_.size(), batch_rows_);
+        columns_.resize(keys_.size());
+        for (size_t c = 0; c != keys_.size(); ++c)
+        {
+            auto it = options_.types.find(keys_[c]);
+            columns_[c].type = it != options_.types.end()                  ? it->second
+                               : inferred[c] == Container::ColumnType::Integer ? Container::ColumnType::Real
+                                                                               : inferred[c];
+            columns_[c].fixed = true;
+        }
+        for (auto &batch : batches_)
+        {
+            batch.keys = &keys_;
+            batch.types.resize(keys_.size());
+            batch.columns.resize(keys_.size());
+            for (size_t c = 0; c != keys_.size(); ++c)
+            {
+                batch.types[c] = columns_[c].type;
+                batch.columns[c] = __MakeColumn(columns_[c].type, batch_rows_);
+            }
+        }
+        carry_.insert(0, text);
+        __Fetch(1);
+    }
+
+    CSVBatchReader(const CSVBatchReader &) = delete;
+    CSVBatchReader &operator=(const CSVBatchReader &) = delete;
+
+    ~CSVBatchReader()
+    {
+        if (pending_.valid())
+        {
+            pending_.wait();
+        }
+    }
+
+    const std::vector<std::string> &ColKeys() const noexcept
+    {
+        return keys_;
+    }
+
+    Container::ColumnType TypeOf(size_t col_idx) const
+    {
+        return columns_.at(col_idx).type;
+    }
+
+    /**
+     * @brief Move to the next batch, the previous one is reused. `false` if the file is exhausted.
+     *
+     */
+    bool Next()
+    {
+        if (done_)
+        {
+            return false;
+        }
+        if (pending_.valid())
+        {
+            pending_.get();
+        }
+        current_ ^= 1;
+        if (batches_[current_].rows == 0)
+        {
+            done_ = true;
+            return false;
+        }
+        __Fetch(current_ ^ 1);
+        return true;
+    }
+
+    /**
+     * @brief Batch reached by the last `Next()`
+     *
+     */
+    const CSVBatch &Batch() const noexcept
+    {
+        return batches_[current_];
+    }
+
+    iterator begin()
+    {
+        return Next() ? iterator(this) : iterator();
+    }
+
+    std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+private:
+    static Container::detail::ColumnarDataFrame::Column __MakeColumn(Container::ColumnType type, size_t rows)
+    {
+        switch (type)
+        {
+        case Container::ColumnType::String:
+            return std::vector<std::string>(rows);
+        case Container::ColumnType::Integer:
+            return std::vector<std::int64_t>(rows);
+        default:
+            return std::vector<double>(rows);
+        }
+    }
+
+    /**
+     * @brief Replace `text` by the next `wanted` non-blank lines (blank lines in between kept), the rest of what was
+     * read stays in `carry_`
+     *
+     * @return number of non-blank lines, less than `wanted` at the end of the file
+     */
+    size_t __ReadRows(std::string &text, size_t wanted)
+    {
+        text.assign(carry_);
+        size_t rows = 0, scanned = 0;
+        while (true)
+        {
+            for (size_t newline; rows != wanted && (newline = text.find('\n', scanned)) != std::string::npos; scanned = newline + 1)
+            {
+                rows += detail::CSV::IsBlank(std::string_view(text).substr(scanned, newline - scanned)) ? 0 : 1;
+            }
+            if (rows == wanted)
+            {
+                break;
+            }
+            if (eof_)
+            {
+                rows += detail::CSV::IsBlank(std::string_view(text).substr(scanned)) ? 0 : 1;
+                scanned = text.size();
+                break;
+            }
+            const size_t old_size = text.size();
+            text.resize(old_size + options_.read_bytes);
+            file_.read(text.data() + old_size, options_.read_bytes);
+            text.resize(old_size + static_cast<size_t>(file_.gcount()));
+            eof_ = !file_;
+        }
+        carry_.assign(text, scanned);
+        text.resize(scanned);
+        return rows;
+    }
+
+    /**
+     * @brief Read and parse the next rows into `batches_[slot]`, on a background thread with `prefetch`
+     *
+     */
+    void __Fetch(size_t slot)
+    {
+        auto fetch = [this, slot]
+        { __Fill(batches_[slot]); };
+        if (options_.prefetch)
+        {
+            pending_ = std::async(std::launch::async, fetch);
+        }
+        else
+        {
+            fetch();
+        }
+    }
+
+    void __Fill(CSVBatch &batch)
+    {
+        batch.rows = __ReadRows(batch.text, batch_rows_);
+        batch.first_row = next_row_;
+        next_row_ += batch.rows;
+        if (batch.rows == 0)
+        {
+            return;
+        }
+
+        std::vector<detail::CSV::MappedColumn> columns = columns_;
+        for (size_t c = 0; c != columns.size(); ++c)
+        {
+            std::visit([&](auto &col)
+                       {
+                           using value_type = typename std::remove_cvref_t<decltype(col)>::value_type;
+                           if constexpr (std::same_as<value_type, std::string>)
+                           {
+                               columns[c].strings = col.data();
+                           }
+                           else if constexpr (std::same_as<value_type, std::int64_t>)
+                           {
+                               columns[c].integers = col.data();
+                           }
+                           else
+                           {
+                               columns[c].reals = col.data();
+                           }
+                       },
+                       batch.columns[c]);
+        }
+
+        const std::string_view text = batch.text;
+        const size_t threads = options_.threads == 0 ? Utils::HardwareThreads() : options_.threads;
+        const std::vector<size_t> bounds = detail::CSV::ChunkBounds(text, std::min(threads, std::max<size_t>(1, text.size() >> 16)));
+        std::vector<size_t> first_rows(bounds.size(), 0);
+        if (bounds.size() > 2)
+        {
+            Utils::ParallelFor(
+                bounds.size() - 2,
+                [&](size_t k)
+                { first_rows[k + 1] = detail::CSV::CountRows(text.substr(bounds[k], bounds[k + 1] - bounds[k])); },
+                threads);
+            for (size_t k = 1; k != first_rows.size(); ++k)
+            {
+                first_rows[k] += first_rows[k - 1];
+            }
+        }
+        first_rows.back() = batch.rows;
+
+        std::vector<Container::ColumnType> types((bounds.size() - 1) * columns.size());
+        Utils::ParallelFor(
+            bounds.size() - 1,
+            [&](size_t k)
+            {
+                const std::span<Container::ColumnType> local(types.data() + k * columns.size(), columns.size());
+                std::ranges::copy(batch.types, local.begin());
+                detail::CSV::ParseChunk(text, bounds[k], bounds[k + 1], options_.separator, first_rows[k], first_rows[k + 1], columns, local, keys_, batch.first_row);
+            },
+            threads);
+    }
+
+    std::ifstream file_;
+    size_t batch_rows_;
+    Options options_;
+    std::vector<std::string> keys_{};
+    std::vector<detail::CSV::MappedColumn> columns_{};
+    std::array<CSVBatch, 2> batches_{};
+    size_t current_ = 0;
+    std::string carry_{};
+    bool eof_ = false;
+    bool done_ = false;
+    size_t next_row_ = 0;
+    std::future<void> pending_{};
+};
+
+/**
+ * @brief Call `fn(const CSVBatch &)` for every batch of at most `batch_rows` rows of `fname`, see `CSVBatchReader`
+ *
+ * @tparam __fn
+ * @param fname
+ * @param batch_rows
+ * @param fn
+ * @param options
+ */
+template <typename __fn>
+void ForEachCSVBatch(const std::string &fname, size_t batch_rows, __fn &&fn, CSVBatchReader::Options options = {})
+{
+    CSVBatchReader reader(fname, batch_rows, std::move(options));
+    while (reader.Next())
+    {
+        fn(reader.Batch());
+    }
+}
+
+AGTB_IO_END
+
+#endif
@@ -0,0 +1,644 @@
+#ifndef __AGTB_IO_CSV_WRITER_HPP__
+#define __AGTB_IO_CSV_WRITER_HPP__
+
+#include "../details/Macros.hpp"
+#include "../Container/DataFrame.hpp"
+#include "../Container/ColumnarDataFrame.hpp"
+#include "../Utils/Parallel.hpp"
+
+#include <charconv>
+#include <concepts>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <Eigen/Dense>
+
+AGTB_IO_BEGIN
+
+namespace detail::CSVWriter
+{
+    struct Options
+    {
+        char separator = ',';
+        /**
+         * @brief Digits after the decimal point of reals, negative for shortest round-trip form
+         *
+         */
+        int precision = -1;
+        /**
+         * @brief Bytes formatted before one write to the file
+         *
+         */
+        size_t buffer_bytes = 1 << 22;
+        /**
+         * @brief Write full buffers on a background thread while the next ones are formatted
+         *
+         */
+        bool background = false;
+        /**
+         * @brief Threads formatting chunks of `chunk_rows` rows, `0` means `Utils::HardwareThreads()`, `1` formats
+         * straight into the output buffer
+         *
+         */
+        size_t threads{1};
+        size_t chunk_rows = 1 << 14;
+    };
+
+    /**
+     * @brief Growable text buffer on page aligned storage
+     *
+     */
+    class Text
+    {
+    public:
+        static constexpr std::align_val_t alignment{4096};
+
+        Text() = default;
+
+        explicit Text(size_t capacity)
+        {
+            Reserve(capacity);
+        }
+
+        Text(const Text &) = delete;
+        Text &operator=(const Text &) = delete;
+
+        Text(Text &&other) noexcept
+            : data_(std::exchange(other.data_, nullptr)),
+              size_(std::exchange(other.size_, 0)),
+              capacity_(std::exchange(other.capacity_, 0))
+        {
+        }
+
+        Text &operator=(Text &&other) noexcept
+        {
+            if (this != &other)
+            {
+                __Free();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+                capacity_ = std::exchange(other.capacity_, 0);
+            }
+            return *this;
+        }
+
+        ~Text()
+        {
+            __Free();
+        }
+
+        const char *Data() const noexcept
+        {
+            return data_;
+        }
+
+        size_t Size() const noexcept
+        {
+            return size_;
+        }
+
+        void Clear() noexcept
+        {
+            size_ = 0;
+        }
+
+        void Reserve(size_t capacity)
+        {
+            if (capacity <= capacity_)
+            {
+                return;
+            }
+            capacity = std::max(capacity, 2 * capacity_);
+            char *data = static_cast<char *>(::operator new[](capacity, alignment));
+            if (size_ != 0)
+            {
+                std::memcpy(data, data_, size_);
+            }
+            __Free();
+            data_ = data;
+            capacity_ = capacity;
+        }
+
+        /**
+         * @brief Room for at least `n` more chars, write there then `Commit` the end
+         *
+         */
+        char *Grow(size_t n)
+        {
+            Reserve(size_ + n);
+            return data_ + size_;
+        }
+
+        void Commit(char *end) noexcept
+        {
+            size_ = static_cast<size_t>(end - data_);
+        }
+
+        void Append(std::string_view text)
+        {
+            Commit(std::ranges::copy(text, Grow(text.size())).out);
+        }
+
+        void Push(char c)
+        {
+            *Grow(1) = c;
+            ++size_;
+        }
+
+    private:
+        void __Free() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::operator delete[](data_, alignment);
+            }
+            data_ = nullptr;
+        }
+
+        char *data_ = nullptr;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+    };
+
+    /**
+     * @brief Longest numeric field besides fixed decimals, shortest form of a double is at most 24 chars but the
+     * integer part of 1e308 in fixed form has 309 digits
+     *
+     */
+    constexpr size_t max_number_chars = 384;
+
+    template <typename T>
+    concept TextLike = std::convertible_to<const T &, std::string_view>;
+
+    /**
+     * @brief Text or a number `std::to_chars` formats, `bool` is excluded as its overload is deleted
+     *
+     */
+    template <typename T>
+    concept Cell = TextLike<T> || (std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>;
+
+    template <typename T>
+    void AppendCell(Text &out, const T &value, int precision)
+    {
+        if constexpr (TextLike<T>)
+        {
+            out.Append(std::string_view(value));
+        }
+        else
+        {
+            // Fixed form needs the integer digits (up to 309) plus `precision` decimals
+            const size_t room = max_number_chars + static_cast<size_t>(std::max(precision, 0));
+            char *begin = out.Grow(room);
+            std::to_chars_result result{};
+            if constexpr (std::floating_point<T>)
+            {
+                result = precision < 0 ? std::to_chars(begin, begin + room, value)
+                                       : std::to_chars(begin, begin + room, value, std::chars_format::fixed, precision);
+            }
+            else
+            {
+                result = std::to_chars(begin, begin + room, value);
+            }
+            if (result.ec != std::errc{})
+            {
+                AGTB_THROW(std::runtime_error, std::format("Cannot format {} with precision {}", value, precision));
+            }
+            out.Commit(result.ptr);
+        }
+    }
+}
+
+/**
+ * @brief Buffered Csv writer for results. Numbers are formatted by `std::to_chars` (shortest round-trip form or
+ * fixed `precision`) into large page aligned buffers written to the file when full. With `background` the
+ * writes happen on another thread; with `threads != 1` chunks of rows are formatted concurrently and written in
+ * order, so output is the same in every mode. Fields are not quoted, as `ReadCSV` does not unquote.
+ *
+ * ```
+ * IO::CSVWriter out("projected.csv", {.precision = 4, .background = true});
+ * out.WriteHeader({"x", "y", "zone"});
+ * out.WriteColumns(x, y, zone);   // spans, vectors, Eigen vectors of numbers or strings
+ * out.Close();
+ * ```
+ *
+ */
+class CSVWriter
+{
+public:
+    using Options = detail::CSVWriter::Options;
+
+    explicit CSVWriter(const std::string &path, Options options = {})
+        : options_(options), path_(path)
+    {
+        file_.rdbuf()->pubsetbuf(nullptr, 0);
+        file_.open(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!file_)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Cannot open file: {}", path));
+        }
+        options_.buffer_bytes = std::max<size_t>(options_.buffer_bytes, 1 << 12);
+        options_.chunk_rows = std::max<size_t>(options_.chunk_rows, 1);
+        options_.threads = options_.threads == 0 ? Utils::HardwareThreads() : options_.threads;
+        buffer_.Reserve(options_.buffer_bytes + detail::CSVWriter::max_number_chars);
+        if (options_.background)
+        {
+            for (int i = 0; i != 2; ++i)
+            {
+                free_.emplace_back(options_.buffer_bytes + detail::CSVWriter::max_number_chars);
+            }
+            writer_ = std::jthread([this]
+                                   { __WriterLoop(); });
+        }
+    }
+
+    CSVWriter(const CSVWriter &) = delete;
+    CSVWriter &operator=(const CSVWriter &) = delete;
+
+    /**
+     * @brief Flushes what is left, errors are only reported by an explicit `Close()`
+     *
+     */
+    ~CSVWriter()
+    {
+        try
+        {
+            Close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    template <std::ranges::input_range __keys>
+    void WriteHeader(const __keys &keys)
+    {
+        bool first = true;
+        for (const auto &key : keys)
+        {
+            if (!first)
+            {
+                buffer_.Push(options_.separator);
+            }
+            detail::CSVWriter::AppendCell(buffer_, key, options_.precision);
+            first = false;
+        }
+        buffer_.Push('\n');
+        __FlushIfFull();
+    }
+
+    void WriteHeader(std::initializer_list<std::string_view> keys)
+    {
+        WriteHeader<std::initializer_list<std::string_view>>(keys);
+    }
+
+    /**
+     * @brief Write rows `i` of every column, columns are random access ranges of numbers or strings of the same size
+     *
+     */
+    template <std::ranges::random_access_range... __columns>
+        requires(sizeof...(__columns) > 0 && (detail::CSVWriter::Cell<std::ranges::range_value_t<__columns>> && ...))
+    void WriteColumns(const __columns &...columns)
+    {
+        const size_t sizes[] = {static_cast<size_t>(std::ranges::size(columns))...};
+        if (std::ranges::any_of(sizes, [&](size_t n)
+                                { return n != sizes[0]; }))
+        {
+            AGTB_THROW(std::invalid_argument, "Columns of different sizes");
+        }
+        __WriteRows(sizes[0], [&](detail::CSVWriter::Text &out, size_t r)
+                    {
+                        size_t c = 0;
+                        ((detail::CSVWriter::AppendCell(out, std::ranges::begin(columns)[r], options_.precision),
+                          out.Push(++c != sizeof...(__columns) ? options_.separator : '\n')),
+                         ...); });
+    }
+
+    /**
+     * @brief Write rows of `matrix`, without header
+     *
+     */
+    template <typename __derived>
+        requires detail::CSVWriter::Cell<typename __derived::Scalar>
+    void WriteMatrix(const Eigen::DenseBase<__derived> &matrix)
+    {
+        const auto &m = matrix.derived();
+        const Eigen::Index cols = m.cols();
+        __WriteRows(static_cast<size_t>(m.rows()), [&](detail::CSVWriter::Text &out, size_t r)
+                    {
+                        for (Eigen::Index c = 0; c != cols; ++c)
+                        {
+                            detail::CSVWriter::AppendCell(out, m(static_cast<Eigen::Index>(r), c), options_.precision);
+                            out.Push(c + 1 != cols ? options_.separator : '\n');
+                        } });
+    }
+
+    /**
+     * @brief Header line then every row of `df`, with row keys as the first column if `row_keys`
+     *
+     */
+    template <typename __row_key_type, typename __col_key_type>
+    void WriteFrame(const Container::ColumnarDataFrame<__row_key_type, __col_key_type> &df, bool row_keys = false)
+    {
+        using Container::ColumnType;
+        if (row_keys)
+        {
+            buffer_.Push(options_.separator);
+        }
+        WriteHeader(df.ColKeys());
+
+        struct Column
+        {
+            ColumnType type;
+            const std::string *strings;
+            const std::int64_t *integers;
+            const double *reals;
+        };
+        std::vector<Column> columns(df.Cols());
+        for (size_t c = 0; c != df.Cols(); ++c)
+        {
+            columns[c].type = df.TypeOf(c);
+            switch (columns[c].type)
+            {
+            case ColumnType::String:
+                columns[c].strings = df.template ILoc<std::string>(c).data();
+                break;
+            case ColumnType::Integer:
+                columns[c].integers = df.template ILoc<std::int64_t>(c).data();
+                break;
+            default:
+                columns[c].reals = df.template ILoc<double>(c).data();
+                break;
+            }
+        }
+
+        __WriteRows(df.Rows(), [&](detail::CSVWriter::Text &out, size_t r)
+                    {
+                        if (row_keys)
+                        {
+                            detail::CSVWriter::AppendCell(out, df.RowKeys(r), options_.precision);
+                            out.Push(columns.empty() ? '\n' : options_.separator);
+                        }
+                        for (size_t c = 0; c != columns.size(); ++c)
+                        {
+                            switch (columns[c].type)
+                            {
+                            case ColumnType::String:
+                                detail::CSVWriter::AppendCell(out, columns[c].strings[r], options_.precision);
+                                break;
+                            case ColumnType::Integer:
+                                detail::CSVWriter::AppendCell(out, columns[c].integers[r], options_.precision);
+                                break;
+                            default:
+                                detail::CSVWriter::AppendCell(out, columns[c].reals[r], options_.precision);
+                                break;
+                            }
+                            out.Push(c + 1 != columns.size() ? options_.separator : '\n');
+                        } });
+    }
+
+    /**
+     * @brief Header line then every row of `df`, with row keys as the first column if `row_keys`
+     *
+     */
+    template <typename __value_type, typename __row_key_type, typename __col_key_type>
+        requires detail::CSVWriter::Cell<__value_type>
+    void WriteFrame(const Container::DataFrame<__value_type, __row_key_type, __col_key_type> &df, bool row_keys = false)
+    {
+        if (row_keys)
+        {
+            buffer_.Push(options_.separator);
+        }
+        std::vector<__col_key_type> keys(df.Cols());
+        for (size_t c = 0; c != df.Cols(); ++c)
+        {
+            keys[c] = df.ColKeys(c);
+        }
+        WriteHeader(keys);
+
+        const size_t cols = df.Cols();
+        __WriteRows(df.Rows(), [&](detail::CSVWriter::Text &out, size_t r)
+                    {
+                        if (row_keys)
+                        {
+                            detail::CSVWriter::AppendCell(out, df.RowKeys(r), options_.precision);
+                            out.Push(cols == 0 ? '\n' : options_.separator);
+                        }
+                        for (size_t c = 0; c != cols; ++c)
+                        {
+                            detail::CSVWriter::AppendCell(out, df.ILoc(r, c), options_.precision);
+                            out.Push(c + 1 != cols ? options_.separator : '\n');
+                        } });
+    }
+
+    /**
+     * @brief Hand buffered text to the file (or the background writer)
+     *
+     */
+    void Flush()
+    {
+        if (buffer_.Size() == 0)
+        {
+            return;
+        }
+        if (!options_.background)
+        {
+            __Write(buffer_);
+            buffer_.Clear();
+            return;
+        }
+
+        std::unique_lock lock(mutex_);
+        free_cv_.wait(lock, [this]
+                      { return !free_.empty() || error_; });
+        __RethrowLocked();
+        full_.push_back(std::move(buffer_));
+        buffer_ = std::move(free_.back());
+        free_.pop_back();
+        buffer_.Clear();
+        full_cv_.notify_one();
+    }
+
+    /**
+     * @brief Flush, wait for the background writer and close the file. Throws if any write failed.
+     *
+     */
+    void Close()
+    {
+        if (closed_)
+        {
+            return;
+        }
+        closed_ = true;
+        std::exception_ptr error{};
+        try
+        {
+            Flush();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        if (writer_.joinable())
+        {
+            {
+                std::lock_guard lock(mutex_);
+                stop_ = true;
+            }
+            full_cv_.notify_one();
+            writer_.join();
+            error = error ? error : error_;
+        }
+        file_.close();
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        if (!file_)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Cannot write file: {}", path_));
+        }
+    }
+
+private:
+    /**
+     * @brief Format `rows` rows by `row(out, r)`. Chunks are formatted concurrently when `threads > 1`, then
+     * appended in order; at most `2 * threads` chunks are held at once.
+     *
+     */
+    template <typename __row>
+    void __WriteRows(size_t rows, __row &&row)
+    {
+        if (options_.threads == 1 || rows <= options_.chunk_rows)
+        {
+            for (size_t r = 0; r != rows; ++r)
+            {
+                row(buffer_, r);
+                __FlushIfFull();
+            }
+            return;
+        }
+
+        const size_t chunks = (rows + options_.chunk_rows - 1) / options_.chunk_rows, window = 2 * options_.threads;
+        chunk_texts_.resize(std::max(chunk_texts_.size(), window));
+        for (size_t first = 0; first < chunks; first += window)
+        {
+            const size_t n = std::min(window, chunks - first);
+            Utils::ParallelFor(
+                n,
+                [&](size_t k)
+                {
+                    auto &out = chunk_texts_[k];
+                    out.Clear();
+                    const size_t begin = (first + k) * options_.chunk_rows, end = std::min(rows, begin + options_.chunk_rows);
+                    for (size_t r = begin; r != end; ++r)
+                    {
+                        row(out, r);
+                    }
+                },
+                options_.threads);
+            for (size_t k = 0; k != n; ++k)
+            {
+                buffer_.Append(std::string_view(chunk_texts_[k].Data(), chunk_texts_[k].Size()));
+                __FlushIfFull();
+            }
+        }
+    }
+
+    void __FlushIfFull()
+    {
+        if (buffer_.Size() >= options_.buffer_bytes)
+        {
+            Flush();
+        }
+    }
+
+    void __Write(const detail::CSVWriter::Text &text)
+    {
+        file_.write(text.Data(), static_cast<std::streamsize>(text.Size()));
+        if (!file_)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Cannot write file: {}", path_));
+        }
+    }
+
+    void __WriterLoop()
+    {
+        std::unique_lock lock(mutex_);
+        while (true)
+        {
+            full_cv_.wait(lock, [this]
+                          { return !full_.empty() || stop_; });
+            if (full_.empty())
+            {
+                return;
+            }
+            detail::CSVWriter::Text text = std::move(full_.front());
+            full_.pop_front();
+            lock.unlock();
+            try
+            {
+                if (!error_)
+                {
+                    __Write(text);
+                }
+            }
+            catch (...)
+            {
+                lock.lock();
+                error_ = std::current_exception();
+                lock.unlock();
+            }
+            lock.lock();
+            free_.push_back(std::move(text));
+            free_cv_.notify_one();
+        }
+    }
+
+    void __RethrowLocked()
+    {
+        if (error_)
+        {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    Options options_;
+    std::string path_;
+    std::ofstream file_{};
+    detail::CSVWriter::Text buffer_{};
+    std::vector<detail::CSVWriter::Text> chunk_texts_{};
+    bool closed_ = false;
+
+    std::mutex mutex_{};
+    std::condition_variable full_cv_{}, free_cv_{};
+    std::deque<detail::CSVWriter::Text> full_{};
+    std::vector<detail::CSVWriter::Text> free_{};
+    bool stop_ = false;
+    std::exception_ptr error_{};
+    std::jthread writer_{};
+};
+
+/**
+ * @brief Write `df` to a Csv file by `CSVWriter`, with a header line
+ *
+ */
+template <typename __frame>
+void WriteCSV(const __frame &df, const std::string &path, CSVWriter::Options options = {}, bool row_keys = false)
+{
+    CSVWriter out(path, options);
+    out.WriteFrame(df, row_keys);
+    out.Close();
+}
+
+AGTB_IO_END
+
+#endif
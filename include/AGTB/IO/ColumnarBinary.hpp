@@ -0,0 +1,654 @@
+#ifndef __AGTB_IO_COLUMNAR_BINARY_HPP__
+#define __AGTB_IO_COLUMNAR_BINARY_HPP__
+
+#include "../details/Macros.hpp"
+#include "../Container/ColumnarDataFrame.hpp"
+#include "../Utils/MappedFile.hpp"
+#include "CSV.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+AGTB_IO_BEGIN
+
+namespace detail::ColumnarBinary
+{
+    /**
+     * @brief File layout, native byte order, every section aligned to `alignment` bytes:
+     *
+     * `FileHeader`, `ColumnHeader` x cols (+1 for row keys if not positional), column names, then per column its
+     * data (`double` / `int64` per row, or `uint32` dictionary codes per row for strings) and for strings the
+     * dictionary: `dict_size + 1` `uint64` offsets into the dictionary text.
+     *
+     */
+    inline constexpr char magic[8] = {'A', 'G', 'T', 'B', 'C', 'O', 'L', '1'};
+    inline constexpr std::uint32_t version = 1;
+    inline constexpr std::uint32_t byte_order = 0x01020304;
+    inline constexpr std::uint64_t alignment = 64;
+
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t has_row_keys;
+    };
+
+    struct ColumnHeader
+    {
+        std::uint32_t type;
+        std::uint32_t name_length;
+        std::uint64_t name_offset;
+        std::uint64_t data_offset;
+        std::uint64_t dict_size;
+        std::uint64_t dict_offset;
+        std::uint64_t dict_data_offset;
+    };
+
+    static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) == 40);
+    static_assert(std::is_trivially_copyable_v<ColumnHeader> && sizeof(ColumnHeader) == 48);
+
+    /**
+     * @brief Strings as first-appearance dictionary and one code per row
+     *
+     */
+    struct Dictionary
+    {
+        std::vector<std::uint32_t> codes;
+        std::vector<std::uint64_t> offsets{0};
+        std::string text;
+
+        explicit Dictionary(const std::vector<std::string> &values)
+        {
+            std::unordered_map<std::string_view, std::uint32_t> ids{};
+            codes.reserve(values.size());
+            for (const auto &v : values)
+            {
+                auto [it, inserted] = ids.try_emplace(v, static_cast<std::uint32_t>(offsets.size() - 1));
+                if (inserted)
+                {
+                    text.append(v);
+                    offsets.emplace_back(text.size());
+                }
+                codes.emplace_back(it->second);
+            }
+        }
+    };
+
+    class Writer
+    {
+    public:
+        explicit Writer(const std::string &path)
+            : os_(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc), path_(path)
+        {
+            if (!os_)
+            {
+                AGTB_THROW(std::runtime_error, std::format("Cannot open file: {}", path));
+            }
+        }
+
+        std::uint64_t Write(const void *data, size_t bytes)
+        {
+            const std::uint64_t at = pos_;
+            os_.write(static_cast<const char *>(data), bytes);
+            pos_ += bytes;
+            return at;
+        }
+
+        std::uint64_t Align()
+        {
+            static constexpr char zeros[alignment]{};
+            Write(zeros, (alignment - pos_ % alignment) % alignment);
+            return pos_;
+        }
+
+        template <typename T>
+        std::uint64_t WriteVector(const std::vector<T> &values)
+        {
+            const std::uint64_t at = Align();
+            Write(values.data(), values.size() * sizeof(T));
+            return at;
+        }
+
+        void WriteAt(std::uint64_t at, const void *data, size_t bytes)
+        {
+            os_.seekp(at);
+            os_.write(static_cast<const char *>(data), bytes);
+            os_.seekp(pos_);
+        }
+
+        void Close()
+        {
+            os_.close();
+            if (!os_)
+            {
+                AGTB_THROW(std::runtime_error, std::format("Cannot write file: {}", path_));
+            }
+        }
+
+    private:
+        std::ofstream os_;
+        std::string path_;
+        std::uint64_t pos_ = 0;
+    };
+
+    /**
+     * @brief Csv fields are not quoted (`ReadCSV` does not unquote), so a field may not hold the separator or a
+     * line break
+     *
+     */
+    inline void CheckCsvField(std::string_view field, char separator, const std::string &csv_path)
+    {
+        if (field.find(separator) != std::string_view::npos || field.find_first_of("\r\n") != std::string_view::npos)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Field `{}` holds the separator or a line break, cannot write it unquoted to {}", field, csv_path));
+        }
+    }
+
+    inline bool PositionalKeys(const std::vector<std::string> &keys)
+    {
+        for (size_t r = 0; r != keys.size(); ++r)
+        {
+            if (keys[r] != std::to_string(r))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Write a `ColumnarDataFrame` in the binary columnar format read by `MappedDataFrame`. String columns (and
+ * row keys unless they are positions) are dictionary encoded.
+ *
+ * @param df
+ * @param path
+ */
+inline void WriteColumnarBinary(const Container::ColumnarDataFrame<> &df, const std::string &path)
+{
+    using namespace detail::ColumnarBinary;
+    using Container::ColumnType;
+
+    const bool has_row_keys = !PositionalKeys(df.RowKeys());
+    const size_t entries = df.Cols() + has_row_keys;
+
+    Writer out(path);
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.byte_order = byte_order;
+    header.rows = df.Rows();
+    header.cols = df.Cols();
+    header.has_row_keys = has_row_keys;
+    out.Write(&header, sizeof(header));
+
+    std::vector<ColumnHeader> columns(entries);
+    const std::uint64_t table = out.Write(columns.data(), entries * sizeof(ColumnHeader));
+    for (size_t c = 0; c != entries; ++c)
+    {
+        const std::string_view name = c != df.Cols() ? std::string_view(df.ColKeys(c)) : std::string_view{};
+        columns[c].name_length = static_cast<std::uint32_t>(name.size());
+        columns[c].name_offset = out.Write(name.data(), name.size());
+    }
+
+    auto write_strings = [&](ColumnHeader &ch, const std::vector<std::string> &values)
+    {
+        const Dictionary dict(values);
+        ch.type = static_cast<std::uint32_t>(ColumnType::String);
+        ch.data_offset = out.WriteVector(dict.codes);
+        ch.dict_size = dict.offsets.size() - 1;
+        ch.dict_offset = out.WriteVector(dict.offsets);
+        ch.dict_data_offset = out.Align();
+        out.Write(dict.text.data(), dict.text.size());
+    };
+
+    for (size_t c = 0; c != df.Cols(); ++c)
+    {
+        switch (df.TypeOf(c))
+        {
+        case ColumnType::String:
+            write_strings(columns[c], df.ILoc<std::string>(c));
+            break;
+        case ColumnType::Integer:
+            columns[c].type = static_cast<std::uint32_t>(ColumnType::Integer);
+            columns[c].data_offset = out.WriteVector(df.ILoc<std::int64_t>(c));
+            break;
+        default:
+            columns[c].type = static_cast<std::uint32_t>(ColumnType::Real);
+            columns[c].data_offset = out.WriteVector(df.ILoc<double>(c));
+            break;
+        }
+    }
+    if (has_row_keys)
+    {
+        write_strings(columns.back(), df.RowKeys());
+    }
+
+    out.WriteAt(table, columns.data(), entries * sizeof(ColumnHeader));
+    out.Close();
+}
+
+/**
+ * @brief Read-only view of a binary columnar file through `mmap`. Opening only reads the headers, column data is
+ * paged in on first touch, numeric columns are `Eigen::Map`s straight into the mapping.
+ *
+ */
+class MappedDataFrame
+{
+public:
+    template <typename T>
+    using const_numeric_series_of = Eigen::Map<const Eigen::Vector<T, Eigen::Dynamic>>;
+
+    /**
+     * @brief Dictionary encoded string column
+     *
+     */
+    class StringColumn
+    {
+    public:
+        StringColumn(const std::uint32_t *codes, const std::uint64_t *offsets, const char *text, size_t rows, size_t dict_size, size_t text_size)
+            : codes_(codes), offsets_(offsets), text_(text), rows_(rows), dict_size_(dict_size), text_size_(text_size)
+        {
+        }
+
+        size_t Size() const noexcept
+        {
+            return rows_;
+        }
+
+        size_t DictionarySize() const noexcept
+        {
+            return dict_size_;
+        }
+
+        std::uint32_t Code(size_t row) const
+        {
+            if (row >= rows_)
+            {
+                AGTB_THROW(std::out_of_range, std::format("Row {} out of range", row));
+            }
+            return codes_[row];
+        }
+
+        std::string_view Dictionary(std::uint32_t code) const
+        {
+            if (code >= dict_size_ || offsets_[code] > offsets_[code + 1] || offsets_[code + 1] > text_size_)
+            {
+                AGTB_THROW(std::runtime_error, std::format("Corrupt dictionary entry {}", code));
+            }
+            return std::string_view(text_ + offsets_[code], offsets_[code + 1] - offsets_[code]);
+        }
+
+        std::string_view operator[](size_t row) const
+        {
+            return Dictionary(Code(row));
+        }
+
+    private:
+        const std::uint32_t *codes_;
+        const std::uint64_t *offsets_;
+        const char *text_;
+        size_t rows_, dict_size_, text_size_;
+    };
+
+    explicit MappedDataFrame(const std::string &path)
+        : file_(path), path_(path)
+    {
+        using namespace detail::ColumnarBinary;
+
+        if (file_.Size() < sizeof(FileHeader))
+        {
+            AGTB_THROW(std::runtime_error, std::format("Not a columnar binary file: {}", path));
+        }
+        std::memcpy(&header_, file_.Data(), sizeof(FileHeader));
+        if (std::memcmp(header_.magic, magic, sizeof(magic)) != 0 || header_.version != version)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Not a columnar binary file of version {}: {}", version, path));
+        }
+        if (header_.byte_order != byte_order)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Byte order of {} does not match this machine", path));
+        }
+
+        Check(sizeof(FileHeader), header_.cols, sizeof(ColumnHeader));
+        const size_t entries = header_.cols + (header_.has_row_keys != 0);
+        Check(sizeof(FileHeader), entries, sizeof(ColumnHeader));
+        columns_.resize(entries);
+        std::memcpy(columns_.data(), file_.Data() + sizeof(FileHeader), entries * sizeof(ColumnHeader));
+
+        col_keys_.reserve(header_.cols);
+        for (size_t c = 0; c != entries; ++c)
+        {
+            const auto &ch = columns_[c];
+            if (ch.type > static_cast<std::uint32_t>(Container::ColumnType::Real))
+            {
+                AGTB_THROW(std::runtime_error, std::format("Unknown type {} of column {} in {}", ch.type, c, path));
+            }
+            Check(ch.name_offset, ch.name_length);
+            const auto type = static_cast<Container::ColumnType>(ch.type);
+            const size_t element = type == Container::ColumnType::String ? sizeof(std::uint32_t) : sizeof(double);
+            Check(ch.data_offset, header_.rows, element);
+            CheckAligned(ch.data_offset, element);
+            if (type == Container::ColumnType::String)
+            {
+                Check(ch.dict_offset, ch.dict_size, sizeof(std::uint64_t));
+                CheckAligned(ch.dict_offset, sizeof(std::uint64_t));
+                Check(ch.dict_offset + ch.dict_size * sizeof(std::uint64_t), sizeof(std::uint64_t));
+                Check(ch.dict_data_offset, 0);
+            }
+            if (c != header_.cols)
+            {
+                col_keys_.emplace_back(file_.Data() + ch.name_offset, ch.name_length);
+            }
+        }
+    }
+
+    size_t Rows() const noexcept
+    {
+        return header_.rows;
+    }
+
+    size_t Cols() const noexcept
+    {
+        return header_.cols;
+    }
+
+    const std::vector<std::string_view> &ColKeys() const noexcept
+    {
+        return col_keys_;
+    }
+
+    std::string_view ColKeys(size_t idx) const
+    {
+        return col_keys_.at(idx);
+    }
+
+    size_t ColIndex(std::string_view ck) const
+    {
+        auto it = std::ranges::find(col_keys_, ck);
+        if (it == col_keys_.end())
+        {
+            AGTB_THROW(std::out_of_range, std::format("{}{}", "Column key not found: ", ck));
+        }
+        return std::distance(col_keys_.begin(), it);
+    }
+
+    Container::ColumnType TypeOf(size_t col_idx) const
+    {
+        return static_cast<Container::ColumnType>(__Header(col_idx).type);
+    }
+
+    Container::ColumnType TypeOf(std::string_view ck) const
+    {
+        return TypeOf(ColIndex(ck));
+    }
+
+    /**
+     * @brief Zero-copy map of a numeric column, `T` must be the stored type
+     *
+     */
+    template <Container::detail::ColumnarDataFrame::NumericColumnValue T>
+    const_numeric_series_of<T> NumericSeries(size_t col_idx) const
+    {
+        constexpr auto type = Container::detail::ColumnarDataFrame::ColumnTypeOf<T>();
+        if (TypeOf(col_idx) != type)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Column {} holds {}, not {}", col_keys_[col_idx], Container::ToString(TypeOf(col_idx)), Container::ToString(type)));
+        }
+        return const_numeric_series_of<T>(reinterpret_cast<const T *>(file_.Data() + columns_[col_idx].data_offset), Rows());
+    }
+
+    template <Container::detail::ColumnarDataFrame::NumericColumnValue T>
+    const_numeric_series_of<T> NumericSeries(std::string_view ck) const
+    {
+        return NumericSeries<T>(ColIndex(ck));
+    }
+
+    StringColumn Strings(size_t col_idx) const
+    {
+        if (TypeOf(col_idx) != Container::ColumnType::String)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Column {} holds {}, not string", col_keys_[col_idx], Container::ToString(TypeOf(col_idx))));
+        }
+        return __Strings(columns_[col_idx]);
+    }
+
+    StringColumn Strings(std::string_view ck) const
+    {
+        return Strings(ColIndex(ck));
+    }
+
+    std::string RowKeys(size_t row_idx) const
+    {
+        if (header_.has_row_keys == 0)
+        {
+            return std::to_string(row_idx);
+        }
+        return std::string(__Strings(columns_.back())[row_idx]);
+    }
+
+    std::string Cell(size_t row_idx, size_t col_idx) const
+    {
+        switch (TypeOf(col_idx))
+        {
+        case Container::ColumnType::String:
+            return std::string(Strings(col_idx)[row_idx]);
+        case Container::ColumnType::Integer:
+            return std::format("{}", NumericSeries<std::int64_t>(col_idx)(row_idx));
+        default:
+            return std::format("{}", NumericSeries<double>(col_idx)(row_idx));
+        }
+    }
+
+    /**
+     * @brief Copy everything into a `ColumnarDataFrame`
+     *
+     * @return Container::ColumnarDataFrame<>
+     */
+    Container::ColumnarDataFrame<> Load() const
+    {
+        Container::ColumnarDataFrame<> df(Rows());
+        for (size_t c = 0; c != Cols(); ++c)
+        {
+            const std::string key(col_keys_[c]);
+            switch (TypeOf(c))
+            {
+            case Container::ColumnType::String:
+            {
+                const auto col = Strings(c);
+                std::vector<std::string> values(Rows());
+                for (size_t r = 0; r != Rows(); ++r)
+                {
+                    values[r] = col[r];
+                }
+                df.AddColumn(key, std::move(values));
+                break;
+            }
+            case Container::ColumnType::Integer:
+            {
+                const auto col = NumericSeries<std::int64_t>(c);
+                df.AddColumn(key, std::vector<std::int64_t>(col.data(), col.data() + col.size()));
+                break;
+            }
+            default:
+            {
+                const auto col = NumericSeries<double>(c);
+                df.AddColumn(key, std::vector<double>(col.data(), col.data() + col.size()));
+                break;
+            }
+            }
+        }
+        if (header_.has_row_keys != 0)
+        {
+            for (size_t r = 0; r != Rows(); ++r)
+            {
+                df.RowKeys(r) = RowKeys(r);
+            }
+        }
+        return df;
+    }
+
+    const Utils::MappedFile &File() const noexcept
+    {
+        return file_;
+    }
+
+private:
+    void Check(std::uint64_t offset, std::uint64_t bytes) const
+    {
+        if (offset > file_.Size() || bytes > file_.Size() - offset)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Truncated or corrupt file: {}", path_));
+        }
+    }
+
+    /**
+     * @brief `count` elements of `size` bytes at `offset` lie in the file, checked without multiplying first so
+     * corrupt counts cannot overflow
+     *
+     */
+    void Check(std::uint64_t offset, std::uint64_t count, std::uint64_t size) const
+    {
+        if (offset > file_.Size() || count > (file_.Size() - offset) / size)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Truncated or corrupt file: {}", path_));
+        }
+    }
+
+    /**
+     * @brief Sections are read in place through typed pointers, the mapping starts on a page
+     *
+     */
+    void CheckAligned(std::uint64_t offset, std::uint64_t size) const
+    {
+        if (offset % size != 0)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Misaligned section at {} in {}", offset, path_));
+        }
+    }
+
+    const detail::ColumnarBinary::ColumnHeader &__Header(size_t col_idx) const
+    {
+        if (col_idx >= Cols())
+        {
+            AGTB_THROW(std::out_of_range, std::format("Column index {} out of range", col_idx));
+        }
+        return columns_[col_idx];
+    }
+
+    StringColumn __Strings(const detail::ColumnarBinary::ColumnHeader &ch) const
+    {
+        return StringColumn(
+            reinterpret_cast<const std::uint32_t *>(file_.Data() + ch.data_offset),
+            reinterpret_cast<const std::uint64_t *>(file_.Data() + ch.dict_offset),
+            file_.Data() + ch.dict_data_offset,
+            Rows(), ch.dict_size, file_.Size() - ch.dict_data_offset);
+    }
+
+    Utils::MappedFile file_;
+    std::string path_;
+    detail::ColumnarBinary::FileHeader header_{};
+    std::vector<detail::ColumnarBinary::ColumnHeader> columns_{};
+    std::vector<std::string_view> col_keys_{};
+};
+
+/**
+ * @brief Convert a Csv file to the binary columnar format, see `ReadColumnarCSV` for parsing and `types`
+ *
+ */
+inline void CSVToColumnarBinary(
+    const std::string &csv_path,
+    const std::string &binary_path,
+    std::string separator = ",",
+    bool has_header = true,
+    const std::unordered_map<std::string, Container::ColumnType> &types = {})
+{
+    WriteColumnarBinary(ReadColumnarCSV(csv_path, std::move(separator), has_header, types), binary_path);
+}
+
+/**
+ * @brief Convert a binary columnar file back to Csv with a header line, reals in shortest round-trip form. Column
+ * names and strings holding `separator` or a line break are rejected before anything is written, as fields are
+ * not quoted.
+ *
+ */
+inline void ColumnarBinaryToCSV(const std::string &binary_path, const std::string &csv_path, char separator = ',')
+{
+    using detail::ColumnarBinary::CheckCsvField;
+
+    const MappedDataFrame df(binary_path);
+    std::vector<MappedDataFrame::StringColumn> strings{};
+    for (size_t c = 0; c != df.Cols(); ++c)
+    {
+        CheckCsvField(df.ColKeys(c), separator, csv_path);
+        if (df.TypeOf(c) == Container::ColumnType::String)
+        {
+            const auto &col = strings.emplace_back(df.Strings(c));
+            for (std::uint32_t code = 0; code != col.DictionarySize(); ++code)
+            {
+                CheckCsvField(col.Dictionary(code), separator, csv_path);
+            }
+        }
+    }
+
+    std::ofstream os(csv_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!os)
+    {
+        AGTB_THROW(std::runtime_error, std::format("Cannot open file: {}", csv_path));
+    }
+
+    std::string buffer{};
+    for (size_t c = 0; c != df.Cols(); ++c)
+    {
+        buffer.append(df.ColKeys(c));
+        buffer.push_back(c + 1 != df.Cols() ? separator : '\n');
+    }
+
+    char number[32];
+    for (size_t r = 0; r != df.Rows(); ++r)
+    {
+        for (size_t c = 0, s = 0; c != df.Cols(); ++c)
+        {
+            switch (df.TypeOf(c))
+            {
+            case Container::ColumnType::String:
+                buffer.append(strings[s++][r]);
+                break;
+            case Container::ColumnType::Integer:
+                buffer.append(number, std::to_chars(number, number + sizeof(number), df.NumericSeries<std::int64_t>(c)(r)).ptr);
+                break;
+            default:
+                buffer.append(number, std::to_chars(number, number + sizeof(number), df.NumericSeries<double>(c)(r)).ptr);
+                break;
+            }
+            buffer.push_back(c + 1 != df.Cols() ? separator : '\n');
+        }
+        if (buffer.size() > (1 << 20))
+        {
+            os.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    os.write(buffer.data(), buffer.size());
+    if (!os)
+    {
+        AGTB_THROW(std::runtime_error, std::format("Cannot write file: {}", csv_path));
+    }
+}
+
+AGTB_IO_END
+
+#endif
@@ -14,6 +14,18 @@ AGTB_LINALG_BEGIN
  */
 using Matrix = Eigen::MatrixXd;
 
+/**
+ * @brief Fixed-size 3 x 3 matrix, for rotations
+ *
+ */
+using Matrix3 = Eigen::Matrix3d;
+
+/**
+ * @brief N x 3 coordinates stored point by point, each row is `(X, Y, Z)`
+ *
+ */
+using Coordinates = Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>;
+
 /**
  * @brief Options to control Linalg functions
  *
@@ -21,7 +33,12 @@ using Matrix = Eigen::MatrixXd;
 enum class LinalgOption : size_t
 {
     Cholesky,
-    SVD
+    SVD,
+    /**
+     * @brief Float Cholesky refined in double, see `SolveMixedPrecision`
+     *
+     */
+    MixedPrecision
 };
 
 /**
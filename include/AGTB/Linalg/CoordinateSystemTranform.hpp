@@ -4,6 +4,10 @@
 #include "Base.hpp"
 #include "RotationMatrix.hpp"
 
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+
 AGTB_LINALG_BEGIN
 
 /**
@@ -30,9 +34,57 @@ AGTB_LINALG_BEGIN
 template <Axis ax1, Axis ax2, Axis ax3>
 Matrix CsRotationMatrix(double a1, double a2, double a3)
 {
-    return RotateByAxis<ax1>(a1) * RotateByAxis<ax2>(a2) * RotateByAxis<ax3>(a3);
+    return Fixed::RotateByAxis<ax1>(a1) * Fixed::RotateByAxis<ax2>(a2) * Fixed::RotateByAxis<ax3>(a3);
+}
+
+namespace Fixed
+{
+    /**
+     * @brief Fixed-size `CsRotationMatrix`, lives on stack
+     *
+     * @tparam ax1
+     * @tparam ax2
+     * @tparam ax3
+     * @param a1
+     * @param a2
+     * @param a3
+     * @return Matrix3
+     */
+    template <Axis ax1, Axis ax2, Axis ax3>
+    Matrix3 CsRotationMatrix(double a1, double a2, double a3)
+    {
+        return RotateByAxis<ax1>(a1) * RotateByAxis<ax2>(a2) * RotateByAxis<ax3>(a3);
+    }
+
+    /**
+     * @brief Same rotation as `CsRotationMatrix` in quaternion form, for composing and interpolating rotations
+     *
+     * @tparam ax1
+     * @tparam ax2
+     * @tparam ax3
+     * @param a1
+     * @param a2
+     * @param a3
+     * @return Eigen::Quaterniond
+     */
+    template <Axis ax1, Axis ax2, Axis ax3>
+    Eigen::Quaterniond CsRotationQuaternion(double a1, double a2, double a3)
+    {
+        return Eigen::Quaterniond(AngleAxisOf<ax1>(a1) * AngleAxisOf<ax2>(a2) * AngleAxisOf<ax3>(a3));
+    }
 }
 
+/**
+ * @brief Writable N x 3 Eigen object or expression, such as `Coordinates`, `Map<Coordinates>` or a block of them
+ *
+ */
+template <typename T>
+concept WritableCoordinates =
+    std::derived_from<std::remove_cvref_t<T>, Eigen::DenseBase<std::remove_cvref_t<T>>> &&
+    std::remove_cvref_t<T>::ColsAtCompileTime == 3 &&
+    !std::is_const_v<std::remove_reference_t<T>> &&
+    bool(std::remove_cvref_t<T>::Flags & Eigen::LvalueBit);
+
 /**
  * @brief Transform coordinates by coordinate system translation
  *
@@ -87,6 +139,65 @@ Matrix CsRotateForward(const Matrix &XYZ, const Matrix &rotate)
     return XYZ * rotate;
 }
 
+/**
+ * @brief In place `CsTranslate`
+ *
+ * @param XYZ
+ * @param x
+ * @param y
+ * @param z
+ */
+template <WritableCoordinates __xyz>
+void CsTranslate(__xyz &&XYZ, double x, double y, double z)
+{
+    XYZ.rowwise() -= Eigen::RowVector3d(x, y, z);
+}
+
+namespace detail
+{
+    /**
+     * @brief `XYZ = XYZ * rotate` block by block through a stack buffer
+     *
+     */
+    template <typename __xyz>
+    void CsRotateBlocked(__xyz &XYZ, const Matrix3 &rotate)
+    {
+        constexpr Eigen::Index block = 128;
+        Eigen::Matrix<double, block, 3> buffer;
+        const Eigen::Index rows = XYZ.rows();
+        for (Eigen::Index begin = 0; begin < rows; begin += block)
+        {
+            const Eigen::Index n = std::min(block, rows - begin);
+            buffer.topRows(n).noalias() = XYZ.middleRows(begin, n) * rotate;
+            XYZ.middleRows(begin, n) = buffer.topRows(n);
+        }
+    }
+}
+
+/**
+ * @brief In place `CsRotateInverse`
+ *
+ * @param XYZ in new coordinate system
+ * @param rotate new -> ori system
+ */
+template <WritableCoordinates __xyz>
+void CsRotateInverse(__xyz &&XYZ, const Matrix3 &rotate)
+{
+    detail::CsRotateBlocked(XYZ, Matrix3(rotate.transpose()));
+}
+
+/**
+ * @brief In place `CsRotateForward`
+ *
+ * @param XYZ in ori system
+ * @param rotate new -> ori system
+ */
+template <WritableCoordinates __xyz>
+void CsRotateForward(__xyz &&XYZ, const Matrix3 &rotate)
+{
+    detail::CsRotateBlocked(XYZ, rotate);
+}
+
 /**
  * @brief Transform coordinates by coordinate system scale
  *
@@ -101,6 +212,18 @@ Matrix CsScale(const Matrix &XYZ, double scale)
     return (XYZ.array() * scale).matrix();
 }
 
+/**
+ * @brief In place `CsScale`
+ *
+ * @param XYZ
+ * @param scale
+ */
+template <WritableCoordinates __xyz>
+void CsScale(__xyz &&XYZ, double scale)
+{
+    XYZ *= scale;
+}
+
 AGTB_LINALG_END
 
 #endif
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define __AGTB_LINALG_CORRECTION_OLS_SOLVE_HPP__
 
 #include "Base.hpp"
+#include "MixedPrecision.hpp"
+
+#include <format>
 
 AGTB_LINALG_BEGIN
 
@@ -17,6 +20,107 @@ Matrix CorrectionOlsSolve(const Matrix &A, const Matrix &L)
     return A.colPivHouseholderQr().solve(L);
 }
 
+/**
+ * @brief To equation `Ax - L = V`, solve by normal equations with `opt`. Only `LinalgOption::MixedPrecision`,
+ * for large well-conditioned systems where QR of `A` is too slow.
+ *
+ * @tparam opt
+ * @param A
+ * @param L
+ * @return Matrix
+ */
+template <LinalgOption opt>
+    requires(opt == LinalgOption::MixedPrecision)
+Matrix CorrectionOlsSolve(const Matrix &A, const Matrix &L)
+{
+    Matrix AtA = Matrix::Zero(A.cols(), A.cols());
+    AtA.selfadjointView<Eigen::Lower>().rankUpdate(A.transpose());
+    AtA.triangularView<Eigen::StrictlyUpper>() = AtA.transpose();
+    return SolveMixedPrecision(AtA, A.transpose() * L).x;
+}
+
+namespace Fixed
+{
+    /**
+     * @brief Normal equations of `__unknowns` unknowns accumulated row by row, lives on stack
+     *
+     * @tparam __unknowns
+     */
+    template <int __unknowns>
+    struct NormalEquation
+    {
+        using Vector = Eigen::Matrix<double, __unknowns, 1>;
+        using Square = Eigen::Matrix<double, __unknowns, __unknowns>;
+
+        Square N = Square::Zero();
+        Vector W = Vector::Zero();
+
+        template <typename __row>
+        void Add(const Eigen::MatrixBase<__row> &a, double l, double p = 1.0)
+        {
+            const Vector at = a.transpose();
+            N.noalias() += (p * at) * at.transpose();
+            W.noalias() += (p * l) * at;
+        }
+
+        /**
+         * @brief Solve by pivoted LDLT of the Jacobi-scaled `N`. Pivot ratio is a cheap estimate of `1 / cond(N)`.
+         *
+         * @param x
+         * @param pivot_threshold reject if smallest pivot is below `pivot_threshold` times largest
+         * @return if ill-conditioned -> false
+         */
+        bool Solve(Vector &x, double pivot_threshold = 1e-10) const
+        {
+            const Vector s = N.diagonal().cwiseSqrt().cwiseInverse();
+            if (!s.allFinite())
+            {
+                return false;
+            }
+            const Square Ns = s.asDiagonal() * N * s.asDiagonal();
+            Eigen::LDLT<Square> ldlt(Ns);
+            const auto D = ldlt.vectorD();
+            if (ldlt.info() != Eigen::Success || !(D.minCoeff() > pivot_threshold * D.maxCoeff()))
+            {
+                return false;
+            }
+            x = s.cwiseProduct(ldlt.solve(s.cwiseProduct(W)));
+            return true;
+        }
+    };
+
+    /**
+     * @brief Fixed-size `CorrectionOlsSolve` for small systems in iteration loops. `A.T * A` and `A.T * L` are
+     * accumulated on the fly and solved by fixed-size LDLT; ill-conditioned systems fall back to QR of `A`.
+     *
+     * @tparam __unknowns columns of `A`
+     * @param A
+     * @param L
+     * @return Eigen::Matrix<double, __unknowns, 1>
+     */
+    template <int __unknowns>
+    Eigen::Matrix<double, __unknowns, 1> CorrectionOlsSolve(const Matrix &A, const Matrix &L)
+    {
+        if (A.cols() != __unknowns || A.rows() != L.rows() || L.cols() != 1)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("A ({}, {}) and L ({}, {}) mismatch {} unknowns", A.rows(), A.cols(), L.rows(), L.cols(), __unknowns));
+        }
+
+        NormalEquation<__unknowns> ne{};
+        for (Eigen::Index i = 0; i != A.rows(); ++i)
+        {
+            ne.Add(A.row(i), L(i, 0));
+        }
+
+        Eigen::Matrix<double, __unknowns, 1> x;
+        if (!ne.Solve(x))
+        {
+            x = A.colPivHouseholderQr().solve(L);
+        }
+        return x;
+    }
+}
+
 AGTB_LINALG_END
 
 #endif
\ No newline at end of file
@@ -0,0 +1,245 @@
+#ifndef __AGTB_LINALG_FREE_NETWORK_HPP__
+#define __AGTB_LINALG_FREE_NETWORK_HPP__
+
+#include "Base.hpp"
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseLU>
+
+#include <format>
+#include <vector>
+
+AGTB_LINALG_BEGIN
+
+/**
+ * @brief Alias of Eigen::SparseMatrix<double>, column major
+ *
+ */
+using SparseMatrix = Eigen::SparseMatrix<double>;
+
+namespace detail::FreeNetwork
+{
+    /**
+     * @brief Orthonormal basis of `diag(datum) * G`, `datum` empty means every unknown takes part
+     *
+     */
+    inline Matrix DatumBasis(const Matrix &G, const Eigen::VectorXd &datum)
+    {
+        if (datum.size() != 0 && datum.size() != G.rows())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Datum selection of {} for {} unknowns", datum.size(), G.rows()));
+        }
+        const Matrix GS = datum.size() == 0 ? G : Matrix(datum.asDiagonal() * G);
+        Eigen::HouseholderQR<Matrix> qr(GS);
+        return qr.householderQ() * Matrix::Identity(GS.rows(), GS.cols());
+    }
+
+    /**
+     * @brief Weight of datum rows, keeps `N + c Q Q.T` as well conditioned as `N`
+     *
+     */
+    template <typename __matrix>
+    double DatumScale(const __matrix &N)
+    {
+        const double mean = N.diagonal().cwiseAbs().sum() / std::max<Eigen::Index>(N.rows(), 1);
+        return mean > 0.0 ? mean : 1.0;
+    }
+
+    inline void CheckSize(Eigen::Index N_rows, Eigen::Index N_cols, Eigen::Index W_rows, Eigen::Index G_rows)
+    {
+        if (N_rows != N_cols || N_rows != W_rows || N_rows != G_rows)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("N ({}, {}), W ({}) and G ({}) mismatch", N_rows, N_cols, W_rows, G_rows));
+        }
+    }
+}
+
+/**
+ * @brief Free-network (minimum-constraint) solutions of rank deficient normal equations `N x = W`. `G` (t x d)
+ * spans the null space of `N` (datum defect: translations, rotations, scale), `datum` selects which unknowns
+ * define the datum (1 = datum point, 0 = not, empty = all, i.e. inner constraints). The solution satisfies
+ * `(diag(datum) G).T x = 0`. With inner constraints it equals the pseudo-inverse solution `N+ W`.
+ *
+ * Instead of decomposing `N`, the datum is added explicitly: `(N + c Q Q.T)` is positive definite (dense LLT),
+ * or the bordered system `[N Q; Q.T 0]` is solved by sparse LU, where `Q` is an orthonormal basis of datum
+ * columns. Cost is one Cholesky / sparse factorization instead of a full SVD.
+ *
+ */
+struct FreeNetwork
+{
+    /**
+     * @brief Dense solution
+     *
+     * @param N normal matrix
+     * @param W `A.T * P * l`
+     * @param G datum matrix, `N * G = 0`
+     * @param datum
+     * @return Eigen::VectorXd
+     */
+    static Eigen::VectorXd Solve(const Matrix &N, const Eigen::VectorXd &W, const Matrix &G, const Eigen::VectorXd &datum = {})
+    {
+        using namespace detail::FreeNetwork;
+        CheckSize(N.rows(), N.cols(), W.rows(), G.rows());
+
+        const Matrix Q = DatumBasis(G, datum);
+        Matrix M = N;
+        M.selfadjointView<Eigen::Lower>().rankUpdate(Q, DatumScale(N));
+        Eigen::LLT<Matrix, Eigen::Lower> llt(M);
+        if (llt.info() != Eigen::Success)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Datum of {} columns does not remove the rank defect of N", G.cols()));
+        }
+        return llt.solve(W);
+    }
+
+    /**
+     * @brief Sparse solution, scales to large networks (only `N` has to be sparse)
+     *
+     * @param N normal matrix, both triangles
+     * @param W
+     * @param G
+     * @param datum
+     * @return Eigen::VectorXd
+     */
+    static Eigen::VectorXd Solve(const SparseMatrix &N, const Eigen::VectorXd &W, const Matrix &G, const Eigen::VectorXd &datum = {})
+    {
+        using namespace detail::FreeNetwork;
+        CheckSize(N.rows(), N.cols(), W.rows(), G.rows());
+
+        const Eigen::Index t = N.rows(), d = G.cols();
+        const Matrix Q = DatumBasis(G, datum) * std::sqrt(DatumScale(N));
+
+        std::vector<Eigen::Triplet<double>> triplets{};
+        triplets.reserve(N.nonZeros() + 2 * t * d);
+        for (Eigen::Index k = 0; k != N.outerSize(); ++k)
+        {
+            for (SparseMatrix::InnerIterator it(N, k); it; ++it)
+            {
+                triplets.emplace_back(it.row(), it.col(), it.value());
+            }
+        }
+        for (Eigen::Index j = 0; j != d; ++j)
+        {
+            for (Eigen::Index i = 0; i != t; ++i)
+            {
+                if (Q(i, j) != 0.0)
+                {
+                    triplets.emplace_back(i, t + j, Q(i, j));
+                    triplets.emplace_back(t + j, i, Q(i, j));
+                }
+            }
+        }
+        SparseMatrix K(t + d, t + d);
+        K.setFromTriplets(triplets.begin(), triplets.end());
+
+        Eigen::SparseLU<SparseMatrix, Eigen::COLAMDOrdering<int>> lu;
+        lu.compute(K);
+        if (lu.info() != Eigen::Success)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Datum of {} columns does not remove the rank defect of N: {}", d, lu.lastErrorMessage()));
+        }
+        Eigen::VectorXd rhs = Eigen::VectorXd::Zero(t + d);
+        rhs.head(t) = W;
+        return lu.solve(rhs).head(t);
+    }
+
+    /**
+     * @brief Cofactor matrix `Qxx` of the free-network solution, pseudo-inverse `N+` under inner constraints
+     *
+     * @param N
+     * @param G
+     * @param datum
+     * @return Matrix
+     */
+    static Matrix Inverse(const Matrix &N, const Matrix &G, const Eigen::VectorXd &datum = {})
+    {
+        using namespace detail::FreeNetwork;
+        CheckSize(N.rows(), N.cols(), N.rows(), G.rows());
+
+        const Matrix Q = DatumBasis(G, {});
+        const double c = DatumScale(N);
+        Matrix M = N;
+        M.selfadjointView<Eigen::Lower>().rankUpdate(Q, c);
+        Eigen::LLT<Matrix, Eigen::Lower> llt(M);
+        if (llt.info() != Eigen::Success)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Datum of {} columns does not remove the rank defect of N", G.cols()));
+        }
+        Matrix pinv = llt.solve(Matrix::Identity(N.rows(), N.cols()));
+        pinv.noalias() -= Q * Q.transpose() / c;
+        if (datum.size() == 0)
+        {
+            return pinv;
+        }
+        const Matrix S = STransformation(G, datum);
+        return S * pinv * S.transpose();
+    }
+
+    /**
+     * @brief S-transformation `S = I - G (G.T D G)^-1 G.T D`, `D = diag(datum)`, moves a solution `x` (and `Qxx`
+     * as `S Qxx S.T`) of any datum onto the one defined by `datum`
+     *
+     * @param G
+     * @param datum
+     * @return Matrix
+     */
+    static Matrix STransformation(const Matrix &G, const Eigen::VectorXd &datum)
+    {
+        if (datum.size() != G.rows())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Datum selection of {} for {} unknowns", datum.size(), G.rows()));
+        }
+        const Matrix GtD = G.transpose() * datum.asDiagonal();
+        return Matrix::Identity(G.rows(), G.rows()) - G * (GtD * G).ldlt().solve(GtD);
+    }
+
+    /**
+     * @brief Datum of a height (levelling) network, one unknown per point: a common shift
+     *
+     * @param points
+     * @return Matrix
+     */
+    static Matrix HeightDatum(Eigen::Index points)
+    {
+        return Matrix::Ones(points, 1);
+    }
+
+    /**
+     * @brief Datum of a plane network, unknowns are `(dx, dy)` per point in row order of `xy`: two shifts, and
+     * rotation (direction-free nets) and scale (distance-free nets) on request. Coordinates are centred first.
+     *
+     * @param xy n x 2 approximate coordinates
+     * @param rotation
+     * @param scale
+     * @return Matrix
+     */
+    static Matrix PlaneDatum(const Matrix &xy, bool rotation = true, bool scale = false)
+    {
+        const Eigen::Index n = xy.rows();
+        const Eigen::RowVector2d center = xy.leftCols<2>().colwise().mean();
+        Matrix G = Matrix::Zero(2 * n, 2 + rotation + scale);
+        for (Eigen::Index i = 0; i != n; ++i)
+        {
+            const double x = xy(i, 0) - center(0), y = xy(i, 1) - center(1);
+            G(2 * i, 0) = 1.0;
+            G(2 * i + 1, 1) = 1.0;
+            Eigen::Index col = 2;
+            if (rotation)
+            {
+                G(2 * i, col) = -y;
+                G(2 * i + 1, col) = x;
+                ++col;
+            }
+            if (scale)
+            {
+                G(2 * i, col) = x;
+                G(2 * i + 1, col) = y;
+            }
+        }
+        return G;
+    }
+};
+
+AGTB_LINALG_END
+
+#endif
@@ -0,0 +1,625 @@
+#ifndef __AGTB_LINALG_HELMERT_BLOCKING_HPP__
+#define __AGTB_LINALG_HELMERT_BLOCKING_HPP__
+
+#include "Base.hpp"
+#include "../Utils/Parallel.hpp"
+
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#include <algorithm>
+#include <format>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+AGTB_LINALG_BEGIN
+
+namespace detail::HelmertBlocking
+{
+    /**
+     * @brief `max_block` bounds the interior unknowns of one block (and so the dense matrices held per block),
+     * blocks are eliminated and back-substituted on `threads` threads.
+     *
+     */
+    struct Options
+    {
+        Eigen::Index max_block{512};
+        size_t threads{0};
+    };
+
+    /**
+     * @brief Sparse observation rows `sum(a_k * x_k) - l = v` with weight `p`, stored row by row
+     *
+     */
+    class Observations
+    {
+    public:
+        void Add(std::initializer_list<std::pair<Eigen::Index, double>> terms, double l, double p = 1.0)
+        {
+            for (const auto &[column, value] : terms)
+            {
+                columns_.emplace_back(column);
+                values_.emplace_back(value);
+            }
+            offsets_.emplace_back(columns_.size());
+            l_.emplace_back(l);
+            p_.emplace_back(p);
+        }
+
+        void Reserve(size_t rows, size_t terms_per_row = 2)
+        {
+            offsets_.reserve(rows + 1);
+            l_.reserve(rows);
+            p_.reserve(rows);
+            columns_.reserve(rows * terms_per_row);
+            values_.reserve(rows * terms_per_row);
+        }
+
+        size_t Size() const noexcept
+        {
+            return l_.size();
+        }
+
+        size_t Begin(size_t row) const noexcept
+        {
+            return offsets_[row];
+        }
+
+        size_t End(size_t row) const noexcept
+        {
+            return offsets_[row + 1];
+        }
+
+        Eigen::Index Column(size_t term) const noexcept
+        {
+            return columns_[term];
+        }
+
+        double Value(size_t term) const noexcept
+        {
+            return values_[term];
+        }
+
+        double L(size_t row) const noexcept
+        {
+            return l_[row];
+        }
+
+        double P(size_t row) const noexcept
+        {
+            return p_[row];
+        }
+
+        /**
+         * @brief `a * x - l` of one row
+         *
+         */
+        double Residual(size_t row, const Eigen::VectorXd &x) const noexcept
+        {
+            double ax = 0.0;
+            for (size_t k = Begin(row); k != End(row); ++k)
+            {
+                ax += values_[k] * x(columns_[k]);
+            }
+            return ax - l_[row];
+        }
+
+    private:
+        std::vector<size_t> offsets_{0};
+        std::vector<Eigen::Index> columns_{};
+        std::vector<double> values_{};
+        std::vector<double> l_{}, p_{};
+    };
+
+    /**
+     * @brief `block_of[i]` is the block of unknown `i`, or `junction` if `i` is shared between blocks. Every
+     * observation may touch the interior of at most one block.
+     *
+     */
+    struct Partition
+    {
+        static constexpr Eigen::Index junction = -1;
+
+        std::vector<Eigen::Index> block_of;
+        Eigen::Index blocks;
+    };
+
+    struct Result
+    {
+        Eigen::VectorXd x;
+        double vpv;
+        Eigen::Index blocks, junctions, largest_block;
+
+        std::string ToString() const noexcept
+        {
+            return std::format("{:=^100}\nUnknowns : {}\nBlocks : {}\nJunctions : {}\nLargest block : {}\nVPV : {}\n",
+                               " HelmertBlockingResult ",
+                               x.size(), blocks, junctions, largest_block, vpv);
+        }
+    };
+
+    /**
+     * @brief Adjacency of unknowns that share an observation, compressed rows
+     *
+     */
+    struct Adjacency
+    {
+        std::vector<size_t> offsets;
+        std::vector<Eigen::Index> neighbours;
+
+        Adjacency(Eigen::Index unknowns, const Observations &obs)
+            : offsets(unknowns + 1, 0)
+        {
+            auto for_pairs = [&](auto &&fn)
+            {
+                for (size_t r = 0; r != obs.Size(); ++r)
+                {
+                    for (size_t i = obs.Begin(r); i != obs.End(r); ++i)
+                    {
+                        for (size_t j = obs.Begin(r); j != obs.End(r); ++j)
+                        {
+                            if (obs.Column(i) != obs.Column(j))
+                            {
+                                fn(obs.Column(i), obs.Column(j));
+                            }
+                        }
+                    }
+                }
+            };
+
+            for_pairs([&](Eigen::Index u, Eigen::Index)
+                      { ++offsets[u + 1]; });
+            for (Eigen::Index u = 0; u != unknowns; ++u)
+            {
+                offsets[u + 1] += offsets[u];
+            }
+            neighbours.resize(offsets.back());
+            std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+            for_pairs([&](Eigen::Index u, Eigen::Index v)
+                      { neighbours[fill[u]++] = v; });
+        }
+    };
+
+    /**
+     * @brief One block and its contribution `S = N_jj - Y.T Y`, `w = W_j - Y.T z` to the junction system
+     *
+     */
+    struct EliminatedBlock
+    {
+        std::vector<Eigen::Index> interior, junction;
+        std::vector<size_t> rows;
+        Matrix S;
+        Eigen::VectorXd w;
+    };
+
+    /**
+     * @brief Factors of the interior of one block: `L L.T = N_ii`, `Y = L^-1 N_ij`, `z = L^-1 W_i`. Formed once for
+     * elimination and once again for back-substitution, so only blocks in flight hold them.
+     *
+     */
+    struct BlockFactor
+    {
+        Eigen::LLT<Matrix> llt;
+        Matrix Y;
+        Eigen::VectorXd z;
+    };
+
+    inline void CheckColumns(Eigen::Index unknowns, const Observations &obs)
+    {
+        for (size_t r = 0; r != obs.Size(); ++r)
+        {
+            for (size_t k = obs.Begin(r); k != obs.End(r); ++k)
+            {
+                if (obs.Column(k) < 0 || obs.Column(k) >= unknowns)
+                {
+                    AGTB_THROW(std::invalid_argument, std::format("Observation {} refers to unknown {} of {}", r, obs.Column(k), unknowns));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Form the block normal equations `N`, `W` (interior first, then touched junctions) and factor the
+     * interior
+     *
+     */
+    inline BlockFactor Factorize(const EliminatedBlock &block, const Observations &obs, const std::vector<Eigen::Index> &local_of, const std::vector<Eigen::Index> &block_of, Matrix &N, Eigen::VectorXd &W)
+    {
+        const Eigen::Index
+            b = block.interior.size(),
+            m = block.junction.size();
+        auto local = [&](Eigen::Index column)
+        {
+            if (block_of[column] != Partition::junction)
+            {
+                return local_of[column];
+            }
+            return b + (std::ranges::lower_bound(block.junction, column) - block.junction.begin());
+        };
+
+        N = Matrix::Zero(b + m, b + m);
+        W = Eigen::VectorXd::Zero(b + m);
+        for (size_t r : block.rows)
+        {
+            const double p = obs.P(r), l = obs.L(r);
+            for (size_t i = obs.Begin(r); i != obs.End(r); ++i)
+            {
+                const Eigen::Index li = local(obs.Column(i));
+                const double pa = p * obs.Value(i);
+                W(li) += pa * l;
+                for (size_t j = obs.Begin(r); j != obs.End(r); ++j)
+                {
+                    N(li, local(obs.Column(j))) += pa * obs.Value(j);
+                }
+            }
+        }
+
+        BlockFactor factor{};
+        factor.llt.compute(N.topLeftCorner(b, b));
+        if (factor.llt.info() != Eigen::Success)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Interior of a block with {} unknowns is not determined, network has a datum defect", b));
+        }
+        factor.Y = N.topRightCorner(b, m);
+        factor.llt.matrixL().solveInPlace(factor.Y);
+        factor.z = W.head(b);
+        factor.llt.matrixL().solveInPlace(factor.z);
+        return factor;
+    }
+
+    /**
+     * @brief Find the junctions touched by a block and eliminate its interior, only `S` and `w` are kept
+     *
+     */
+    inline void Eliminate(EliminatedBlock &block, const Observations &obs, const std::vector<Eigen::Index> &local_of, const std::vector<Eigen::Index> &block_of)
+    {
+        for (size_t r : block.rows)
+        {
+            for (size_t k = obs.Begin(r); k != obs.End(r); ++k)
+            {
+                if (block_of[obs.Column(k)] == Partition::junction)
+                {
+                    block.junction.emplace_back(obs.Column(k));
+                }
+            }
+        }
+        std::ranges::sort(block.junction);
+        block.junction.erase(std::ranges::unique(block.junction).begin(), block.junction.end());
+
+        const Eigen::Index m = block.junction.size();
+        Matrix N;
+        Eigen::VectorXd W;
+        const BlockFactor factor = Factorize(block, obs, local_of, block_of, N, W);
+        block.S = N.bottomRightCorner(m, m);
+        block.S.selfadjointView<Eigen::Lower>().rankUpdate(factor.Y.transpose(), -1.0);
+        block.w = W.tail(m) - factor.Y.transpose() * factor.z;
+    }
+}
+
+/**
+ * @brief Helmert blocking of large sparse least squares problems. Unknowns are split by nested dissection into
+ * blocks that share only junction unknowns. Each block forms its own normal equations and eliminates its interior
+ * unknowns (in parallel), the reduced junction system is summed and solved by sparse Cholesky, then the interiors
+ * are factored again and back-substituted (in parallel). Interior factors are never kept between the two passes,
+ * so dense memory is bounded by the largest block per thread (plus each block's junction part `S`), at the cost of
+ * factoring every block twice. The solution equals the direct one of the full normal equations.
+ *
+ */
+struct HelmertBlocking
+{
+    using Options = detail::HelmertBlocking::Options;
+    using Observations = detail::HelmertBlocking::Observations;
+    using Partition = detail::HelmertBlocking::Partition;
+    using Result = detail::HelmertBlocking::Result;
+
+    /**
+     * @brief Partition unknowns by recursive level-set bisection of the observation graph: the part of the median
+     * BFS level (from a pseudo-peripheral unknown) that touches the next level becomes junctions, both halves are
+     * split further until no connected part exceeds `max_block`
+     *
+     * @param unknowns
+     * @param obs
+     * @param max_block
+     * @return Partition
+     */
+    static Partition NestedDissection(Eigen::Index unknowns, const Observations &obs, Eigen::Index max_block)
+    {
+        using namespace detail::HelmertBlocking;
+        CheckColumns(unknowns, obs);
+        if (max_block < 1)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Block size {} must be positive", max_block));
+        }
+
+        const Adjacency adj(unknowns, obs);
+        Partition part{.block_of = std::vector<Eigen::Index>(unknowns, Partition::junction), .blocks = 0};
+        std::vector<size_t> stamp_of(unknowns, 0);
+        std::vector<Eigen::Index> level(unknowns, -1);
+        size_t stamp = 0;
+
+        // Visit `set` (all vertices stamped `stamp`) breadth first from `seed`, levels written to `level`
+        auto bfs = [&](Eigen::Index seed, std::vector<Eigen::Index> &order)
+        {
+            order.clear();
+            order.emplace_back(seed);
+            level[seed] = 0;
+            for (size_t head = 0; head != order.size(); ++head)
+            {
+                const Eigen::Index u = order[head];
+                for (size_t k = adj.offsets[u]; k != adj.offsets[u + 1]; ++k)
+                {
+                    const Eigen::Index v = adj.neighbours[k];
+                    if (stamp_of[v] == stamp && level[v] < 0)
+                    {
+                        level[v] = level[u] + 1;
+                        order.emplace_back(v);
+                    }
+                }
+            }
+        };
+        auto reset = [&](const std::vector<Eigen::Index> &order)
+        {
+            for (Eigen::Index v : order)
+            {
+                level[v] = -1;
+            }
+        };
+
+        std::vector<std::vector<Eigen::Index>> pending{};
+        pending.emplace_back(unknowns);
+        for (Eigen::Index u = 0; u != unknowns; ++u)
+        {
+            pending.back()[u] = u;
+        }
+
+        std::vector<Eigen::Index> component{}, order{};
+        while (!pending.empty())
+        {
+            const std::vector<Eigen::Index> set = std::move(pending.back());
+            pending.pop_back();
+            ++stamp;
+            for (Eigen::Index v : set)
+            {
+                stamp_of[v] = stamp;
+            }
+
+            for (Eigen::Index seed : set)
+            {
+                if (level[seed] >= 0 || stamp_of[seed] != stamp)
+                {
+                    continue;
+                }
+                bfs(seed, component);
+                if (static_cast<Eigen::Index>(component.size()) <= max_block)
+                {
+                    for (Eigen::Index v : component)
+                    {
+                        part.block_of[v] = part.blocks;
+                    }
+                    ++part.blocks;
+                    continue; // levels stay set, marks the component as visited
+                }
+
+                // Pseudo-peripheral start: the last vertex of a BFS is (near) an end of the longest path
+                const Eigen::Index far = component.back();
+                reset(component);
+                bfs(far, order);
+
+                const Eigen::Index depth = level[order.back()];
+                Eigen::Index median = level[order[order.size() / 2]];
+                median = std::min(median, depth - 1);
+
+                std::vector<Eigen::Index> lower{}, upper{};
+                for (Eigen::Index v : order)
+                {
+                    if (level[v] > median)
+                    {
+                        upper.emplace_back(v);
+                        continue;
+                    }
+                    bool separates = false;
+                    if (level[v] == median)
+                    {
+                        for (size_t k = adj.offsets[v]; k != adj.offsets[v + 1] && !separates; ++k)
+                        {
+                            const Eigen::Index w = adj.neighbours[k];
+                            separates = stamp_of[w] == stamp && level[w] == median + 1;
+                        }
+                    }
+                    if (!separates)
+                    {
+                        lower.emplace_back(v);
+                    }
+                }
+                // Levels stay set until the whole set is done, so the component is not visited again
+                if (!lower.empty())
+                {
+                    pending.emplace_back(std::move(lower));
+                }
+                pending.emplace_back(std::move(upper));
+            }
+            reset(set);
+        }
+        return part;
+    }
+
+    /**
+     * @brief Solve by Helmert blocking with a given partition
+     *
+     * @param unknowns
+     * @param obs
+     * @param part
+     * @param options only `threads` is used
+     * @return Result
+     */
+    static Result Solve(Eigen::Index unknowns, const Observations &obs, const Partition &part, const Options &options = {})
+    {
+        using namespace detail::HelmertBlocking;
+        CheckColumns(unknowns, obs);
+        if (static_cast<Eigen::Index>(part.block_of.size()) != unknowns)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Partition of {} unknowns for {}", part.block_of.size(), unknowns));
+        }
+
+        // Junction numbering follows unknown order, so lower triangles of blocks stay lower in the junction system
+        std::vector<EliminatedBlock> blocks(part.blocks);
+        std::vector<Eigen::Index> local_of(unknowns, 0);
+        Eigen::Index junctions = 0;
+        for (Eigen::Index u = 0; u != unknowns; ++u)
+        {
+            const Eigen::Index b = part.block_of[u];
+            if (b == Partition::junction)
+            {
+                local_of[u] = junctions++;
+            }
+            else
+            {
+                local_of[u] = blocks[b].interior.size();
+                blocks[b].interior.emplace_back(u);
+            }
+        }
+
+        std::vector<size_t> junction_rows{};
+        for (size_t r = 0; r != obs.Size(); ++r)
+        {
+            Eigen::Index owner = Partition::junction;
+            for (size_t k = obs.Begin(r); k != obs.End(r); ++k)
+            {
+                const Eigen::Index b = part.block_of[obs.Column(k)];
+                if (b == Partition::junction || b == owner)
+                {
+                    continue;
+                }
+                if (owner != Partition::junction)
+                {
+                    AGTB_THROW(std::invalid_argument, std::format("Observation {} connects interiors of block {} and {}", r, owner, b));
+                }
+                owner = b;
+            }
+            if (owner == Partition::junction)
+            {
+                junction_rows.emplace_back(r);
+            }
+            else
+            {
+                blocks[owner].rows.emplace_back(r);
+            }
+        }
+
+        Utils::ParallelFor(
+            blocks.size(),
+            [&](size_t b)
+            { Eliminate(blocks[b], obs, local_of, part.block_of); },
+            options.threads);
+
+        Eigen::VectorXd xj = Eigen::VectorXd::Zero(junctions);
+        if (junctions != 0)
+        {
+            std::vector<Eigen::Triplet<double>> triplets{};
+            Eigen::VectorXd wj = Eigen::VectorXd::Zero(junctions);
+            for (auto &block : blocks)
+            {
+                const Eigen::Index m = block.junction.size();
+                for (Eigen::Index c = 0; c != m; ++c)
+                {
+                    const Eigen::Index jc = local_of[block.junction[c]];
+                    wj(jc) += block.w(c);
+                    for (Eigen::Index r = c; r != m; ++r)
+                    {
+                        triplets.emplace_back(local_of[block.junction[r]], jc, block.S(r, c));
+                    }
+                }
+                block.S.resize(0, 0);
+            }
+            for (size_t r : junction_rows)
+            {
+                const double p = obs.P(r), l = obs.L(r);
+                for (size_t i = obs.Begin(r); i != obs.End(r); ++i)
+                {
+                    const Eigen::Index ji = local_of[obs.Column(i)];
+                    wj(ji) += p * obs.Value(i) * l;
+                    for (size_t j = obs.Begin(r); j != obs.End(r); ++j)
+                    {
+                        const Eigen::Index jj = local_of[obs.Column(j)];
+                        if (ji >= jj)
+                        {
+                            triplets.emplace_back(ji, jj, p * obs.Value(i) * obs.Value(j));
+                        }
+                    }
+                }
+            }
+
+            Eigen::SparseMatrix<double> N(junctions, junctions);
+            N.setFromTriplets(triplets.begin(), triplets.end());
+            Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> ldlt(N);
+            if (ldlt.info() != Eigen::Success)
+            {
+                AGTB_THROW(std::invalid_argument, std::format("Junction system of {} unknowns is singular, network has a datum defect", junctions));
+            }
+            xj = ldlt.solve(wj);
+        }
+
+        Result result{.x = Eigen::VectorXd::Zero(unknowns), .vpv = 0.0, .blocks = part.blocks, .junctions = junctions, .largest_block = 0};
+        for (const auto &block : blocks)
+        {
+            result.largest_block = std::max<Eigen::Index>(result.largest_block, block.interior.size());
+        }
+        for (Eigen::Index u = 0; u != unknowns; ++u)
+        {
+            if (part.block_of[u] == Partition::junction)
+            {
+                result.x(u) = xj(local_of[u]);
+            }
+        }
+
+        Utils::ParallelFor(
+            blocks.size(),
+            [&](size_t b)
+            {
+                auto &block = blocks[b];
+                Eigen::VectorXd xb_j(block.junction.size());
+                for (size_t c = 0; c != block.junction.size(); ++c)
+                {
+                    xb_j(c) = xj(local_of[block.junction[c]]);
+                }
+                Matrix N;
+                Eigen::VectorXd W;
+                const BlockFactor factor = Factorize(block, obs, local_of, part.block_of, N, W);
+                N.resize(0, 0);
+                Eigen::VectorXd xi = factor.z - factor.Y * xb_j;
+                factor.llt.matrixU().solveInPlace(xi);
+                for (size_t k = 0; k != block.interior.size(); ++k)
+                {
+                    result.x(block.interior[k]) = xi(k);
+                }
+                block = EliminatedBlock{};
+            },
+            options.threads);
+
+        for (size_t r = 0; r != obs.Size(); ++r)
+        {
+            const double v = obs.Residual(r, result.x);
+            result.vpv += obs.P(r) * v * v;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Partition by `NestedDissection` with `options.max_block` and solve
+     *
+     * @param unknowns
+     * @param obs
+     * @param options
+     * @return Result
+     */
+    static Result Solve(Eigen::Index unknowns, const Observations &obs, const Options &options = {})
+    {
+        return Solve(unknowns, obs, NestedDissection(unknowns, obs, options.max_block), options);
+    }
+};
+
+AGTB_LINALG_END
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef __AGTB_LINALG_MIXED_PRECISION_HPP__
+#define __AGTB_LINALG_MIXED_PRECISION_HPP__
+
+#include "Base.hpp"
+
+#include <cmath>
+#include <format>
+#include <limits>
+#include <string>
+
+AGTB_LINALG_BEGIN
+
+namespace detail::MixedPrecision
+{
+    /**
+     * @brief Refinement stops when the scaled residual `|W - N x| / (|N| |x|)` (inf norms, `N` is symmetric) drops
+     * below `tolerance` (default `eps`) or a correction is below rounding of `x`. It falls back to a double
+     * factorization after `max_iterations` or as soon as a correction shrinks by less than `stall_ratio`.
+     *
+     */
+    struct Options
+    {
+        int max_iterations{30};
+        double tolerance{0.0};
+        double stall_ratio{0.5};
+    };
+
+    enum class Status
+    {
+        Refined,
+        FallbackFactorization,
+        FallbackStalled
+    };
+
+    inline std::string_view ToString(Status status) noexcept
+    {
+        switch (status)
+        {
+        case Status::Refined:
+            return "refined";
+        case Status::FallbackFactorization:
+            return "fallback (float factorization failed)";
+        default:
+            return "fallback (refinement stalled)";
+        }
+    }
+
+    struct Result
+    {
+        Matrix x;
+        int iterations;
+        double residual;
+        Status status;
+
+        std::string ToString() const noexcept
+        {
+            return std::format("{:=^100}\nStatus : {}\nIterations : {}\nScaled residual : {:.3e}\n",
+                               " MixedPrecisionResult ",
+                               MixedPrecision::ToString(status), iterations, residual);
+        }
+    };
+
+    inline double ScaledResidual(const Matrix &r, const Matrix &x, double N_norm)
+    {
+        const double x_norm = x.cwiseAbs().maxCoeff();
+        return x_norm > 0.0 ? r.cwiseAbs().maxCoeff() / (N_norm * x_norm) : r.cwiseAbs().maxCoeff();
+    }
+
+    inline Matrix DoubleSolve(const Matrix &N, const Matrix &W)
+    {
+        Eigen::LLT<Matrix> llt(N);
+        if (llt.info() == Eigen::Success)
+        {
+            return llt.solve(W);
+        }
+        return N.ldlt().solve(W);
+    }
+}
+
+/**
+ * @brief Solve symmetric positive definite `N x = W` by a single precision Cholesky refined in double precision.
+ * The float factorization uses twice the SIMD width and half the memory, the refined `x` has double accuracy for
+ * well-conditioned `N` (condition number well below `1e7`). Otherwise the solve falls back to a double Cholesky
+ * on its own, see `Result::status`.
+ *
+ * @param N
+ * @param W one or more right-hand sides
+ * @param options
+ * @return detail::MixedPrecision::Result
+ */
+inline detail::MixedPrecision::Result SolveMixedPrecision(const Matrix &N, const Matrix &W, const detail::MixedPrecision::Options &options = {})
+{
+    using namespace detail::MixedPrecision;
+
+    if (N.rows() != N.cols() || N.rows() != W.rows())
+    {
+        AGTB_THROW(std::invalid_argument, std::format("N ({}, {}) and W ({}, {}) mismatch", N.rows(), N.cols(), W.rows(), W.cols()));
+    }
+
+    const double
+        N_norm = N.cwiseAbs().colwise().sum().maxCoeff(),
+        tolerance = options.tolerance > 0.0 ? options.tolerance
+                                            : std::numeric_limits<double>::epsilon();
+
+    Eigen::LLT<Eigen::MatrixXf> llt(N.cast<float>());
+    if (llt.info() != Eigen::Success)
+    {
+        Matrix x = DoubleSolve(N, W);
+        return Result{.x = x, .iterations = 0, .residual = ScaledResidual(W - N * x, x, N_norm), .status = Status::FallbackFactorization};
+    }
+
+    Matrix x = llt.solve(W.cast<float>()).cast<double>();
+    double previous = std::numeric_limits<double>::infinity();
+    int iterations = 0;
+    for (; iterations <= options.max_iterations; ++iterations)
+    {
+        const Matrix r = W - N * x;
+        const double residual = ScaledResidual(r, x, N_norm);
+        if (residual <= tolerance)
+        {
+            return Result{.x = std::move(x), .iterations = iterations, .residual = residual, .status = Status::Refined};
+        }
+
+        const Matrix d = llt.solve(r.cast<float>()).cast<double>();
+        const double step = d.cwiseAbs().maxCoeff();
+        if (step <= std::numeric_limits<double>::epsilon() * x.cwiseAbs().maxCoeff())
+        {
+            return Result{.x = std::move(x), .iterations = iterations, .residual = residual, .status = Status::Refined};
+        }
+        if (!std::isfinite(step) || step > options.stall_ratio * previous)
+        {
+            break;
+        }
+        previous = step;
+        x += d;
+    }
+
+    x = DoubleSolve(N, W);
+    return Result{.x = x, .iterations = iterations, .residual = ScaledResidual(W - N * x, x, N_norm), .status = Status::FallbackStalled};
+}
+
+AGTB_LINALG_END
+
+#endif
@@ -0,0 +1,334 @@
+#ifndef __AGTB_LINALG_NORMAL_EQUATION_ACCUMULATOR_HPP__
+#define __AGTB_LINALG_NORMAL_EQUATION_ACCUMULATOR_HPP__
+
+#include "Base.hpp"
+#include "../Utils/Parallel.hpp"
+#include "../Utils/CpuDispatch.hpp"
+
+#include <cmath>
+#include <format>
+#include <ranges>
+#include <vector>
+#include <algorithm>
+
+AGTB_LINALG_BEGIN
+
+namespace detail::NormalEquationAccumulator
+{
+    using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /**
+     * @brief `block_rows` observations are buffered before one rank-k update. `partitions` fixes how rows are split
+     * for parallel accumulation, so results are bit-identical for any `threads` as long as `block_rows` and
+     * `partitions` stay the same. Each partition holds its own `N`; `1` accumulates in place without one.
+     *
+     */
+    struct Options
+    {
+        Eigen::Index block_rows{256};
+        size_t partitions{16};
+        size_t threads{0};
+    };
+
+    /**
+     * @brief Normal equations `N x = W` of `Ax - l = V` with weight `P`, `N = A.T * P * A`, `W = A.T * P * l`,
+     * `lPl = l.T * P * l`. `N` is full (both triangles filled).
+     *
+     */
+    struct NormalEquation
+    {
+        Matrix N;
+        Eigen::VectorXd W;
+        double lPl;
+        size_t observations;
+
+        /**
+         * @brief Solve `N x = W`, LDLT falls back when N is not positive definite
+         *
+         * @return Eigen::VectorXd
+         */
+        Eigen::VectorXd Solve() const
+        {
+            Eigen::LLT<Matrix> llt(N);
+            if (llt.info() == Eigen::Success)
+            {
+                return llt.solve(W);
+            }
+            return N.ldlt().solve(W);
+        }
+
+        /**
+         * @brief Weighted sum of squared residuals at `x`, `V.T * P * V = lPl - x.T * W` without forming `V`
+         *
+         * @param x
+         * @return double
+         */
+        double VPV(const Eigen::VectorXd &x) const
+        {
+            return lPl - x.dot(W);
+        }
+    };
+
+    /**
+     * @brief Partial sums of one thread (or partition). Only the lower triangle of `N` is updated.
+     *
+     */
+    class Block
+    {
+    public:
+        Block() = default;
+
+        Block(Eigen::Index unknowns, Eigen::Index block_rows)
+            : N(Matrix::Zero(unknowns, unknowns)),
+              W(Eigen::VectorXd::Zero(unknowns)),
+              A(block_rows, unknowns),
+              l(block_rows)
+        {
+        }
+
+        /**
+         * @brief Next free row of the buffer, zeroed. Call `Commit` after filling it.
+         *
+         */
+        auto NextRow()
+        {
+            A.row(filled).setZero();
+            return A.row(filled);
+        }
+
+        AGTB_MULTIVERSION void Commit(double obs, double weight, size_t index)
+        {
+            if (!(weight >= 0.0))
+            {
+                AGTB_THROW(std::invalid_argument, std::format("Weight {} of observation {} is negative", weight, index));
+            }
+            if (weight != 1.0)
+            {
+                const double s = std::sqrt(weight);
+                A.row(filled) *= s;
+                obs *= s;
+            }
+            l(filled) = obs;
+            ++observations;
+            if (++filled == A.rows())
+            {
+                Flush();
+            }
+        }
+
+        AGTB_MULTIVERSION void Flush()
+        {
+            if (filled == 0)
+            {
+                return;
+            }
+            const auto Ab = A.topRows(filled);
+            const auto lb = l.head(filled);
+            N.selfadjointView<Eigen::Lower>().rankUpdate(Ab.transpose());
+            W.noalias() += Ab.transpose() * lb;
+            lPl += lb.squaredNorm();
+            filled = 0;
+        }
+
+        /**
+         * @brief Add flushed sums of `other`, lower triangle only
+         *
+         */
+        void Merge(const Block &other)
+        {
+            N.triangularView<Eigen::Lower>() += other.N;
+            W += other.W;
+            lPl += other.lPl;
+            observations += other.observations;
+        }
+
+        Matrix N;
+        Eigen::VectorXd W;
+        RowMatrix A;
+        Eigen::VectorXd l;
+        double lPl{0.0};
+        size_t observations{0};
+        Eigen::Index filled{0};
+    };
+
+    inline const bool block_registered =
+        Utils::detail::CpuDispatch::Register("Linalg::NormalEquationAccumulator", Utils::detail::CpuDispatch::Kind::Clones);
+}
+
+/**
+ * @brief Streaming accumulation of normal equations, the design matrix never exists as a whole. Observations are
+ * buffered into small blocks and folded into `N` by symmetric rank-k updates (lower triangle only).
+ *
+ * ```
+ * NormalEquationAccumulator acc(t);
+ * for (...) acc.Add(a_row, l, p);                   // one by one
+ * acc.AddRange(observations);                       // any range (e.g. `std::generator`) of `{a, l, p}`
+ * acc.AddParallel(n, [](size_t i, auto a, double &l, double &p) { ... });   // fill row `i` on worker threads
+ * auto ne = acc.Result();
+ * ```
+ */
+class NormalEquationAccumulator
+{
+public:
+    using Options = detail::NormalEquationAccumulator::Options;
+    using NormalEquation = detail::NormalEquationAccumulator::NormalEquation;
+    using RowRef = Eigen::Ref<Eigen::RowVectorXd>;
+
+    explicit NormalEquationAccumulator(Eigen::Index unknowns, Options options = {})
+        : options_(options), sums_(unknowns, std::max<Eigen::Index>(options.block_rows, 1))
+    {
+        if (unknowns <= 0)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Unknowns should be positive, got {}", unknowns));
+        }
+    }
+
+    Eigen::Index Unknowns() const noexcept
+    {
+        return sums_.N.rows();
+    }
+
+    size_t Observations() const noexcept
+    {
+        return sums_.observations;
+    }
+
+    /**
+     * @brief Add one observation, `a` is its row of design matrix
+     *
+     * @param a
+     * @param l
+     * @param p weight, diagonal element of `P`
+     */
+    void Add(const Eigen::Ref<const Eigen::RowVectorXd> &a, double l, double p = 1.0)
+    {
+        if (a.size() != Unknowns())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Row of {} coefficients for {} unknowns", a.size(), Unknowns()));
+        }
+        sums_.NextRow() = a;
+        sums_.Commit(l, p, sums_.observations);
+    }
+
+    /**
+     * @brief Add every observation of `observations`, each element has members `a` (row of design matrix), `l` and
+     * `p`. Single pass, so generators work.
+     *
+     * @tparam __range
+     * @param observations
+     */
+    template <std::ranges::input_range __range>
+    void AddRange(__range &&observations)
+    {
+        for (auto &&obs : observations)
+        {
+            Add(obs.a, obs.l, obs.p);
+        }
+    }
+
+    /**
+     * @brief Add `n` observations filled by `fill(i, a, l, p)` on worker threads. `a` (zeroed, `RowRef`) and `l`
+     * are written by `fill`, `p` starts at `1`. Rows are split into `Options::partitions` contiguous ranges with
+     * private partial sums, which are reduced in partition order. With `partitions == 1` rows are accumulated in
+     * place on the calling thread, without a partial `N`, so rows before a throwing one stay added.
+     *
+     * @tparam __fill void(size_t i, RowRef a, double &l, double &p)
+     * @param n
+     * @param fill
+     */
+    template <typename __fill>
+    void AddParallel(size_t n, __fill &&fill)
+    {
+        using detail::NormalEquationAccumulator::Block;
+
+        sums_.Flush();
+        const size_t
+            partitions = std::clamp<size_t>(options_.partitions, 1, std::max<size_t>(n, 1)),
+            per_partition = (n + partitions - 1) / partitions;
+        const Eigen::Index block_rows = sums_.A.rows();
+
+        if (options_.partitions <= 1)
+        {
+            for (size_t i = 0; i != n; ++i)
+            {
+                double l = 0.0, p = 1.0;
+                fill(i, RowRef(sums_.NextRow()), l, p);
+                sums_.Commit(l, p, i);
+            }
+            sums_.Flush();
+            return;
+        }
+
+        std::vector<Block> partials(partitions);
+        Utils::ParallelFor(
+            partitions,
+            [&](size_t part)
+            {
+                Block block(Unknowns(), block_rows);
+                const size_t
+                    begin = std::min(n, part * per_partition),
+                    end = std::min(n, begin + per_partition);
+                for (size_t i = begin; i != end; ++i)
+                {
+                    double l = 0.0, p = 1.0;
+                    fill(i, RowRef(block.NextRow()), l, p);
+                    block.Commit(l, p, i);
+                }
+                block.Flush();
+                block.A.resize(0, 0);
+                partials[part] = std::move(block);
+            },
+            options_.threads);
+
+        for (const auto &partial : partials)
+        {
+            sums_.Merge(partial);
+        }
+    }
+
+    /**
+     * @brief Add sums of another accumulator of the same size
+     *
+     * @param other
+     */
+    void Merge(NormalEquationAccumulator &other)
+    {
+        if (other.Unknowns() != Unknowns())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Cannot merge {} unknowns into {}", other.Unknowns(), Unknowns()));
+        }
+        sums_.Flush();
+        other.sums_.Flush();
+        sums_.Merge(other.sums_);
+    }
+
+    /**
+     * @brief Flush pending rows and return full normal equations, accumulation may go on afterwards
+     *
+     * @return NormalEquation
+     */
+    NormalEquation Result()
+    {
+        sums_.Flush();
+        Matrix N = sums_.N;
+        N.triangularView<Eigen::StrictlyUpper>() = N.transpose();
+        return NormalEquation{
+            .N = std::move(N),
+            .W = sums_.W,
+            .lPl = sums_.lPl,
+            .observations = sums_.observations};
+    }
+
+    void Reset()
+    {
+        sums_ = detail::NormalEquationAccumulator::Block(Unknowns(), sums_.A.rows());
+    }
+
+private:
+    Options options_;
+    detail::NormalEquationAccumulator::Block sums_;
+};
+
+AGTB_LINALG_END
+
+#endif
@@ -2,10 +2,30 @@
 #define __AGTB_LINALG_NORMAL_EQUATION_MATRIX_INVERSE_HPP__
 
 #include "Base.hpp"
+#include "MixedPrecision.hpp"
 #include "../Utils/Concept.hpp"
 
 AGTB_LINALG_BEGIN
 
+namespace detail::NormalEquationMatrixInverse
+{
+    /**
+     * @brief `A.T * P * A`, unweighted case is a symmetric rank update instead of multiplying an n x n identity
+     *
+     */
+    inline Matrix NormalMatrix(const Matrix &A, const Matrix &P)
+    {
+        if (P.isZero())
+        {
+            Matrix AtA = Matrix::Zero(A.cols(), A.cols());
+            AtA.selfadjointView<Eigen::Lower>().rankUpdate(A.transpose());
+            AtA.triangularView<Eigen::StrictlyUpper>() = AtA.transpose();
+            return AtA;
+        }
+        return A.transpose() * P * A;
+    }
+}
+
 /**
  * @brief To equation `Ax - L = V`, return (A.T * A).Inverse
  *
@@ -22,9 +42,7 @@ Matrix NormalEquationMatrixInverse(const Matrix &A, const Matrix &P = Matrix::Ze
 template <>
 Matrix NormalEquationMatrixInverse<LinalgOption::Cholesky>(const Matrix &A, const Matrix &P)
 {
-    Matrix AtA = A.transpose() *
-                 (P.isZero() ? Matrix::Identity(A.cols(), A.cols()) : P) *
-                 A;
+    Matrix AtA = detail::NormalEquationMatrixInverse::NormalMatrix(A, P);
     Eigen::LLT<Matrix> llt(AtA);
     if (llt.info() == Eigen::Success)
     {
@@ -39,29 +57,44 @@ Matrix NormalEquationMatrixInverse<LinalgOption::Cholesky>(const Matrix &A, cons
     }
 }
 
+/**
+ * @brief Pseudo-inverse for rank deficient `A`. `A.T * A` is symmetric positive semi-definite, so its singular
+ * value decomposition is the eigen decomposition, which is much cheaper than a full `JacobiSVD`. For datum-free
+ * networks with known defect see `FreeNetwork`.
+ *
+ */
 template <>
 Matrix NormalEquationMatrixInverse<LinalgOption::SVD>(const Matrix &A, const Matrix &P)
 {
-    Matrix AtA = A.transpose() *
-                 (P.isZero() ? Matrix::Identity(A.rows(), A.rows()) : P) *
-                 A;
-    Eigen::JacobiSVD<Matrix> svd(AtA, Eigen::ComputeFullU | Eigen::ComputeFullV);
-    const Eigen::VectorXd &singular_values = svd.singularValues();
+    Matrix AtA = detail::NormalEquationMatrixInverse::NormalMatrix(A, P);
+    Eigen::SelfAdjointEigenSolver<Matrix> eig(AtA);
+    const Eigen::VectorXd &eigen_values = eig.eigenvalues();
 
-    double tolerance = singular_values(0) * std::max(AtA.rows(), AtA.cols()) * 1e-12;
+    double tolerance = eigen_values.cwiseAbs().maxCoeff() * std::max(AtA.rows(), AtA.cols()) * 1e-12;
 
-    Eigen::VectorXd inv_singular_values(singular_values.size());
-    for (int i = 0; i < singular_values.size(); ++i)
+    Eigen::VectorXd inv_eigen_values(eigen_values.size());
+    for (int i = 0; i < eigen_values.size(); ++i)
     {
-        inv_singular_values(i) = (singular_values(i) > tolerance) ? 1.0 / singular_values(i) : 0.0;
+        inv_eigen_values(i) = (eigen_values(i) > tolerance) ? 1.0 / eigen_values(i) : 0.0;
     }
 
-    Matrix invAtA = svd.matrixV() *
-                    inv_singular_values.asDiagonal() *
-                    svd.matrixU().transpose();
+    Matrix invAtA = eig.eigenvectors() *
+                    inv_eigen_values.asDiagonal() *
+                    eig.eigenvectors().transpose();
     return invAtA;
 }
 
+/**
+ * @brief Inverse by mixed precision, columns of identity are refined as right-hand sides
+ *
+ */
+template <>
+Matrix NormalEquationMatrixInverse<LinalgOption::MixedPrecision>(const Matrix &A, const Matrix &P)
+{
+    Matrix AtA = detail::NormalEquationMatrixInverse::NormalMatrix(A, P);
+    return SolveMixedPrecision(AtA, Matrix::Identity(AtA.rows(), AtA.cols())).x;
+}
+
 AGTB_LINALG_END
 
 #endif
\ No newline at end of file
@@ -4,9 +4,123 @@
 #include "Base.hpp"
 
 #include <cmath>
+#include <Eigen/Geometry>
 
 AGTB_LINALG_BEGIN
 
+namespace Fixed
+{
+    /**
+     * @brief Rotate in axis X
+     *
+     * @param omega
+     * @return Matrix3
+     */
+    Matrix3 RotateX(double omega)
+    {
+        const double
+            sinw = std::sin(omega),
+            cosw = std::cos(omega);
+        Matrix3 Rw;
+        Rw << 1, 0, 0,
+            0, cosw, -sinw,
+            0, sinw, cosw;
+        return Rw;
+    }
+
+    /**
+     * @brief Rotate in axis Y
+     *
+     * @param phi
+     * @return Matrix3
+     */
+    Matrix3 RotateY(double phi)
+    {
+        const double
+            sinp = std::sin(phi),
+            cosp = std::cos(phi);
+        Matrix3 Rp;
+        Rp << cosp, 0, -sinp,
+            0, 1, 0,
+            sinp, 0, cosp;
+        return Rp;
+    }
+
+    /**
+     * @brief Rotate in axis Z
+     *
+     * @param kappa
+     * @return Matrix3
+     */
+    Matrix3 RotateZ(double kappa)
+    {
+        const double
+            sink = std::sin(kappa),
+            cosk = std::cos(kappa);
+        Matrix3 Rk;
+        Rk << cosk, -sink, 0,
+            sink, cosk, 0,
+            0, 0, 1;
+        return Rk;
+    }
+
+    /**
+     * @brief Uniform interface of Rotate<X | Y | Z>
+     *
+     * @tparam ax
+     * @param angle
+     * @return Matrix3
+     */
+    template <Axis ax>
+    Matrix3 RotateByAxis(double angle)
+    {
+        if constexpr (ax == Axis::X)
+        {
+            return RotateX(angle);
+        }
+        else if constexpr (ax == Axis::Y)
+        {
+            return RotateY(angle);
+        }
+        else if constexpr (ax == Axis::Z)
+        {
+            return RotateZ(angle);
+        }
+        else
+        {
+            AGTB_TEMPLATE_NOT_SPECIALIZED();
+        }
+    }
+
+    /**
+     * @brief Same rotation as `RotateByAxis<ax>(angle)` in angle-axis form. `RotateY` turns by `-angle` about Y.
+     *
+     * @tparam ax
+     * @param angle
+     * @return Eigen::AngleAxisd
+     */
+    template <Axis ax>
+    Eigen::AngleAxisd AngleAxisOf(double angle)
+    {
+        if constexpr (ax == Axis::X)
+        {
+            return Eigen::AngleAxisd(angle, Eigen::Vector3d::UnitX());
+        }
+        else if constexpr (ax == Axis::Y)
+        {
+            return Eigen::AngleAxisd(-angle, Eigen::Vector3d::UnitY());
+        }
+        else if constexpr (ax == Axis::Z)
+        {
+            return Eigen::AngleAxisd(angle, Eigen::Vector3d::UnitZ());
+        }
+        else
+        {
+            AGTB_TEMPLATE_NOT_SPECIALIZED();
+        }
+    }
+}
+
 /**
  * @brief Rotate in axis X
  *
@@ -15,14 +129,7 @@ AGTB_LINALG_BEGIN
  */
 Matrix RotateX(double omega)
 {
-    const double
-        sinw = sin(omega),
-        cosw = cos(omega);
-    Matrix Rw(3, 3);
-    Rw << 1, 0, 0,
-        0, cosw, -sinw,
-        0, sinw, cosw;
-    return std::move(Rw);
+    return Fixed::RotateX(omega);
 }
 
 /**
@@ -33,14 +140,7 @@ Matrix RotateX(double omega)
  */
 Matrix RotateY(double phi)
 {
-    const double
-        sinp = sin(phi),
-        cosp = cos(phi);
-    Matrix Rp(3, 3);
-    Rp << cosp, 0, -sinp,
-        0, 1, 0,
-        sinp, 0, cosp;
-    return std::move(Rp);
+    return Fixed::RotateY(phi);
 }
 
 /**
@@ -51,14 +151,7 @@ Matrix RotateY(double phi)
  */
 Matrix RotateZ(double kappa)
 {
-    const double
-        sink = sin(kappa),
-        cosk = cos(kappa);
-    Matrix Rk(3, 3);
-    Rk << cosk, -sink, 0,
-        sink, cosk, 0,
-        0, 0, 1;
-    return std::move(Rk);
+    return Fixed::RotateZ(kappa);
 }
 
 /**
@@ -71,22 +164,7 @@ Matrix RotateZ(double kappa)
 template <Axis ax>
 Matrix RotateByAxis(double angle)
 {
-    if constexpr (ax == Axis::X)
-    {
-        return RotateX(angle);
-    }
-    else if constexpr (ax == Axis::Y)
-    {
-        return RotateY(angle);
-    }
-    else if constexpr (ax == Axis::Z)
-    {
-        return RotateZ(angle);
-    }
-    else
-    {
-        AGTB_TEMPLATE_NOT_SPECIALIZED();
-    }
+    return Fixed::RotateByAxis<ax>(angle);
 }
 
 // Matrix RotationMatrix(double phi, double omega, double kappa)
@@ -3,6 +3,9 @@
 
 #include "Photogrammetry/SpaceResection.hpp"
 #include "Photogrammetry/SpaceIntersection.hpp"
+#include "Photogrammetry/Orthorectify.hpp"
+#include "Photogrammetry/ContinuousRelativeOrientate.hpp"
+#include "Photogrammetry/AbsoluteOrientate.hpp"
 
 #if (AGTB_NOTE)
 #warning "Parameters for algorithms in [ AGTB::Photogrammetry ] are recommmeded to be of `m`"
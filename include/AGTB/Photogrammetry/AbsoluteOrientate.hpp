@@ -0,0 +1,320 @@
+#ifndef __AGTB_PHOTOGRAMMETRY_ABSOLUTE_ORIENTATE_HPP__
+#define __AGTB_PHOTOGRAMMETRY_ABSOLUTE_ORIENTATE_HPP__
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <algorithm>
+#include <span>
+#include <vector>
+#include <format>
+#include <sstream>
+
+#include "../details/Macros.hpp"
+#include "../IO/Eigen.hpp"
+#include "../Utils/Parallel.hpp"
+#include "../Utils/CpuDispatch.hpp"
+#include "Base.hpp"
+
+AGTB_PHOTOGRAMMETRY_BEGIN
+
+/**
+ * @brief 7-parameter spatial similarity from model to ground, `ground = Lambda * R(Phi, Omega, Kappa) * model + (X, Y, Z)`.
+ * `R` follows `Linalg::CsRotationMatrix<Y, X, Z>`.
+ *
+ */
+struct AbsoluteOrientationElements
+{
+    double X, Y, Z, Lambda, Phi, Omega, Kappa;
+
+    std::string ToString() const noexcept
+    {
+        return std::format("X : {}\nY : {}\nZ : {}\nLambda : {}\nPhi : {}\nOmega : {}\nKappa : {}\n",
+                           X, Y, Z, Lambda, Phi, Omega, Kappa);
+    }
+};
+
+namespace detail::AbsoluteOrientate
+{
+    using Points = Linalg::Coordinates;
+    using PointsRef = Eigen::Ref<const Points>;
+    using Linalg::Matrix3;
+    using Vector3 = Eigen::Vector3d;
+    using Matrix7 = Eigen::Matrix<double, 7, 7>;
+    using Vector7 = Eigen::Matrix<double, 7, 1>;
+
+    /**
+     * @brief Homologous points in model (`model`) and ground (`ground`) system, N x 3 each with N >= 3.
+     * Row-major buffers are referenced without copy.
+     *
+     */
+    struct Param
+    {
+        PointsRef model, ground;
+    };
+
+    struct Result
+    {
+        AbsoluteOrientationElements elements;
+        Matrix3 rotate;
+        Matrix7 sigma;
+        double m0;
+        IterativeSolutionInfo info;
+
+        std::string ToString() const noexcept
+        {
+            std::string sb{};
+            auto sbb = std::back_inserter(sb);
+
+            std::format_to(sbb,
+                           "{:=^100}\n"
+                           "AbsoluteOrientationElements:\n{}\n"
+                           "Median Error:\n{}\n",
+                           " AbsoluteOrientateResult ",
+                           elements.ToString(), m0);
+
+            std::ostringstream oss;
+            oss << "Final Rotation:\n"
+                << rotate.format(IO::EigenFmt::python_style) << "\n"
+                << "Error Matrix:\n"
+                << sigma.format(IO::EigenFmt::python_style) << "\n";
+            sb.append(oss.str());
+
+            return sb;
+        }
+    };
+
+    bool IsInputValid(const Param &param)
+    {
+        return param.model.rows() == param.ground.rows() && param.model.rows() >= 3;
+    }
+
+    /**
+     * @brief `Ry(phi) * Rx(omega) * Rz(kappa)` and its partial derivatives
+     *
+     */
+    struct RotationAndDerivatives
+    {
+        Matrix3 R, dPhi, dOmega, dKappa;
+
+        RotationAndDerivatives(double phi, double omega, double kappa)
+        {
+            const double
+                sp = std::sin(phi), cp = std::cos(phi),
+                sw = std::sin(omega), cw = std::cos(omega),
+                sk = std::sin(kappa), ck = std::cos(kappa);
+            const Matrix3
+                Ry = Linalg::Fixed::RotateY(phi),
+                Rx = Linalg::Fixed::RotateX(omega),
+                Rz = Linalg::Fixed::RotateZ(kappa);
+            Matrix3 dRy, dRx, dRz;
+            dRy << -sp, 0, -cp, 0, 0, 0, cp, 0, -sp;
+            dRx << 0, 0, 0, 0, -sw, -cw, 0, cw, -sw;
+            dRz << -sk, -ck, 0, ck, -sk, 0, 0, 0, 0;
+            R = Ry * Rx * Rz;
+            dPhi = dRy * Rx * Rz;
+            dOmega = Ry * dRx * Rz;
+            dKappa = Ry * Rx * dRz;
+        }
+    };
+
+    /**
+     * @brief Angles of `R = Ry(phi) * Rx(omega) * Rz(kappa)`
+     *
+     */
+    void AnglesOf(const Matrix3 &R, double &phi, double &omega, double &kappa)
+    {
+        omega = std::asin(std::clamp(-R(1, 2), -1.0, 1.0));
+        phi = std::atan2(-R(0, 2), R(2, 2));
+        kappa = std::atan2(R(1, 0), R(1, 1));
+    }
+
+    /**
+     * @brief Closed-form similarity (Horn / Umeyama) by SVD of 3 x 3 cross covariance
+     *
+     * @return false if points are degenerated (collinear or coincident)
+     */
+    bool ClosedForm(const Param &param, AbsoluteOrientationElements &elements)
+    {
+        const auto &model = param.model;
+        const auto &ground = param.ground;
+        const double n = static_cast<double>(model.rows());
+
+        const Vector3
+            mc = model.colwise().sum().transpose() / n,
+            gc = ground.colwise().sum().transpose() / n;
+
+        Matrix3 H = Matrix3::Zero();
+        double model_var = 0.0;
+        for (Eigen::Index i = 0; i != model.rows(); ++i)
+        {
+            const Vector3
+                m = model.row(i).transpose() - mc,
+                g = ground.row(i).transpose() - gc;
+            H.noalias() += g * m.transpose();
+            model_var += m.squaredNorm();
+        }
+
+        const Eigen::JacobiSVD<Matrix3> svd(H, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        const Vector3 &s = svd.singularValues();
+        if (!(model_var > 0.0) || !(s(1) > s(0) * 1e-12))
+        {
+            return false;
+        }
+
+        Vector3 d(1.0, 1.0, (svd.matrixU() * svd.matrixV().transpose()).determinant() < 0 ? -1.0 : 1.0);
+        const Matrix3 R = svd.matrixU() * d.asDiagonal() * svd.matrixV().transpose();
+        const double lambda = s.dot(d) / model_var;
+        const Vector3 T = gc - lambda * R * mc;
+
+        elements.X = T(0);
+        elements.Y = T(1);
+        elements.Z = T(2);
+        elements.Lambda = lambda;
+        AnglesOf(R, elements.Phi, elements.Omega, elements.Kappa);
+        return true;
+    }
+
+    void UpdateElements(AbsoluteOrientationElements &elements, const Vector7 &correction)
+    {
+        elements.X += correction(0);
+        elements.Y += correction(1);
+        elements.Z += correction(2);
+        elements.Lambda += correction(3);
+        elements.Phi += correction(4);
+        elements.Omega += correction(5);
+        elements.Kappa += correction(6);
+    }
+
+    /**
+     * @brief Accumulate 7 x 7 normal equations point by point, nothing of size N is formed. Dispatched per CPU level.
+     *
+     */
+    AGTB_MULTIVERSION double Accumulate(const Param &param, const AbsoluteOrientationElements &elements, const RotationAndDerivatives &rd, Matrix7 &N, Vector7 &W)
+    {
+        N.setZero();
+        W.setZero();
+        double vv = 0.0;
+        const Vector3 T(elements.X, elements.Y, elements.Z);
+        const double lambda = elements.Lambda;
+
+        Eigen::Matrix<double, 3, 7> J;
+        J.leftCols<3>().setIdentity();
+        for (Eigen::Index i = 0; i != param.model.rows(); ++i)
+        {
+            const Vector3
+                m = param.model.row(i).transpose(),
+                g = param.ground.row(i).transpose(),
+                Rm = rd.R * m,
+                l = g - (lambda * Rm + T);
+            J.col(3) = Rm;
+            J.col(4) = lambda * (rd.dPhi * m);
+            J.col(5) = lambda * (rd.dOmega * m);
+            J.col(6) = lambda * (rd.dKappa * m);
+            N.noalias() += J.transpose() * J;
+            W.noalias() += J.transpose() * l;
+            vv += l.squaredNorm();
+        }
+        return vv;
+    }
+
+    inline const bool accumulate_registered =
+        Utils::detail::CpuDispatch::Register("Photogrammetry::AbsoluteOrientate::Accumulate", Utils::detail::CpuDispatch::Kind::Clones);
+}
+
+/**
+ * @brief All in one absolute orientation solver. Closed-form initial value refined by least squares, all math is
+ * fixed-size so a solve does not touch heap.
+ *
+ */
+struct AbsoluteOrientate
+{
+    using Points = detail::AbsoluteOrientate::Points;
+    using Param = detail::AbsoluteOrientate::Param;
+    using Result = detail::AbsoluteOrientate::Result;
+
+    static Result Solve(const Param &param, size_t max_loop = 10, const double threshold = 1e-10)
+    {
+        using namespace detail::AbsoluteOrientate;
+
+        if (!IsInputValid(param))
+        {
+            AGTB_THROW(std::invalid_argument,
+                       std::format("Expect two N x 3 with N >= 3 but get {} and {} points", param.model.rows(), param.ground.rows()));
+        }
+
+        Result result{.info = IterativeSolutionInfo::NotConverged};
+        AbsoluteOrientationElements &elements = result.elements;
+        if (!ClosedForm(param, elements))
+        {
+            result.info = IterativeSolutionInfo::Failed;
+            return result;
+        }
+
+        Matrix7 N;
+        Vector7 W;
+        const double dof = 3.0 * param.model.rows() - 7.0;
+        while (max_loop-- > 0)
+        {
+            const RotationAndDerivatives rd(elements.Phi, elements.Omega, elements.Kappa);
+            Accumulate(param, elements, rd, N, W);
+            const Eigen::LDLT<Matrix7> ldlt(N);
+            const Vector7 correction = ldlt.solve(W);
+            if (ldlt.info() != Eigen::Success || !correction.allFinite())
+            {
+                result.info = IterativeSolutionInfo::Failed;
+                break;
+            }
+
+            UpdateElements(elements, correction);
+
+            if (correction.cwiseAbs().maxCoeff() <= threshold * std::max(1.0, std::abs(elements.Lambda)))
+            {
+                const RotationAndDerivatives final_rd(elements.Phi, elements.Omega, elements.Kappa);
+                const double vv = Accumulate(param, elements, final_rd, N, W);
+                result.rotate = final_rd.R;
+                result.m0 = dof > 0 ? std::sqrt(vv / dof) : 0.0;
+                result.sigma = result.m0 * Matrix7(N.ldlt().solve(Matrix7::Identity())).cwiseSqrt();
+                result.info = IterativeSolutionInfo::Success;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Orient many models in parallel into caller-provided `results`, no allocation per model
+     *
+     * @param params
+     * @param results same size as `params`
+     * @param n_threads `0` means all hardware threads
+     */
+    static void SolveBatch(std::span<const Param> params, std::span<Result> results,
+                           size_t max_loop = 10, const double threshold = 1e-10, size_t n_threads = 0)
+    {
+        if (params.size() != results.size())
+        {
+            AGTB_THROW(std::invalid_argument, std::format("{} params but {} results", params.size(), results.size()));
+        }
+
+        Utils::ParallelFor(
+            params.size(),
+            [&](size_t i)
+            {
+                results[i] = Solve(params[i], max_loop, threshold);
+            },
+            n_threads);
+    }
+
+    static std::vector<Result> SolveBatch(std::span<const Param> params,
+                                          size_t max_loop = 10, const double threshold = 1e-10, size_t n_threads = 0)
+    {
+        std::vector<Result> results(params.size());
+        SolveBatch(params, results, max_loop, threshold, n_threads);
+        return results;
+    }
+};
+
+AGTB_PHOTOGRAMMETRY_END
+
+#endif
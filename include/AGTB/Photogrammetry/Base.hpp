@@ -24,9 +24,65 @@ enum class IterativeSolutionInfo : size_t
     Unknown
 };
 
+/**
+ * @brief Brown-Conrady lens distortion, radial `k1, k2, k3` and tangential (decentering) `p1, p2`. Parameters are
+ * calibrated as corrections of measured image coordinates reduced to principal point, so undistortion is a direct
+ * evaluation: `x = x_measured - dx(x_measured - x0, y_measured - y0)`.
+ *
+ */
+struct BrownConradyDistortion
+{
+    double k1{0.0}, k2{0.0}, k3{0.0}, p1{0.0}, p2{0.0};
+
+    bool IsZero() const noexcept
+    {
+        return k1 == 0.0 && k2 == 0.0 && k3 == 0.0 && p1 == 0.0 && p2 == 0.0;
+    }
+
+    /**
+     * @brief Distortion at `(xr, yr)`, coordinates reduced to principal point
+     *
+     * @param xr
+     * @param yr
+     * @param dx
+     * @param dy
+     */
+    void Of(double xr, double yr, double &dx, double &dy) const noexcept
+    {
+        const double
+            xx = xr * xr,
+            yy = yr * yr,
+            xy = xr * yr,
+            r2 = xx + yy,
+            radial = r2 * (k1 + r2 * (k2 + r2 * k3));
+        dx = xr * radial + p1 * (r2 + 2.0 * xx) + 2.0 * p2 * xy;
+        dy = yr * radial + p2 * (r2 + 2.0 * yy) + 2.0 * p1 * xy;
+    }
+
+    std::string ToString() const noexcept
+    {
+        return std::format("k1 : {}\nk2 : {}\nk3 : {}\np1 : {}\np2 : {}\n", k1, k2, k3, p1, p2);
+    }
+};
+
 struct InteriorOrientationElements
 {
     double x0{0.0}, y0{0.0}, f{0.0}, m{0};
+    BrownConradyDistortion distortion{};
+
+    /**
+     * @brief Remove lens distortion of one measured image point in place
+     *
+     * @param x
+     * @param y
+     */
+    void Undistort(double &x, double &y) const noexcept
+    {
+        double dx, dy;
+        distortion.Of(x - x0, y - y0, dx, dy);
+        x -= dx;
+        y -= dy;
+    }
 
     std::string ToString() const noexcept
     {
@@ -35,6 +91,10 @@ struct InteriorOrientationElements
         std::format_to(sbb,
                        "f : {}\nm : {}\nx0 : {}\ny0 : {}\n",
                        f, m, x0, y0);
+        if (!distortion.IsZero())
+        {
+            sb.append(distortion.ToString());
+        }
         return sb;
     }
 };
@@ -72,7 +132,13 @@ struct ExteriorOrientationElements
     template <Linalg::Axis ax1, Linalg::Axis ax2, Linalg::Axis ax3>
     Matrix ToRotationMatrix() const noexcept
     {
-        return Linalg::CsRotationMatrix<ax1, ax2, ax3>(Phi, Omega, Kappa);
+        return ToFixedRotationMatrix<ax1, ax2, ax3>();
+    }
+
+    template <Linalg::Axis ax1, Linalg::Axis ax2, Linalg::Axis ax3>
+    Linalg::Matrix3 ToFixedRotationMatrix() const noexcept
+    {
+        return Linalg::Fixed::CsRotationMatrix<ax1, ax2, ax3>(Phi, Omega, Kappa);
     }
 };
 
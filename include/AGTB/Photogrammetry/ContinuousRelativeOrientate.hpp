@@ -2,18 +2,17 @@
 #define __AGTB_CONTINUOUS_RELATIVE_ORIENTATE_HPP__
 
 #include "Base.hpp"
-#include "../Linalg/CorrectionOlsSolve.hpp"
-#include "../Linalg/NormalEquationMatrixInverse.hpp"
+#include "SpaceMath/Distortion.hpp"
 #include "../Adjustment/ErrorMeasure.hpp"
 #include "../IO/Eigen.hpp"
+#include "../Utils/Parallel.hpp"
 
-#include <gcem.hpp>
-#include <tuple>
+#include <cmath>
+#include <span>
+#include <vector>
 #include <format>
 #include <sstream>
 
-AGTB_FILE_NOT_IMPLEMENT();
-
 AGTB_PHOTOGRAMMETRY_BEGIN
 
 namespace ContinuousRelativeOrientate
@@ -28,12 +27,16 @@ namespace ContinuousRelativeOrientate
                                "Mu = {}\n"
                                "Nu = {}\n"
                                "Phi = {}\n"
-                               "Omega = {}"
+                               "Omega = {}\n"
                                "Kappa = {}\n",
                                " Continuous Relative Orientation Elements ", Mu, Nu, Phi, Omega, Kappa);
         }
     };
 
+    /**
+     * @brief Image plane coordinates of tie points on left (`xy1`) and right (`xy2`) photo, N x 2 each
+     *
+     */
     struct ContinuousRelativeOrienteParam
     {
         Matrix xy1, xy2;
@@ -61,53 +64,64 @@ namespace ContinuousRelativeOrientate
         }
     };
 
+    using Matrix5 = Eigen::Matrix<double, 5, 5>;
+    using Vector5 = Eigen::Matrix<double, 5, 1>;
+    using Coefficient = Eigen::Matrix<double, Eigen::Dynamic, 5>;
+
+    /**
+     * @brief Image space auxiliary coordinates of both photos, N x 6 as `[X1, Y1, Z1, X2, Y2, Z2]`. Left photo is
+     * fixed, right one is rotated by `(Phi, Omega, Kappa)` of `YXZ` order.
+     *
+     */
     Matrix CalculateImageSpaceCoordinates(const Matrix &xy1, const Matrix &xy2, const InteriorOrientationElements &in1, const InteriorOrientationElements &in2, const ContinuousRelativeOrientationElements &cro)
     {
-        Matrix ipc(6, xy1.cols());
-        ipc.leftCols(2) = xy1;
-        ipc.col(2).array() = -in1.f;
-        ipc.col(3) = xy2.col(0);
-        ipc.col(4) = xy2.col(1);
-        ipc.col(5).array() = -in2.f;
-
-        Matrix rotate = Linalg::CsRotationMatrix<Linalg::Axis::Y, Linalg::Axis::X, Linalg::Axis::Z>(cro.Phi, cro.Omega, cro.Kappa);
-        // rotate(matrix) : ImgSp_1 -> ImgSp_2
-        ipc.rightCols(3) = Linalg::CsRotateInverse(ipc.rightCols(3), rotate); // ImgSp2 -> ImgSp1 : Inverse
+        const Linalg::Matrix3 rotate = Linalg::Fixed::CsRotationMatrix<Linalg::Axis::Y, Linalg::Axis::X, Linalg::Axis::Z>(cro.Phi, cro.Omega, cro.Kappa);
+        const auto x2 = xy2.col(0).array(), y2 = xy2.col(1).array();
+        const double f2 = in2.f;
 
+        Matrix ipc(xy1.rows(), 6);
+        ipc.leftCols(2) = xy1;
+        ipc.col(2).setConstant(-in1.f);
+        // aux = rotate * isp
+        for (Eigen::Index r = 0; r != 3; ++r)
+        {
+            ipc.col(3 + r).array() = rotate(r, 0) * x2 + rotate(r, 1) * y2 - rotate(r, 2) * f2;
+        }
         return ipc;
     }
 
-    auto ContinuousRelativeOrientateCoefficientAndConstants(const Matrix &xy1, const Matrix &xy2, const Matrix &ipc, const ContinuousRelativeOrientationElements &ore)
+    /**
+     * @brief Coplanarity coefficients and constants of all points at once, `v = A * d - Q`. `Bx` is a model
+     * constant, the mean x-parallax.
+     *
+     * @param ipc from `CalculateImageSpaceCoordinates`
+     * @param Bx
+     * @param cro
+     * @param A N x 5, written
+     * @param Q N x 1, written
+     */
+    void ContinuousRelativeOrientateCoefficientAndConstants(const Matrix &ipc, double Bx, const ContinuousRelativeOrientationElements &cro, Coefficient &A, Eigen::VectorXd &Q)
     {
-        Matrix coeff(ipc.rows(), 5);
-        Matrix consts(ipc.rows(), 1);
-
-        for (auto i = 0; i != ipc.rows(); ++i)
-        {
-            auto xy1_i = xy1.row(i),
-                 xy2_i = xy2.row(i),
-                 ipc_i = ipc.row(i);
-            double x1 = xy1_i(0), x2 = xy2_i(0),
-                   X1 = ipc_i(0), Y1 = ipc_i(1), Z1 = ipc(2),
-                   X2 = ipc_i(3), Y2 = ipc_i(4), Z2 = ipc(5);
-            double Bx = x1 - x2, By = Bx * ore.Mu, Bz = Bx * ore.Nu;
-            double N1 = (Bx * Z2 - Bz * X2) / (X1 * Z2 - Z1 * X2),
-                   N2 = (Bx * Z1 - Bz * X1) / (X1 * Z2 - Z1 * X2);
-            double const_i = N1 * Y1 - (N2 * Y2 + By);
-            double
-                c_mu = Bx,
-                c_nu = -Y2 / Z2 * Bx,
-                c_phi = -X2 * Y2 / Z2 * N2,
-                c_omega = -(Z2 * gcem::pow(Y2, 2) / Z2) * N2,
-                c_kappa = X2 * N2;
-            consts.row(i) << const_i;
-            coeff.row(i) << c_mu, c_nu, c_phi, c_omega, c_kappa;
-        }
-
-        return std::make_tuple(coeff, consts);
+        const auto
+            X1 = ipc.col(0).array(), Y1 = ipc.col(1).array(), Z1 = ipc.col(2).array(),
+            X2 = ipc.col(3).array(), Y2 = ipc.col(4).array(), Z2 = ipc.col(5).array();
+        const double By = Bx * cro.Mu, Bz = Bx * cro.Nu;
+
+        const Eigen::ArrayXd
+            den = X1 * Z2 - X2 * Z1,
+            N1 = (Bx * Z2 - Bz * X2) / den,
+            N2 = (Bx * Z1 - Bz * X1) / den,
+            Y2_Z2 = Y2 / Z2;
+
+        Q.array() = N1 * Y1 - N2 * Y2 - By;
+        A.col(0).setConstant(Bx);
+        A.col(1).array() = -Bx * Y2_Z2;
+        A.col(2).array() = -X2 * Y2_Z2 * N2;
+        A.col(3).array() = -(Z2 + Y2 * Y2_Z2) * N2;
+        A.col(4).array() = X2 * N2;
     }
 
-    void UpdateContinuousRelativeOrientationElements(ContinuousRelativeOrientationElements &cro, const Matrix &correction)
+    void UpdateContinuousRelativeOrientationElements(ContinuousRelativeOrientationElements &cro, const Vector5 &correction)
     {
         cro.Mu += correction(0);
         cro.Nu += correction(1);
@@ -116,29 +130,38 @@ namespace ContinuousRelativeOrientate
         cro.Kappa += correction(4);
     }
 
-    bool IsContinuousRelativeOrientationElementsConverged(const Matrix &correction, double threshold)
+    bool IsContinuousRelativeOrientationElementsConverged(const Vector5 &correction, double threshold)
     {
-        for (auto i = 0; i != correction.size(); ++i)
-        {
-            if (gcem::abs(correction(i)) > threshold)
-            {
-                return false;
-            }
-        }
-        return true;
+        return correction.cwiseAbs().maxCoeff() <= threshold;
     }
 
+    /**
+     * @brief Continuous relative orientation of a stereo pair. Coefficients are built column-wise and reduced to
+     * 5 x 5 normal equations by a rank update, so cost per iteration is a few passes over N x 5.
+     *
+     * @tparam opt inverse method of normal equation for `sigma`
+     * @param param
+     * @param max_loop
+     * @param threshold
+     * @return ContinuousRelativeOrienteResult
+     */
     template <Linalg::LinalgOption opt = Linalg::LinalgOption::Cholesky>
     ContinuousRelativeOrienteResult Solve(const ContinuousRelativeOrienteParam &param, int max_loop = 50, double threshold = 3e-5)
     {
-        auto &xy1 = param.xy1, xy2 = param.xy2;
-        auto &in1 = param.in1, in2 = param.in2;
+        auto &in1 = param.in1, &in2 = param.in2;
 
-        if (!(xy1.rows() != 0 && xy2.rows() != 0 && xy1.cols() == xy2.cols() && xy1.cols() > 5))
+        if (!(param.xy1.rows() == param.xy2.rows() && param.xy1.rows() > 5 && param.xy1.cols() == 2 && param.xy2.cols() == 2))
         {
-            AGTB_THROW(std::invalid_argument, "Input coordinate must have same count and larger than 5.");
+            // 5 unknowns, `m0` needs at least one redundant observation
+            AGTB_THROW(std::invalid_argument, "Input coordinate must be of N x 2, have same count and more than 5.");
         }
 
+        const Matrix
+            xy1 = Distortion::Undistort(param.xy1, in1),
+            xy2 = Distortion::Undistort(param.xy2, in2);
+        const Eigen::Index n = xy1.rows();
+        const double Bx = (xy1.col(0) - xy2.col(0)).mean();
+
         ContinuousRelativeOrienteResult cro_res{
             .cro = {
                 .Mu = 0,
@@ -149,22 +172,38 @@ namespace ContinuousRelativeOrientate
             .info = IterativeSolutionInfo::NotConverged};
         ContinuousRelativeOrientationElements &cro = cro_res.cro;
 
+        Coefficient A(n, 5);
+        Eigen::VectorXd Q(n);
+        Matrix5 N;
+
         while (max_loop-- > 0)
         {
-            Matrix left_ImageSpaceCoordinate = CalculateImageSpaceCoordinates(xy1, xy2, in1, in2, cro);
-            auto [A, L] =
-                ContinuousRelativeOrientateCoefficientAndConstants(xy1, xy2, left_ImageSpaceCoordinate, cro);
+            const Matrix ipc = CalculateImageSpaceCoordinates(xy1, xy2, in1, in2, cro);
+            ContinuousRelativeOrientateCoefficientAndConstants(ipc, Bx, cro, A, Q);
 
-            Matrix correction = Linalg::CorrectionOlsSolve(A, L);
+            N.setZero();
+            N.selfadjointView<Eigen::Lower>().rankUpdate(A.transpose());
+            N.triangularView<Eigen::StrictlyUpper>() = N.transpose();
+            const Vector5 W = A.transpose() * Q;
+            const Eigen::LDLT<Matrix5> ldlt(N);
+            const Vector5 correction = ldlt.solve(W);
+
+            if (ldlt.info() != Eigen::Success || !correction.allFinite())
+            {
+                cro_res.info = IterativeSolutionInfo::Failed;
+                break;
+            }
 
             UpdateContinuousRelativeOrientationElements(cro, correction);
 
             if (IsContinuousRelativeOrientationElementsConverged(correction, threshold))
             {
-                Matrix N = Linalg::NormalEquationMatrixInverse<opt>(A);
-                Matrix V = A * correction - L;
-                cro_res.m0 = Adjustment::MeanRootSquareError(V, xy1.rows(), 5);
-                cro_res.sigma = Adjustment::ErrorMatrix(cro_res.m0, N);
+                const Eigen::VectorXd V = A * correction - Q;
+                const Matrix Ninv = opt == Linalg::LinalgOption::SVD
+                                        ? Matrix(N.completeOrthogonalDecomposition().pseudoInverse())
+                                        : Matrix(ldlt.solve(Matrix5::Identity()));
+                cro_res.m0 = std::sqrt(V.squaredNorm() / (n - 5));
+                cro_res.sigma = Adjustment::ErrorMatrix(cro_res.m0, Ninv);
                 cro_res.info = IterativeSolutionInfo::Success;
                 break;
             }
@@ -172,13 +211,38 @@ namespace ContinuousRelativeOrientate
 
         return cro_res;
     }
+
+    /**
+     * @brief Solve many independent stereo pairs in parallel, results keep order of `params`
+     *
+     * @tparam opt
+     * @param params
+     * @param max_loop
+     * @param threshold
+     * @param n_threads `0` means all hardware threads
+     * @return std::vector<ContinuousRelativeOrienteResult>
+     */
+    template <Linalg::LinalgOption opt = Linalg::LinalgOption::Cholesky>
+    std::vector<ContinuousRelativeOrienteResult> SolveBatch(std::span<const ContinuousRelativeOrienteParam> params, int max_loop = 50, double threshold = 3e-5, size_t n_threads = 0)
+    {
+        std::vector<ContinuousRelativeOrienteResult> results(params.size());
+        Utils::ParallelFor(
+            params.size(),
+            [&](size_t i)
+            {
+                results[i] = Solve<opt>(params[i], max_loop, threshold);
+            },
+            n_threads);
+        return results;
+    }
 }
 
 using ContinuousRelativeOrientate::ContinuousRelativeOrientationElements;
 using ContinuousRelativeOrientate::ContinuousRelativeOrienteParam;
 using ContinuousRelativeOrientate::ContinuousRelativeOrienteResult;
 using ContinuousRelativeOrientate::Solve;
+using ContinuousRelativeOrientate::SolveBatch;
 
 AGTB_PHOTOGRAMMETRY_END
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,220 @@
+#ifndef __AGTB_PHOTOGRAMMETRY_ORTHORECTIFY_HPP__
+#define __AGTB_PHOTOGRAMMETRY_ORTHORECTIFY_HPP__
+
+#include <Eigen/Dense>
+#include <chrono>
+#include <format>
+#include <string>
+
+#include "../details/Macros.hpp"
+#include "../Utils/Parallel.hpp"
+#include "Base.hpp"
+#include "SpaceMath/Transform.hpp"
+
+AGTB_PHOTOGRAMMETRY_BEGIN
+
+namespace detail::Orthorectify
+{
+    using RasterMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /**
+     * @brief Regular DEM grid, not owning. Cell `(r, c)` is at `X = X0 + c * dX`, `Y = Y0 + r * dY`, `Z = Z(r, c)`.
+     * `dY` is usually negative for north-up rasters.
+     *
+     */
+    struct DemGrid
+    {
+        double X0, Y0, dX, dY;
+        Eigen::Map<const RasterMatrix> Z;
+    };
+
+    /**
+     * @brief Output raster of image coordinates, same shape as DEM. Caller owns the buffers, so they may be
+     * mapped files as well.
+     *
+     */
+    struct ImageRaster
+    {
+        Eigen::Map<RasterMatrix> x, y;
+    };
+
+    struct Param
+    {
+        DemGrid dem;
+        ExteriorOrientationElements exterior;
+        InteriorOrientationElements interior;
+        ImageRaster image;
+    };
+
+    /**
+     * @brief Tile shape is in cells. Default tile keeps DEM, `x` and `y` of one tile (768 KiB) in L2.
+     *
+     */
+    struct Options
+    {
+        Eigen::Index tile_rows{64}, tile_cols{512};
+        size_t threads{0};
+    };
+
+    struct Result
+    {
+        size_t cells, tiles, threads;
+        double seconds;
+
+        double CellsPerSecond() const noexcept
+        {
+            return seconds > 0 ? cells / seconds : 0.0;
+        }
+
+        std::string ToString() const noexcept
+        {
+            return std::format("{:=^100}\n"
+                               "Cells : {}\nTiles : {}\nThreads : {}\nSeconds : {}\nCells/s : {:.4e}\n",
+                               " OrthorectifyResult ",
+                               cells, tiles, threads, seconds, CellsPerSecond());
+        }
+    };
+
+    struct Coefficients
+    {
+        double a1, a2, a3, b1, b2, b3, c1, c2, c3, Xs, Ys, Zs, f;
+    };
+
+    template <Transform::RotationOrderPolicy __rotation_order>
+    Coefficients MakeCoefficients(const ExteriorOrientationElements &ex, const InteriorOrientationElements &in)
+    {
+        const Linalg::Matrix3 rotate = __rotation_order::Of(ex);
+        return Coefficients{
+            .a1 = rotate(0, 0), .a2 = rotate(0, 1), .a3 = rotate(0, 2),
+            .b1 = rotate(1, 0), .b2 = rotate(1, 1), .b3 = rotate(1, 2),
+            .c1 = rotate(2, 0), .c2 = rotate(2, 1), .c3 = rotate(2, 2),
+            .Xs = ex.Xs, .Ys = ex.Ys, .Zs = ex.Zs,
+            .f = in.f};
+    }
+
+    bool IsInputValid(const Param &param, const Options &options)
+    {
+        const auto &Z = param.dem.Z;
+        const auto &img = param.image;
+        return Z.rows() == img.x.rows() && Z.cols() == img.x.cols() &&
+               Z.rows() == img.y.rows() && Z.cols() == img.y.cols() &&
+               options.tile_rows > 0 && options.tile_cols > 0;
+    }
+
+    /**
+     * @brief Back-project cells `[row_begin, row_end) x [col_begin, col_end)`. Along a row only `X` changes, so
+     * the planimetric part of the three collinearity terms (numerators and denominator) steps by a constant;
+     * it is reseeded at the start of every tile row, which bounds the accumulated rounding to one tile width.
+     *
+     */
+    void ProjectTile(const Coefficients &k, const DemGrid &dem, ImageRaster &img,
+                     Eigen::Index row_begin, Eigen::Index row_end,
+                     Eigen::Index col_begin, Eigen::Index col_end)
+    {
+        const double
+            step_x = k.a1 * dem.dX,
+            step_y = k.a2 * dem.dX,
+            step_z = k.a3 * dem.dX,
+            dX0 = dem.X0 + col_begin * dem.dX - k.Xs;
+        const Eigen::Index width = col_end - col_begin;
+
+        for (Eigen::Index r = row_begin; r != row_end; ++r)
+        {
+            const double dY = dem.Y0 + r * dem.dY - k.Ys;
+            double
+                num_x = k.a1 * dX0 + k.b1 * dY,
+                num_y = k.a2 * dX0 + k.b2 * dY,
+                den = k.a3 * dX0 + k.b3 * dY;
+
+            const double *z = dem.Z.data() + r * dem.Z.outerStride() + col_begin;
+            double *out_x = img.x.data() + r * img.x.outerStride() + col_begin,
+                   *out_y = img.y.data() + r * img.y.outerStride() + col_begin;
+
+            for (Eigen::Index c = 0; c != width; ++c)
+            {
+                const double
+                    dZ = z[c] - k.Zs,
+                    scale = -k.f / (den + k.c3 * dZ);
+                out_x[c] = scale * (num_x + k.c1 * dZ);
+                out_y[c] = scale * (num_y + k.c2 * dZ);
+                num_x += step_x;
+                num_y += step_y;
+                den += step_z;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tiled, multi-threaded DEM back-projection for orthophoto production. Every DEM cell is mapped to image
+ * coordinates with the same convention as `Transform::Obj2Img`; tiles are distributed over threads and each
+ * writes its own block of the output raster.
+ *
+ */
+struct Orthorectify
+{
+    using RasterMatrix = detail::Orthorectify::RasterMatrix;
+    using DemGrid = detail::Orthorectify::DemGrid;
+    using ImageRaster = detail::Orthorectify::ImageRaster;
+    using Param = detail::Orthorectify::Param;
+    using Options = detail::Orthorectify::Options;
+    using Result = detail::Orthorectify::Result;
+
+    template <Transform::RotationOrderPolicy __rotation_order = Transform::YXZ>
+    static Result Solve(const Param &param, const Options &options = {})
+    {
+        using namespace detail::Orthorectify;
+
+        if (!IsInputValid(param, options))
+        {
+            AGTB_THROW(std::invalid_argument,
+                       std::format("DEM ({}, {}) and image raster ({}, {}) / ({}, {}) mismatch, or empty tile",
+                                   param.dem.Z.rows(), param.dem.Z.cols(),
+                                   param.image.x.rows(), param.image.x.cols(),
+                                   param.image.y.rows(), param.image.y.cols()));
+        }
+
+        const Coefficients k = MakeCoefficients<__rotation_order>(param.exterior, param.interior);
+        const DemGrid &dem = param.dem;
+        ImageRaster img = param.image;
+
+        const Eigen::Index
+            rows = dem.Z.rows(),
+            cols = dem.Z.cols(),
+            tile_rows = options.tile_rows,
+            tile_cols = options.tile_cols,
+            n_tile_rows = (rows + tile_rows - 1) / tile_rows,
+            n_tile_cols = (cols + tile_cols - 1) / tile_cols;
+        const size_t
+            n_tiles = n_tile_rows * n_tile_cols,
+            n_threads = std::min(options.threads == 0 ? Utils::HardwareThreads() : options.threads,
+                                 std::max<size_t>(n_tiles, 1));
+
+        const auto start = std::chrono::steady_clock::now();
+        Utils::ParallelFor(
+            n_tiles,
+            [&](size_t tile)
+            {
+                const Eigen::Index
+                    tr = tile / n_tile_cols,
+                    tc = tile % n_tile_cols,
+                    r0 = tr * tile_rows,
+                    c0 = tc * tile_cols;
+                ProjectTile(k, dem, img,
+                            r0, std::min(r0 + tile_rows, rows),
+                            c0, std::min(c0 + tile_cols, cols));
+            },
+            n_threads);
+        const std::chrono::duration<double> costing = std::chrono::steady_clock::now() - start;
+
+        return Result{
+            .cells = static_cast<size_t>(rows * cols),
+            .tiles = n_tiles,
+            .threads = n_threads,
+            .seconds = costing.count()};
+    }
+};
+
+AGTB_PHOTOGRAMMETRY_END
+
+#endif
@@ -6,22 +6,13 @@
 #include "SpaceResection.hpp"
 
 #include <span>
+#include <tuple>
 
 AGTB_PHOTOGRAMMETRY_BEGIN
 
 namespace detail::SpaceIntersection
 {
-    using detail::SpaceResection::Equation;
-    using detail::SpaceResection::ResidualMatrix;
     using detail::SpaceResection::Simplify;
-
-    template <Simplify __simplify>
-    Matrix SpaceIntersectionNegativeCoefficient(const Matrix &rotate, const Matrix &transformed_obj, const Matrix &transformed_photo, const ExteriorOrientationElements &exterior, const InteriorOrientationElements &internal)
-    {
-        using detail::SpaceResection::SpaceResectionCoefficient;
-
-        return SpaceResectionCoefficient<__simplify>(rotate, transformed_obj, transformed_photo, exterior, internal).leftCols(3);
-    }
 }
 
 /**
@@ -63,9 +54,15 @@ struct SpaceIntersection
      */
     static Result Solve(const Param &left, const Param &right)
     {
+        double
+            x_left = left.x, y_left = left.y,
+            x_right = right.x, y_right = right.y;
+        left.in.Undistort(x_left, y_left);
+        right.in.Undistort(x_right, y_right);
+
         Matrix isp_left(1, 3), isp_right(1, 3);
-        isp_left << left.x, left.y, -left.in.f;
-        isp_right << right.x, right.y, -right.in.f;
+        isp_left << x_left, y_left, -left.in.f;
+        isp_right << x_right, y_right, -right.in.f;
         Matrix
             aux_left = Transform::Isp2Aux(isp_left, left.ex),
             aux_right = Transform::Isp2Aux(isp_right, right.ex);
@@ -115,8 +112,8 @@ struct SpaceIntersection
         }
 
         Matrix
-            isp_left = left.image,
-            isp_right = right.image;
+            isp_left = Distortion::Undistort(left.image, left.in),
+            isp_right = Distortion::Undistort(right.image, right.in);
 
         isp_left.conservativeResize(Eigen::NoChange, 3);
         isp_left.col(2).fill(-left.in.f);
@@ -196,28 +193,25 @@ struct SpaceIntersection
 
         while (max_loop-- > 0)
         {
-            Matrix coeff(2 * count, 3), residual(2 * count, 1);
-            for (size_t i = 0uz; i != count; ++i)
+            Linalg::Fixed::NormalEquation<3> ne{};
+            for (const Param &param : list)
             {
-                auto [c, l] = MakeCoefficientAndResidual<__simplify>(list[i], result.coord);
-                coeff.block(2 * i, 0, 2, 3) << c;
-                residual.block(2 * i, 0, 2, 1) << l;
-#if (AGTB_DEBUG) && (AGTB_DEBUG_INFO_LEVEL >= AGTB_DEBUG_INTERNAL_LEVEL)
-                IO::PrintEigen(c, std::format("c[{}]", i));
-                IO::PrintEigen(l, std::format("l[{}]", i));
-#endif
+                ForEachRow<__simplify>(param, result.coord, [&](const auto &a, double l)
+                                       { ne.Add(a, l); });
+            }
+            Eigen::Vector3d correction;
+            if (!ne.Solve(correction))
+            {
+                const auto [coeff, residual] = MakeSystem<__simplify>(list, result.coord);
+                correction = Linalg::CorrectionOlsSolve(coeff, residual);
             }
-#if (AGTB_DEBUG)
-            IO::PrintEigen(coeff, "coeff");
-            IO::PrintEigen(residual, "residual");
-#endif
-            const Matrix correction = Linalg::CorrectionOlsSolve(coeff, residual);
 
             if (std::abs(correction(0, 0)) < threshold &&
                 std::abs(correction(1, 0)) < threshold &&
                 std::abs(correction(2, 0)) < threshold)
             {
                 result.info = IterativeSolutionInfo::Success;
+                const auto [coeff, residual] = MakeSystem<__simplify>(list, result.coord);
                 const Matrix N = Linalg::NormalEquationMatrixInverse<__inverse_method>(coeff);
                 result.m0 = Adjustment::MeanRootSquareError(coeff * correction - residual, count * 2, 3);
                 result.sigma = Adjustment::ErrorMatrix(result.m0, N);
@@ -238,10 +232,16 @@ struct SpaceIntersection
     }
 
 private:
-    template <Simplify __simplify>
-    static auto MakeCoefficientAndResidual(const Param &param, const Result &xyz)
+    /**
+     * @brief Visit the two rows of one photo as `visit(row, l)`, fixed-size and on stack
+     *
+     */
+    template <Simplify __simplify, typename __visit>
+    static void ForEachRow(const Param &param, const Result &xyz, __visit &&visit)
     {
         using namespace detail::SpaceIntersection;
+        using detail::SpaceResection::CoefficientRow;
+        using detail::SpaceResection::ForEachCoefficientRow;
 
         const ExteriorOrientationElements &ex = param.ex;
         const InteriorOrientationElements &in = param.in;
@@ -249,15 +249,42 @@ private:
         const Matrix obj = Transform::XYZ2Mat13(xyz.X, xyz.Y, xyz.Z);
         const Matrix isp = Transform::Aux2Isp(Transform::Obj2Aux(obj, ex), rotate);
         const Matrix img_calc = Transform::Isp2Img(isp, in);
-        const Matrix coeff = SpaceIntersectionNegativeCoefficient<__simplify>(rotate, isp, img_calc, ex, in);
-        const Matrix residual = ResidualMatrix(Transform::XY2Mat12(param.x, param.y), img_calc);
+        double x = param.x, y = param.y;
+        in.Undistort(x, y);
 #if (AGTB_DEBUG) && (AGTB_DEBUG_INFO_LEVEL >= AGTB_DEBUG_INTERNAL_LEVEL)
         IO::PrintEigen(Linalg::CsTranslate(obj, ex.Xs, ex.Ys, ex.Zs), "img aux coord");
         IO::PrintEigen(isp, "img sp coord");
         IO::PrintEigen(img_calc, "calc image");
         IO::PrintEigen(Transform::XY2Mat12(param.x, param.y), "image");
 #endif
-        return std::make_tuple(coeff, residual);
+        // Rows of `X, Y, Z` are the resection rows of `Xs, Ys, Zs` negated, hence `coord -= correction`
+        ForEachCoefficientRow<__simplify>(rotate, isp, img_calc, ex, in, [&](size_t, const CoefficientRow &ax, const CoefficientRow &ay)
+                                          {
+                                              visit(ax.template leftCols<3>(), x - img_calc(0, 0));
+                                              visit(ay.template leftCols<3>(), y - img_calc(0, 1)); });
+    }
+
+    /**
+     * @brief Stacked `A` and `L` of all photos
+     *
+     */
+    template <Simplify __simplify>
+    static std::tuple<Matrix, Matrix> MakeSystem(OlsParam list, const Result &xyz)
+    {
+        Matrix coeff(2 * list.size(), 3), residual(2 * list.size(), 1);
+        Eigen::Index row = 0;
+        for (const Param &param : list)
+        {
+            ForEachRow<__simplify>(param, xyz, [&](const auto &a, double l)
+                                   {
+                                       coeff.row(row) = a;
+                                       residual(row++, 0) = l; });
+        }
+#if (AGTB_DEBUG)
+        IO::PrintEigen(coeff, "coeff");
+        IO::PrintEigen(residual, "residual");
+#endif
+        return {coeff, residual};
     }
 };
 
@@ -2,7 +2,7 @@
 #define __AGTB_PHOTOGRAMMETRY_SPACE_MATH_COLLINEARITY_EQUATION_HPP__
 
 #include "../Base.hpp"
-#include "gcem.hpp"
+#include "../../Utils/FastMath.hpp"
 #include "../../IO/Eigen.hpp"
 
 AGTB_PHOTOGRAMMETRY_BEGIN
@@ -109,11 +109,9 @@ private:
             k = param.kappa, w = param.omega;
         const Matrix &rotate = param.rotate;
 
-        double
-            cosk = gcem::cos(k),
-            sink = gcem::sin(k),
-            cosw = gcem::cos(w),
-            sinw = gcem::sin(w);
+        double cosk, sink, cosw, sinw;
+        Math::sincos(k, sink, cosk);
+        Math::sincos(w, sinw, cosw);
         const auto &a = rotate.row(0),
                    &b = rotate.row(1),
                    &c = rotate.row(2);
@@ -143,11 +141,11 @@ private:
             k = param.kappa;
 
         double
-            xx = f + pow(x, 2) / f,
-            yy = f + pow(y, 2) / f,
+            xx = f + Math::pow(x, 2) / f,
+            yy = f + Math::pow(y, 2) / f,
             xy = x * y / f,
-            cosk = gcem::cos(k),
-            sink = gcem::sin(k);
+            cosk, sink;
+        Math::sincos(k, sink, cosk);
 
         Coefficient coeff{
             .a11 = -f / H * cosk,
@@ -173,8 +171,8 @@ private:
             f = param.f, H = param.H;
 
         double
-            xx = f + pow(x, 2) / f,
-            yy = f + pow(y, 2) / f,
+            xx = f + Math::pow(x, 2) / f,
+            yy = f + Math::pow(y, 2) / f,
             xy = x * y / f;
 
         Coefficient coeff{
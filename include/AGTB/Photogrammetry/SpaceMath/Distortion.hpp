@@ -0,0 +1,258 @@
+#ifndef __AGTB_PHOTOGRAMMETRY_SPACE_MATH_DISTORTION_HPP__
+#define __AGTB_PHOTOGRAMMETRY_SPACE_MATH_DISTORTION_HPP__
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../Base.hpp"
+#include "../../Utils/Parallel.hpp"
+
+AGTB_PHOTOGRAMMETRY_BEGIN
+
+namespace Distortion
+{
+    /**
+     * @brief Remove lens distortion of measured image points by direct polynomial evaluation
+     *
+     * @param image N x 2
+     * @param in
+     * @return Matrix N x 2
+     */
+    Matrix Undistort(const Matrix &image, const InteriorOrientationElements &in)
+    {
+        if (image.cols() != 2)
+        {
+            AGTB_THROW(std::invalid_argument, std::format("Col size of image plane coordinate must be 2 but get {}", image.cols()));
+        }
+
+        Matrix corrected = image;
+        if (in.distortion.IsZero())
+        {
+            return corrected;
+        }
+        for (Eigen::Index i = 0; i != corrected.rows(); ++i)
+        {
+            in.Undistort(corrected(i, 0), corrected(i, 1));
+        }
+        return corrected;
+    }
+
+    /**
+     * @brief Precomputed undistortion table over a bounded image area. Corrections `(dx, dy)` are sampled on a
+     * regular grid and looked up bilinearly, points outside of bounds fall back to polynomial evaluation. Cost of a
+     * lookup is fixed whatever the model is; for the plain five-parameter model `Undistort` above is as fast, table
+     * pays off once corrections are composed or made more expensive.
+     *
+     */
+    class UndistortionLUT
+    {
+    public:
+        struct Bounds
+        {
+            double x_min, x_max, y_min, y_max;
+        };
+
+    private:
+        InteriorOrientationElements in;
+        Bounds bounds;
+        Eigen::Index nodes_x, nodes_y;
+        double hx, hy, inv_hx, inv_hy;
+        std::vector<double> table; // interleaved (dx, dy), row-major over y then x
+        double max_error;
+
+    public:
+        /**
+         * @brief Build table with `nodes_x * nodes_y` nodes covering `bounds`
+         *
+         * @param in
+         * @param bounds
+         * @param nodes_x at least 2
+         * @param nodes_y at least 2
+         */
+        UndistortionLUT(const InteriorOrientationElements &in, const Bounds &bounds, Eigen::Index nodes_x, Eigen::Index nodes_y)
+            : in(in), bounds(bounds), nodes_x(nodes_x), nodes_y(nodes_y)
+        {
+            if (nodes_x < 2 || nodes_y < 2 || !(bounds.x_max > bounds.x_min) || !(bounds.y_max > bounds.y_min))
+            {
+                AGTB_THROW(std::invalid_argument, std::format("Invalid LUT of ({}, {}) nodes over [{}, {}] x [{}, {}]",
+                                                              nodes_x, nodes_y, bounds.x_min, bounds.x_max, bounds.y_min, bounds.y_max));
+            }
+
+            hx = (bounds.x_max - bounds.x_min) / (nodes_x - 1);
+            hy = (bounds.y_max - bounds.y_min) / (nodes_y - 1);
+            inv_hx = 1.0 / hx;
+            inv_hy = 1.0 / hy;
+
+            table.resize(2 * nodes_x * nodes_y);
+            for (Eigen::Index j = 0; j != nodes_y; ++j)
+            {
+                const double y = bounds.y_min + j * hy;
+                for (Eigen::Index i = 0; i != nodes_x; ++i)
+                {
+                    const double x = bounds.x_min + i * hx;
+                    double *node = &table[2 * (j * nodes_x + i)];
+                    in.distortion.Of(x - in.x0, y - in.y0, node[0], node[1]);
+                }
+            }
+
+            max_error = MeasureMaxError();
+        }
+
+        /**
+         * @brief Build the coarsest table, refined by halving cell size, whose interpolation error is under
+         * `tolerance`, or the finest one within `max_nodes` per axis
+         *
+         * @param in
+         * @param bounds
+         * @param tolerance same unit as image coordinates
+         * @param max_nodes
+         * @return UndistortionLUT
+         */
+        static UndistortionLUT WithTolerance(const InteriorOrientationElements &in, const Bounds &bounds, double tolerance, Eigen::Index max_nodes = 4097)
+        {
+            Eigen::Index nodes = 17;
+            UndistortionLUT lut(in, bounds, nodes, nodes);
+            while (lut.MaxError() > tolerance && 2 * nodes - 1 <= max_nodes)
+            {
+                nodes = 2 * nodes - 1;
+                lut = UndistortionLUT(in, bounds, nodes, nodes);
+            }
+            return lut;
+        }
+
+        /**
+         * @brief Max interpolation error of `(dx, dy)` measured at cell centres and edge midpoints
+         *
+         * @return double
+         */
+        double MaxError() const noexcept
+        {
+            return max_error;
+        }
+
+        Eigen::Index NodesX() const noexcept
+        {
+            return nodes_x;
+        }
+
+        Eigen::Index NodesY() const noexcept
+        {
+            return nodes_y;
+        }
+
+        size_t Bytes() const noexcept
+        {
+            return table.size() * sizeof(double);
+        }
+
+        /**
+         * @brief Remove lens distortion of one measured image point in place
+         *
+         * @param x
+         * @param y
+         */
+        void Undistort(double &x, double &y) const noexcept
+        {
+            const double
+                u = (x - bounds.x_min) * inv_hx,
+                v = (y - bounds.y_min) * inv_hy;
+            if (!(u >= 0.0 && v >= 0.0 && u <= nodes_x - 1 && v <= nodes_y - 1)) [[unlikely]]
+            {
+                in.Undistort(x, y);
+                return;
+            }
+
+            const Eigen::Index
+                i = std::min<Eigen::Index>(static_cast<Eigen::Index>(u), nodes_x - 2),
+                j = std::min<Eigen::Index>(static_cast<Eigen::Index>(v), nodes_y - 2);
+            const double
+                tx = u - i,
+                ty = v - j;
+            const double
+                *n00 = &table[2 * (j * nodes_x + i)],
+                *n10 = n00 + 2,
+                *n01 = n00 + 2 * nodes_x,
+                *n11 = n01 + 2;
+            const double
+                dx0 = n00[0] + tx * (n10[0] - n00[0]),
+                dx1 = n01[0] + tx * (n11[0] - n01[0]),
+                dy0 = n00[1] + tx * (n10[1] - n00[1]),
+                dy1 = n01[1] + tx * (n11[1] - n01[1]);
+            x -= dx0 + ty * (dx1 - dx0);
+            y -= dy0 + ty * (dy1 - dy0);
+        }
+
+        /**
+         * @brief Bulk correction, `image` and `corrected` may be the same matrix
+         *
+         * @tparam __image any Eigen expression of N x 2
+         * @tparam __corrected any writable Eigen expression of N x 2
+         * @param image
+         * @param corrected output, follows Eigen convention of `const MatrixBase &` for writable expressions
+         * @param n_threads `1` (default) runs on calling thread, `0` means all hardware threads
+         */
+        template <typename __image, typename __corrected>
+        void Apply(const Eigen::MatrixBase<__image> &image, const Eigen::MatrixBase<__corrected> &corrected, size_t n_threads = 1) const
+        {
+            auto &out = const_cast<Eigen::MatrixBase<__corrected> &>(corrected);
+            if (image.cols() != 2 || out.cols() != 2 || image.rows() != out.rows())
+            {
+                AGTB_THROW(std::invalid_argument,
+                           std::format("Expect (N, 2) -> (N, 2) but get ({}, {}) -> ({}, {})",
+                                       image.rows(), image.cols(), out.rows(), out.cols()));
+            }
+
+            constexpr Eigen::Index chunk = 1 << 16;
+            const Eigen::Index rows = image.rows();
+            Utils::ParallelFor(
+                (rows + chunk - 1) / chunk,
+                [&](size_t task)
+                {
+                    const Eigen::Index begin = task * chunk, end = std::min(begin + chunk, rows);
+                    for (Eigen::Index r = begin; r != end; ++r)
+                    {
+                        double x = image(r, 0), y = image(r, 1);
+                        Undistort(x, y);
+                        out(r, 0) = x;
+                        out(r, 1) = y;
+                    }
+                },
+                n_threads);
+        }
+
+        Matrix Apply(const Matrix &image, size_t n_threads = 1) const
+        {
+            Matrix corrected(image.rows(), image.cols());
+            Apply(image, corrected, n_threads);
+            return corrected;
+        }
+
+    private:
+        double MeasureMaxError() const noexcept
+        {
+            double error = 0.0;
+            for (Eigen::Index j = 0; j != nodes_y - 1; ++j)
+            {
+                for (Eigen::Index i = 0; i != nodes_x - 1; ++i)
+                {
+                    const double x = bounds.x_min + i * hx, y = bounds.y_min + j * hy;
+                    for (auto [ox, oy] : {std::pair{0.5, 0.5}, std::pair{0.5, 0.0}, std::pair{0.0, 0.5}})
+                    {
+                        double
+                            lx = x + ox * hx, ly = y + oy * hy,
+                            ex = lx, ey = ly;
+                        Undistort(lx, ly);
+                        in.Undistort(ex, ey);
+                        error = std::max({error, std::abs(lx - ex), std::abs(ly - ey)});
+                    }
+                }
+            }
+            return error;
+        }
+    };
+}
+
+AGTB_PHOTOGRAMMETRY_END
+
+#endif
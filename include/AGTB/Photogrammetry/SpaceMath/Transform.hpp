@@ -87,6 +87,102 @@ namespace Transform
         return Isp2Img(Aux2Isp(Obj2Aux(obj, ex), calc_rotate(ex)), in);
     }
 
+    /**
+     * @brief Compile-time rotation order, used by fused kernels instead of a `std::function` rotation callback
+     *
+     * @tparam __ax1
+     * @tparam __ax2
+     * @tparam __ax3
+     */
+    template <Linalg::Axis __ax1, Linalg::Axis __ax2, Linalg::Axis __ax3>
+    struct RotationOrder
+    {
+        constexpr static Linalg::Axis ax1 = __ax1, ax2 = __ax2, ax3 = __ax3;
+
+        static Linalg::Matrix3 Of(const ExteriorOrientationElements &ex)
+        {
+            return ex.ToFixedRotationMatrix<ax1, ax2, ax3>();
+        }
+    };
+
+    using YXZ = RotationOrder<Linalg::Axis::Y, Linalg::Axis::X, Linalg::Axis::Z>;
+
+    template <typename T>
+    concept RotationOrderPolicy = requires(const ExteriorOrientationElements &ex) {
+        { T::Of(ex) } -> std::convertible_to<Linalg::Matrix3>;
+    };
+
+    /**
+     * @brief Fused `Obj2Aux -> Aux2Isp -> Isp2Img`. Translate, rotate and divide each point in one pass and write
+     * into caller-provided `img`, no intermediate matrix is allocated.
+     *
+     * @tparam __rotation_order
+     * @tparam __obj any Eigen expression of N x 3
+     * @tparam __img any writable Eigen expression of N x 2
+     * @param obj
+     * @param ex
+     * @param in
+     * @param img output, follows Eigen convention of `const MatrixBase &` for writable expressions
+     */
+    template <RotationOrderPolicy __rotation_order = YXZ, typename __obj, typename __img>
+    void Obj2ImgFused(
+        const Eigen::MatrixBase<__obj> &obj,
+        const ExteriorOrientationElements &ex,
+        const InteriorOrientationElements &in,
+        const Eigen::MatrixBase<__img> &img)
+    {
+        auto &out = const_cast<Eigen::MatrixBase<__img> &>(img);
+
+        if (obj.cols() != 3 || out.cols() != 2 || obj.rows() != out.rows())
+        {
+            AGTB_THROW(std::invalid_argument,
+                       std::format("Expect (N, 3) -> (N, 2) but get ({}, {}) -> ({}, {})",
+                                   obj.rows(), obj.cols(), out.rows(), out.cols()));
+        }
+
+        const Linalg::Matrix3 rotate = __rotation_order::Of(ex);
+        const double
+            a1 = rotate(0, 0), a2 = rotate(0, 1), a3 = rotate(0, 2),
+            b1 = rotate(1, 0), b2 = rotate(1, 1), b3 = rotate(1, 2),
+            c1 = rotate(2, 0), c2 = rotate(2, 1), c3 = rotate(2, 2),
+            Xs = ex.Xs, Ys = ex.Ys, Zs = ex.Zs,
+            f = in.f;
+
+        for (Eigen::Index i = 0; i != obj.rows(); ++i)
+        {
+            const double
+                dX = obj(i, 0) - Xs,
+                dY = obj(i, 1) - Ys,
+                dZ = obj(i, 2) - Zs,
+                XBar = a1 * dX + b1 * dY + c1 * dZ,
+                YBar = a2 * dX + b2 * dY + c2 * dZ,
+                ZBar = a3 * dX + b3 * dY + c3 * dZ,
+                scale = -f / ZBar;
+            out(i, 0) = scale * XBar;
+            out(i, 1) = scale * YBar;
+        }
+    }
+
+    /**
+     * @brief Allocating wrapper of fused kernel, result is same as `Obj2Img`
+     *
+     * @tparam __rotation_order
+     * @param obj
+     * @param ex
+     * @param in
+     * @return Matrix
+     */
+    template <RotationOrderPolicy __rotation_order = YXZ>
+    Matrix Obj2ImgFused(
+        const Matrix &obj,
+        const ExteriorOrientationElements &ex,
+        const InteriorOrientationElements &in)
+    {
+        Matrix img(obj.rows(), 2);
+        Obj2ImgFused<__rotation_order>(obj, ex, in, img);
+        return img;
+    }
+
     Matrix Isp2Aux(const Matrix &isp, const Matrix &rotate)
     {
         return Linalg::CsRotateInverse(isp, rotate);
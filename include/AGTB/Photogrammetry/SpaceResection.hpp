@@ -15,6 +15,7 @@
 #include "Base.hpp"
 #include "SpaceMath/CollinearityEquation.hpp"
 #include "SpaceMath/Transform.hpp"
+#include "SpaceMath/Distortion.hpp"
 #include "../Linalg/NormalEquationMatrixInverse.hpp"
 #include "../Linalg/RotationMatrix.hpp"
 #include "../Linalg/CorrectionOlsSolve.hpp"
@@ -93,124 +94,81 @@ namespace detail::SpaceResection
         return residual;
     }
 
-    template <Simplify __simplify>
-    Matrix SpaceResectionCoefficient(const Matrix &rotate, const Matrix &img_sp, const Matrix &img_calc, const ExteriorOrientationElements &ex, const InteriorOrientationElements &in)
-    {
-        AGTB_TEMPLATE_NOT_SPECIALIZED();
-    }
+    using CoefficientRow = Eigen::Matrix<double, 1, 6>;
+    using Correction = Eigen::Matrix<double, 6, 1>;
 
-    template <>
-    Matrix SpaceResectionCoefficient<Simplify::None>(const Matrix &rotate, const Matrix &img_sp, const Matrix &img_calc, const ExteriorOrientationElements &ex, const InteriorOrientationElements &in)
+    /**
+     * @brief Visit the two coefficient rows of every point as `visit(pi, row_x, row_y)`, fixed-size and on stack
+     *
+     */
+    template <Simplify __simplify, typename __visit>
+    void ForEachCoefficientRow(const Matrix &rotate, const Matrix &img_sp, const Matrix &img_calc, const ExteriorOrientationElements &ex, const InteriorOrientationElements &in, __visit &&visit)
     {
-        auto pc = img_calc.rows();
-        Matrix coefficient(pc * 2, 6);
-
-        const double &f = in.f,
-                     &m = in.m,
-                     &k = ex.Kappa,
-                     &w = ex.Omega;
-        const auto &a = rotate.row(0),
-                   &b = rotate.row(1),
-                   &c = rotate.row(2);
-        double H = f * m;
-
         Equation::Param param{
-            .f = f,
-            .H = H,
-            .kappa = k,
-            .omega = w,
-            .rotate = rotate};
-
-        for (auto pi = 0uz; pi != pc; ++pi)
+            .f = in.f,
+            .H = in.f * in.m};
+        if constexpr (__simplify != Simplify::All)
         {
-            const double
-                &x = img_calc(pi, 0),
-                &y = img_calc(pi, 1),
-                &z = img_sp(pi, 2);
-            param.x = x;
-            param.y = y;
-            param.z = z;
-
-            auto c =
-                Equation::Solve<Simplify::None>(param);
-
-            const auto &&l = 2 * pi;
-            coefficient.row(l) << c.a11, c.a12, c.a13, c.a14, c.a15, c.a16;
-            coefficient.row(l + 1) << c.a21, c.a22, c.a23, c.a24, c.a25, c.a26;
+            param.kappa = ex.Kappa;
+        }
+        if constexpr (__simplify == Simplify::None)
+        {
+            param.omega = ex.Omega;
+            param.rotate = rotate;
         }
 
-        return coefficient;
-    }
-
-    template <>
-    Matrix SpaceResectionCoefficient<Simplify::Kappa>(const Matrix &rotate, const Matrix &img_sp, const Matrix &img_calc, const ExteriorOrientationElements &ex, const InteriorOrientationElements &in)
-    {
-        auto pc = img_calc.rows();
-        Matrix coefficient(pc * 2, 6);
-
-        const double &f = in.f,
-                     &m = in.m,
-                     &k = ex.Kappa;
-
-        double H = f * m;
-        Equation::Param param{
-            .f = f,
-            .H = H,
-            .kappa = k};
-        for (auto pi = 0uz; pi != pc; ++pi)
+        for (auto pi = 0uz, pc = static_cast<size_t>(img_calc.rows()); pi != pc; ++pi)
         {
-            const double
-                &x = img_calc(pi, 0),
-                &y = img_calc(pi, 1);
-            param.x = x;
-            param.y = y;
+            param.x = img_calc(pi, 0);
+            param.y = img_calc(pi, 1);
+            if constexpr (__simplify == Simplify::None)
+            {
+                param.z = img_sp(pi, 2);
+            }
 
             auto c =
-                Equation::Solve<Simplify::Kappa>(param);
+                Equation::Solve<__simplify>(param);
 
-            const auto &&l = 2 * pi;
-            coefficient.row(l) << c.a11, c.a12, c.a13, c.a14, c.a15, c.a16;
-            coefficient.row(l + 1) << c.a21, c.a22, c.a23, c.a24, c.a25, c.a26;
+            CoefficientRow ax, ay;
+            ax << c.a11, c.a12, c.a13, c.a14, c.a15, c.a16;
+            ay << c.a21, c.a22, c.a23, c.a24, c.a25, c.a26;
+            visit(pi, ax, ay);
         }
+    }
 
+    template <Simplify __simplify>
+    Matrix SpaceResectionCoefficient(const Matrix &rotate, const Matrix &img_sp, const Matrix &img_calc, const ExteriorOrientationElements &ex, const InteriorOrientationElements &in)
+    {
+        Matrix coefficient(img_calc.rows() * 2, 6);
+        ForEachCoefficientRow<__simplify>(rotate, img_sp, img_calc, ex, in, [&](size_t pi, const CoefficientRow &ax, const CoefficientRow &ay)
+                                          {
+                                              coefficient.row(2 * pi) = ax;
+                                              coefficient.row(2 * pi + 1) = ay; });
         return coefficient;
     }
-    template <>
-    Matrix SpaceResectionCoefficient<Simplify::All>(
-        const Matrix &rotate,
-        const Matrix &img_sp,
-        const Matrix &img_calc,
-        const ExteriorOrientationElements &ex,
-        const InteriorOrientationElements &in)
-    {
-        auto pc = img_calc.rows();
-        Matrix coefficient(pc * 2, 6);
 
-        const double &f = in.f;
-        double H = f * in.m;
-        Equation::Param param{
-            .f = f,
-            .H = H};
-        for (auto pi = 0uz; pi != pc; ++pi)
+    /**
+     * @brief Correction of one iteration from normal equations accumulated point by point, without stacking
+     * `A` and `L`. Ill-conditioned systems fall back to QR of the stacked `A`.
+     *
+     */
+    template <Simplify __simplify>
+    Correction SpaceResectionCorrection(const Matrix &rotate, const Matrix &img_sp, const Matrix &img_calc, const Matrix &image, const ExteriorOrientationElements &ex, const InteriorOrientationElements &in)
+    {
+        Linalg::Fixed::NormalEquation<6> ne{};
+        ForEachCoefficientRow<__simplify>(rotate, img_sp, img_calc, ex, in, [&](size_t pi, const CoefficientRow &ax, const CoefficientRow &ay)
+                                          {
+                                              ne.Add(ax, image(pi, 0) - img_calc(pi, 0));
+                                              ne.Add(ay, image(pi, 1) - img_calc(pi, 1)); });
+        Correction correction;
+        if (!ne.Solve(correction))
         {
-            const double
-                &x = img_calc(pi, 0),
-                &y = img_calc(pi, 1);
-            param.x = x;
-            param.y = y;
-
-            auto c =
-                Equation::Solve<Simplify::All>(param);
-
-            const auto &&l = 2 * pi;
-            coefficient.row(l) << c.a11, c.a12, c.a13, c.a14, c.a15, c.a16;
-            coefficient.row(l + 1) << c.a21, c.a22, c.a23, c.a24, c.a25, c.a26;
+            correction = Linalg::CorrectionOlsSolve(SpaceResectionCoefficient<__simplify>(rotate, img_sp, img_calc, ex, in), ResidualMatrix(image, img_calc));
         }
-
-        return coefficient;
+        return correction;
     }
 
-    void UpdateExternalElements(ExteriorOrientationElements &exterior, const Matrix &correction)
+    void UpdateExternalElements(ExteriorOrientationElements &exterior, const Correction &correction)
     {
         exterior.Xs += correction(0);
         exterior.Ys += correction(1);
@@ -228,7 +186,7 @@ namespace detail::SpaceResection
      * @return true
      * @return false
      */
-    bool IsExternalElementsConverged(const Matrix &correction, const double threshold)
+    bool IsExternalElementsConverged(const Correction &correction, const double threshold)
     {
         const std::array<std::reference_wrapper<const double>, 3> angles{
             std::ref(correction(3)),
@@ -282,14 +240,15 @@ struct SpaceResection
         using namespace detail::SpaceResection;
 
         auto &interior = param.interior;
-        auto &image = param.image;
         auto &object = param.object;
 
-        if (!IsInputValid(image, object))
+        if (!IsInputValid(param.image, object))
         {
             throw std::invalid_argument("Arguments are invalid");
         }
 
+        const Matrix image = Distortion::Undistort(param.image, interior);
+
         Result result{
             .exterior = ExteriorOrientationElements::FromInteriorAndObjectCoordinate(interior, object),
             .info = IterativeSolutionInfo::NotConverged};
@@ -300,19 +259,19 @@ struct SpaceResection
             Matrix rotate = Transform::Ex2YXZ(exterior);
             Matrix isp = Transform::Aux2Isp(Transform::Obj2Aux(object, exterior), rotate);
             Matrix img_calc = Transform::Isp2Img(isp, interior);
-            Matrix residual = ResidualMatrix(image, img_calc);
-            Matrix coefficient = SpaceResectionCoefficient<__simplify>(rotate, isp, img_calc, exterior, interior);
-            Matrix correction = Linalg::CorrectionOlsSolve(coefficient, residual);
+            const Correction correction = SpaceResectionCorrection<__simplify>(rotate, isp, img_calc, image, exterior, interior);
 
 #if (AGTB_DEBUG)
             IO::PrintEigen(isp, "isp");
             IO::PrintEigen(img_calc, "img calc");
-            IO::PrintEigen(residual, "residual");
-            IO::PrintEigen(coefficient, "coefficient");
+            IO::PrintEigen(ResidualMatrix(image, img_calc), "residual");
+            IO::PrintEigen(SpaceResectionCoefficient<__simplify>(rotate, isp, img_calc, exterior, interior), "coefficient");
             IO::PrintEigen(correction, "correction");
 #endif
             if (IsExternalElementsConverged(correction, threshold))
             {
+                const Matrix residual = ResidualMatrix(image, img_calc);
+                const Matrix coefficient = SpaceResectionCoefficient<__simplify>(rotate, isp, img_calc, exterior, interior);
                 Matrix N = Linalg::NormalEquationMatrixInverse<__inverse_method>(coefficient);
                 CompleteResult(result, coefficient, correction, residual, rotate, image, N);
                 result.info = IterativeSolutionInfo::Success;
@@ -5,6 +5,7 @@
 #include "../Utils/Error.hpp"
 #include "../Utils/CharConv.hpp"
 #include "Math.hpp"
+#include "FastMath.hpp"
 
 #include <gcem.hpp>
 #include <numbers>
@@ -323,15 +324,15 @@ namespace Angles
 
         constexpr double Sin() const noexcept
         {
-            return gcem::sin(Rad());
+            return Math::sin(Rad());
         }
         constexpr double Cos() const noexcept
         {
-            return gcem::cos(Rad());
+            return Math::cos(Rad());
         }
         constexpr double Tan() const noexcept
         {
-            return gcem::tan(Rad());
+            return Math::tan(Rad());
         }
 
         /**
@@ -2,7 +2,13 @@
 #define __AGTB_UTILS_STD_CHAR_CONV_HPP__
 
 #include "../details/Macros.hpp"
+#include "CpuDispatch.hpp"
 #include <concepts>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
 
 AGTB_UTILS_BEGIN
 
@@ -24,6 +30,105 @@ bool FromString(const std::string &str, value_type &value)
     return __ec == std::errc{};
 }
 
+namespace detail::CharConv
+{
+    /**
+     * @brief Call `field(view)` on every field of `line` until it returns false. Fields are split by any char of
+     * `separators` with adjacent separators merged and trimmed of whitespace. Forced inline, so each clone of
+     * `ParseDelimited` gets the loop built for its own target.
+     *
+     * @return if every call returned true
+     */
+    template <typename __field>
+    __attribute__((always_inline)) inline bool ForEachField(std::string_view line, std::string_view separators, __field &&field)
+    {
+        constexpr std::string_view spaces = " \t\r\n\v\f";
+        size_t begin = 0;
+        while (true)
+        {
+            const size_t end = std::min(line.find_first_of(separators, begin), line.size());
+            const std::string_view raw = line.substr(begin, end - begin);
+            const size_t first = raw.find_first_not_of(spaces);
+            if (!field(first == std::string_view::npos ? std::string_view{} : raw.substr(first, raw.find_last_not_of(spaces) - first + 1)))
+            {
+                return false;
+            }
+
+            if (end == line.size())
+            {
+                return true;
+            }
+            begin = std::min(line.find_first_not_of(separators, end), line.size());
+        }
+    }
+}
+
+/**
+ * @brief Parse a whole delimited line of numbers without allocating per field. Fields are split by any char of
+ * `separators` with adjacent separators merged and trimmed of whitespace, same as `boost::split` with
+ * `token_compress_on` followed by `boost::trim`. Dispatched per CPU level.
+ *
+ * @tparam value_type
+ * @param line
+ * @param separators
+ * @param out converted fields are appended
+ * @param bad_field set to the first field failed to convert
+ * @return if error occurs -> false
+ */
+template <typename value_type>
+    requires std::floating_point<value_type> || std::integral<value_type>
+AGTB_MULTIVERSION bool ParseDelimited(std::string_view line, std::string_view separators, std::vector<value_type> &out, std::string_view &bad_field)
+{
+    return detail::CharConv::ForEachField(line, separators, [&](std::string_view field)
+                                          {
+                                              value_type value;
+                                              auto [__ptr, __ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+                                              if (__ec != std::errc{})
+                                              {
+                                                  bad_field = field;
+                                                  return false;
+                                              }
+                                              out.push_back(value);
+                                              return true; });
+}
+
+/**
+ * @brief Split `line` into fields the same way as `ParseDelimited`, fields are views into `line`
+ *
+ * @param line
+ * @param separators
+ * @param out fields are appended
+ */
+inline void SplitDelimited(std::string_view line, std::string_view separators, std::vector<std::string_view> &out)
+{
+    detail::CharConv::ForEachField(line, separators, [&](std::string_view field)
+                                   {
+                                       out.push_back(field);
+                                       return true; });
+}
+
+/**
+ * @brief Convert the whole of `str`, unlike `FromString` trailing characters are an error
+ *
+ * @tparam value_type
+ * @param str
+ * @param value
+ * @return if error occurs -> false
+ */
+template <typename value_type>
+    requires std::floating_point<value_type> || std::integral<value_type>
+bool FromStringExact(std::string_view str, value_type &value)
+{
+    auto [__ptr, __ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    return __ec == std::errc{} && __ptr == str.data() + str.size();
+}
+
+namespace detail::CharConv
+{
+    inline const bool parse_delimited_registered =
+        detail::CpuDispatch::Register("Utils::ParseDelimited", detail::CpuDispatch::Kind::Clones);
+}
+
 AGTB_UTILS_END
 
 AGTB_BEGIN
@@ -0,0 +1,174 @@
+#ifndef __AGTB_UTILS_CPU_DISPATCH_HPP__
+#define __AGTB_UTILS_CPU_DISPATCH_HPP__
+
+#include "../details/Macros.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <format>
+#include <atomic>
+#include <algorithm>
+
+/**
+ * @brief Runtime selection among `x86-64-v4` (AVX-512), `x86-64-v3` (AVX2 + FMA) and generic code, so consumers
+ * built for plain x86-64 still use wide units. Needs GCC/Clang on x86-64 ELF (ifunc); elsewhere, or with
+ * `AGTB_DISABLE_CPU_DISPATCH` defined, every kernel is compiled once for the consumer's `-march`.
+ *
+ * - `AGTB_MULTIVERSION` clones a function per level, the loader binds the best clone at startup.
+ * - `AGTB_TARGET_V3` / `AGTB_TARGET_V4` compile one function for a level; kernels whose SIMD width depends on the
+ *   level instantiate one such wrapper per level and switch on `ActiveCpuPath()`.
+ *
+ */
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__) && !defined(AGTB_DISABLE_CPU_DISPATCH)
+#define AGTB_CPU_DISPATCH true
+#define AGTB_MULTIVERSION __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#define AGTB_TARGET_V3 __attribute__((target("arch=x86-64-v3")))
+#define AGTB_TARGET_V4 __attribute__((target("arch=x86-64-v4")))
+#else
+#define AGTB_CPU_DISPATCH false
+#define AGTB_MULTIVERSION
+#define AGTB_TARGET_V3
+#define AGTB_TARGET_V4
+#endif
+
+AGTB_UTILS_BEGIN
+
+enum class CpuPath : int
+{
+    Default,
+    X86_64_V3,
+    X86_64_V4
+};
+
+inline std::string_view ToString(CpuPath path) noexcept
+{
+    switch (path)
+    {
+    case CpuPath::X86_64_V4:
+        return "x86-64-v4";
+    case CpuPath::X86_64_V3:
+        return "x86-64-v3";
+    default:
+        return "default";
+    }
+}
+
+/**
+ * @brief Best path supported by this CPU, same order as the `AGTB_MULTIVERSION` resolver
+ *
+ * @return CpuPath
+ */
+inline CpuPath DetectCpuPath() noexcept
+{
+#if AGTB_CPU_DISPATCH
+    static const CpuPath detected = []
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("x86-64-v4"))
+        {
+            return CpuPath::X86_64_V4;
+        }
+        if (__builtin_cpu_supports("x86-64-v3"))
+        {
+            return CpuPath::X86_64_V3;
+        }
+        return CpuPath::Default;
+    }();
+    return detected;
+#else
+    return CpuPath::Default;
+#endif
+}
+
+namespace detail::CpuDispatch
+{
+    inline std::atomic<int> &PathLimit() noexcept
+    {
+        static std::atomic<int> limit{static_cast<int>(CpuPath::X86_64_V4)};
+        return limit;
+    }
+
+    enum class Kind
+    {
+        Clones,
+        Explicit
+    };
+
+    struct Kernel
+    {
+        std::string_view name;
+        Kind kind;
+    };
+
+    inline std::vector<Kernel> &Kernels()
+    {
+        static std::vector<Kernel> kernels{};
+        return kernels;
+    }
+
+    /**
+     * @brief Record a dispatched kernel for `CpuDispatchReport`, used as initializer of an inline variable
+     *
+     */
+    inline bool Register(std::string_view name, Kind kind)
+    {
+        Kernels().push_back({name, kind});
+        return true;
+    }
+}
+
+/**
+ * @brief Path taken by explicitly dispatched kernels, detected path capped by `LimitCpuPath`
+ *
+ * @return CpuPath
+ */
+inline CpuPath ActiveCpuPath() noexcept
+{
+    const int limit = detail::CpuDispatch::PathLimit().load(std::memory_order_relaxed);
+    return static_cast<CpuPath>(std::min(static_cast<int>(DetectCpuPath()), limit));
+}
+
+/**
+ * @brief Cap explicitly dispatched kernels at `path`, e.g. to compare paths on one machine. Cloned kernels are bound
+ * by the loader and not affected.
+ *
+ * @param path
+ * @return CpuPath the path now active
+ */
+inline CpuPath LimitCpuPath(CpuPath path) noexcept
+{
+    detail::CpuDispatch::PathLimit().store(static_cast<int>(path), std::memory_order_relaxed);
+    return ActiveCpuPath();
+}
+
+/**
+ * @brief Which path every dispatched kernel linked into this program runs
+ *
+ * @return std::string
+ */
+inline std::string CpuDispatchReport()
+{
+    using detail::CpuDispatch::Kind;
+
+    std::string sb{};
+    auto sbb = std::back_inserter(sb);
+    std::format_to(sbb, "{:=^100}\nDispatch : {}\nDetected : {}\nActive : {}\n",
+                   " CPU Dispatch ",
+                   AGTB_CPU_DISPATCH ? "enabled" : "disabled",
+                   ToString(DetectCpuPath()),
+                   ToString(ActiveCpuPath()));
+    for (const auto &kernel : detail::CpuDispatch::Kernels())
+    {
+        const bool clones = kernel.kind == Kind::Clones;
+        std::format_to(sbb, "{} [{}] : {}\n",
+                       kernel.name,
+                       clones ? "target_clones" : "explicit",
+                       ToString(clones ? DetectCpuPath() : ActiveCpuPath()));
+    }
+    return sb;
+}
+
+AGTB_UTILS_END
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef __AGTB_UTILS_FAST_MATH_HPP__
+#define __AGTB_UTILS_FAST_MATH_HPP__
+
+#include "../details/Macros.hpp"
+
+#include <cmath>
+#include <concepts>
+#include <gcem.hpp>
+
+AGTB_BEGIN
+
+/**
+ * @brief Math facade for formulas shared by compile time and run time. In constant evaluation it forwards to
+ * `gcem`, otherwise to libm (`std::`) or cheaper equivalents, so the same expression stays `constexpr` without
+ * paying for `gcem` reference implementations at run time.
+ *
+ */
+namespace Math
+{
+    constexpr double sin(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::sin(x);
+        }
+        else
+        {
+            return std::sin(x);
+        }
+    }
+
+    constexpr double cos(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::cos(x);
+        }
+        else
+        {
+            return std::cos(x);
+        }
+    }
+
+    constexpr double tan(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::tan(x);
+        }
+        else
+        {
+            return std::tan(x);
+        }
+    }
+
+    constexpr double asin(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::asin(x);
+        }
+        else
+        {
+            return std::asin(x);
+        }
+    }
+
+    constexpr double acos(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::acos(x);
+        }
+        else
+        {
+            return std::acos(x);
+        }
+    }
+
+    constexpr double atan(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::atan(x);
+        }
+        else
+        {
+            return std::atan(x);
+        }
+    }
+
+    constexpr double atan2(double y, double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::atan2(y, x);
+        }
+        else
+        {
+            return std::atan2(y, x);
+        }
+    }
+
+    constexpr double sqrt(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::sqrt(x);
+        }
+        else
+        {
+            return std::sqrt(x);
+        }
+    }
+
+    constexpr double exp(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::exp(x);
+        }
+        else
+        {
+            return std::exp(x);
+        }
+    }
+
+    constexpr double abs(double x) noexcept
+    {
+        if consteval
+        {
+            return gcem::abs(x);
+        }
+        else
+        {
+            return std::fabs(x);
+        }
+    }
+
+    /**
+     * @brief `sin(x)` and `cos(x)` in one call, a single argument reduction at run time
+     *
+     * @param x
+     * @param s
+     * @param c
+     */
+    constexpr void sincos(double x, double &s, double &c) noexcept
+    {
+        if consteval
+        {
+            s = gcem::sin(x);
+            c = gcem::cos(x);
+        }
+        else
+        {
+            __builtin_sincos(x, &s, &c);
+        }
+    }
+
+    /**
+     * @brief Integer power by squaring, fully unrolled when `n` is a constant
+     *
+     * @tparam __int
+     * @param x
+     * @param n
+     * @return double
+     */
+    template <std::integral __int>
+    constexpr double pow(double x, __int n) noexcept
+    {
+        if consteval
+        {
+            return gcem::pow(x, n);
+        }
+        else
+        {
+            bool inverse = n < 0;
+            auto e = inverse ? -static_cast<long long>(n) : static_cast<long long>(n);
+            double result = 1.0;
+            while (e != 0)
+            {
+                if (e & 1)
+                {
+                    result *= x;
+                }
+                x *= x;
+                e >>= 1;
+            }
+            return inverse ? 1.0 / result : result;
+        }
+    }
+
+    /**
+     * @brief Real power. Half-integer exponents in `[-2.5, 2.5]` go through `sqrt` at run time.
+     *
+     * @param x
+     * @param y
+     * @return double
+     */
+    constexpr double pow(double x, double y) noexcept
+    {
+        if consteval
+        {
+            return gcem::pow(x, y);
+        }
+        else
+        {
+            const double twice = y * 2.0;
+            if (std::isfinite(y) && twice >= -5.0 && twice <= 5.0 && twice == static_cast<int>(twice))
+            {
+                const int n = static_cast<int>(twice);
+                if (n % 2 == 0)
+                {
+                    return pow(x, n / 2);
+                }
+                const double root = std::sqrt(x);
+                return n > 0 ? pow(x, (n - 1) / 2) * root : 1.0 / (pow(x, (-n - 1) / 2) * root);
+            }
+            return std::pow(x, y);
+        }
+    }
+}
+
+AGTB_END
+
+#endif
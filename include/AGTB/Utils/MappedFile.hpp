@@ -0,0 +1,189 @@
+#ifndef __AGTB_UTILS_MAPPED_FILE_HPP__
+#define __AGTB_UTILS_MAPPED_FILE_HPP__
+
+#include "../details/Macros.hpp"
+
+#include <format>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AGTB_UTILS_BEGIN
+
+/**
+ * @brief Read-only memory map of a whole file. Pages are loaded lazily by the OS on first touch, so opening costs
+ * no reading. Empty files map to an empty view.
+ *
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Expected access pattern, a hint for read-ahead (ignored where unsupported)
+     *
+     */
+    enum class Access
+    {
+        Normal,
+        Sequential,
+        Random,
+        WillNeed
+    };
+
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string &path)
+    {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Cannot open file: {}", path));
+        }
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            AGTB_THROW(std::runtime_error, std::format("Cannot stat file: {}", path));
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ != 0)
+        {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr)
+            {
+                data_ = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            AGTB_THROW(std::runtime_error, std::format("Cannot open file: {}", path));
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            AGTB_THROW(std::runtime_error, std::format("Cannot stat file: {}", path));
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ != 0)
+        {
+            void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            data_ = addr == MAP_FAILED ? nullptr : static_cast<const char *>(addr);
+        }
+        ::close(fd);
+#endif
+        if (size_ != 0 && data_ == nullptr)
+        {
+            size_ = 0;
+            AGTB_THROW(std::runtime_error, std::format("Cannot map file: {}", path));
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        Unmap();
+    }
+
+    const char *Data() const noexcept
+    {
+        return data_;
+    }
+
+    size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    std::string_view View() const noexcept
+    {
+        return data_ == nullptr ? std::string_view{} : std::string_view(data_, size_);
+    }
+
+    void Advise(Access access) const noexcept
+    {
+#if !defined(_WIN32)
+        if (data_ == nullptr)
+        {
+            return;
+        }
+        int advice = MADV_NORMAL;
+        switch (access)
+        {
+        case Access::Sequential:
+            advice = MADV_SEQUENTIAL;
+            break;
+        case Access::Random:
+            advice = MADV_RANDOM;
+            break;
+        case Access::WillNeed:
+            advice = MADV_WILLNEED;
+            break;
+        default:
+            break;
+        }
+        ::madvise(const_cast<char *>(data_), size_, advice);
+#else
+        (void)access;
+#endif
+    }
+
+private:
+    void Unmap() noexcept
+    {
+        if (data_ == nullptr)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<char *>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+AGTB_UTILS_END
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef __AGTB_UTILS_PARALLEL_HPP__
+#define __AGTB_UTILS_PARALLEL_HPP__
+
+#include "../details/Macros.hpp"
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+AGTB_UTILS_BEGIN
+
+/**
+ * @brief Number of worker threads to use when caller pass `0`
+ *
+ * @return size_t at least 1
+ */
+inline size_t HardwareThreads() noexcept
+{
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Run `fn(task)` for every `task` in `[0, n_tasks)` on `n_threads` threads. Tasks are taken dynamically
+ * from a shared counter, so uneven tasks are balanced. Calling thread is one of the workers. First exception
+ * thrown by any task is rethrown after all workers joined.
+ *
+ * @tparam __fn void(size_t task)
+ * @param n_tasks
+ * @param fn
+ * @param n_threads `0` means `HardwareThreads()`
+ */
+template <typename __fn>
+void ParallelFor(size_t n_tasks, __fn &&fn, size_t n_threads = 0)
+{
+    if (n_tasks == 0)
+    {
+        return;
+    }
+
+    n_threads = std::min(n_threads == 0 ? HardwareThreads() : n_threads, n_tasks);
+    if (n_threads == 1)
+    {
+        for (size_t task = 0; task != n_tasks; ++task)
+        {
+            fn(task);
+        }
+        return;
+    }
+
+    std::atomic_size_t next{0};
+    std::exception_ptr error{nullptr};
+    std::atomic_flag has_error{};
+
+    auto worker = [&]()
+    {
+        for (size_t task = next.fetch_add(1, std::memory_order_relaxed);
+             task < n_tasks;
+             task = next.fetch_add(1, std::memory_order_relaxed))
+        {
+            try
+            {
+                fn(task);
+            }
+            catch (...)
+            {
+                if (!has_error.test_and_set())
+                {
+                    error = std::current_exception();
+                }
+                next.store(n_tasks, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<std::jthread> workers{};
+    workers.reserve(n_threads - 1);
+    for (size_t ti = 1; ti != n_threads; ++ti)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    workers.clear();
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+AGTB_UTILS_END
+
+#endif
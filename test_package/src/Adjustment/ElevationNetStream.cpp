@@ -0,0 +1,157 @@
+#include <AGTB/Adjustment/ElevationNetStream.hpp>
+#include <AGTB/Linalg/NormalEquationAccumulator.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+
+namespace adj = AGTB::Adjustment;
+using adj::Elevation::Stream::FileSource;
+using adj::Elevation::Stream::Observation;
+
+double TrueHeight(int r, int c)
+{
+    return 100.0 + 0.05 * r - 0.03 * c + 2.0 * std::sin(r * 0.1) * std::cos(c * 0.07);
+}
+
+std::string Name(int r, int c)
+{
+    return std::format("P{}_{}", r, c);
+}
+
+/**
+ * @brief Grid net of `size x size` stations, every grid edge levelled `repeats` times, corners are controls
+ *
+ */
+std::unordered_map<std::string, double> WriteNet(const std::filesystem::path &path, int size, int repeats, double sigma)
+{
+    std::mt19937_64 gen(7);
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::ofstream out(path);
+    out << "# from to dif len\n";
+    for (int k = 0; k != repeats; ++k)
+    {
+        for (int r = 0; r != size; ++r)
+        {
+            for (int c = 0; c != size; ++c)
+            {
+                const double len = 0.5 + (r + c) % 3 * 0.5;
+                const double m = std::sqrt(len);
+                if (c + 1 != size)
+                {
+                    out << std::format("{} {} {:.6f} {}\n", Name(r, c), Name(r, c + 1), TrueHeight(r, c + 1) - TrueHeight(r, c) + m * noise(gen), len);
+                }
+                if (r + 1 != size)
+                {
+                    out << std::format("{},{},{:.6f},{}\n", Name(r, c), Name(r + 1, c), TrueHeight(r + 1, c) - TrueHeight(r, c) + m * noise(gen), len);
+                }
+            }
+        }
+    }
+
+    return {
+        {Name(0, 0), TrueHeight(0, 0)},
+        {Name(0, size - 1), TrueHeight(0, size - 1)},
+        {Name(size - 1, 0), TrueHeight(size - 1, 0)},
+        {Name(size - 1, size - 1), TrueHeight(size - 1, size - 1)}};
+}
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path();
+
+    // Small net against dense normal equations
+    {
+        const auto path = dir / "agtb_elevation_net_small.txt";
+        const auto controls = WriteNet(path, 6, 2, 1e-3);
+
+        FileSource source(path.string());
+        auto result = adj::AdjustStream(source, controls, {.memory_limit = 1024});
+        std::println("{}", result.ToString());
+        assert(result.chunks > 1);
+
+        // Chunk starts small whatever the cap, one chunk is enough here
+        FileSource uncapped(path.string());
+        auto once = adj::AdjustStream(uncapped, controls, {.memory_limit = size_t{1} << 30});
+        assert(once.chunks == 1 && (once.elev - result.elev).cwiseAbs().maxCoeff() < 1e-12);
+
+        std::unordered_map<std::string, Eigen::Index> index{};
+        for (size_t i = 0; i != result.unknown.size(); ++i)
+        {
+            index[result.unknown[i]] = i;
+        }
+        AGTB::Linalg::NormalEquationAccumulator acc(result.t);
+        source.Rewind();
+        std::vector<Observation> buffer(64);
+        for (size_t read = source.Read(buffer); read != 0; read = source.Read(buffer))
+        {
+            for (size_t i = 0; i != read; ++i)
+            {
+                const auto &obs = buffer[i];
+                Eigen::RowVectorXd a = Eigen::RowVectorXd::Zero(result.t);
+                double l = obs.dif;
+                if (controls.contains(obs.from))
+                    l += controls.at(obs.from);
+                else
+                    a(index[obs.from]) = -1;
+                if (controls.contains(obs.to))
+                    l -= controls.at(obs.to);
+                else
+                    a(index[obs.to]) = 1;
+                acc.Add(a, l, 1.0 / obs.len);
+            }
+        }
+        auto ne = acc.Result();
+        const Eigen::VectorXd x = ne.Solve();
+        std::println("max |x - x_dense| = {:.3e}, VPV {} vs {}", (x - result.elev).cwiseAbs().maxCoeff(), result.vpv, ne.VPV(x));
+        assert((x - result.elev).cwiseAbs().maxCoeff() < 1e-9);
+        assert(std::abs(result.vpv - ne.VPV(x)) < 1e-6 * result.vpv);
+        std::filesystem::remove(path);
+    }
+
+    // Larger net, bounded memory vs one chunk
+    {
+        const int size = 250;
+        const double sigma = 1e-3;
+        const auto path = dir / "agtb_elevation_net_large.txt";
+        const auto controls = WriteNet(path, size, 4, sigma);
+
+        FileSource capped_source(path.string());
+        std::println("AdjustStream, 4 MiB cap");
+        AGTB::timer.Tik();
+        auto capped = adj::AdjustStream(capped_source, controls, {.memory_limit = size_t{4} << 20});
+        AGTB::timer.Tok();
+        std::println("{}", capped.ToString());
+
+        FileSource whole_source(path.string());
+        std::println("AdjustStream, 1 GiB cap");
+        AGTB::timer.Tik();
+        size_t residuals = 0;
+        auto whole = adj::AdjustStream(whole_source, controls, {.memory_limit = size_t{1} << 30},
+                                       [&](const Observation &, double v)
+                                       { ++residuals; });
+        AGTB::timer.Tok();
+        std::println("{}", whole.ToString());
+
+        assert(whole.chunks < capped.chunks);
+        assert(residuals == whole.n);
+        assert((capped.elev - whole.elev).cwiseAbs().maxCoeff() < 1e-8);
+
+        double max_err = 0.0;
+        for (size_t i = 0; i != capped.unknown.size(); ++i)
+        {
+            int r, c;
+            std::sscanf(capped.unknown[i].c_str(), "P%d_%d", &r, &c);
+            max_err = std::max(max_err, std::abs(capped.elev(i) - TrueHeight(r, c)));
+        }
+        std::println("max height error {:.4f} m, m0 {:.3e} m", max_err, capped.m0);
+        assert(max_err < 0.05);
+        assert(std::abs(capped.m0 - sigma) < 0.1 * sigma);
+        std::filesystem::remove(path);
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <AGTB/Geodesy/Project.hpp>
+#include <AGTB/Utils/Timer.hpp>
+#include <AGTB/Utils/CpuDispatch.hpp>
+
+#include <print>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <string_view>
+
+namespace ag = AGTB::Geodesy;
+namespace simd = AGTB::Math::Simd;
+
+using projector = ag::Projector<ag::GeoCS::Geodetic, ag::ProjCS::GaussKruger>;
+using config = projector::Config<ag::Ellipsoids::CGCS2000, ag::GaussZoneInterval::D6>;
+
+constexpr size_t n = 1'000'003;
+
+struct Points
+{
+    std::vector<double> B, L, x, y;
+    std::vector<int> zone;
+};
+
+template <simd::Precision __precision>
+void Check(std::string_view tier, const Points &ref, double bound)
+{
+    Points out{.x = std::vector<double>(n), .y = std::vector<double>(n), .zone = std::vector<int>(n)};
+
+    std::println("Batch projection, {} tier:", tier);
+    AGTB::timer.Tik();
+    projector::ProjectBatch<config, __precision>(ref.B, ref.L, out.x, out.y, out.zone);
+    AGTB::timer.Tok();
+
+    double max_dx = 0, max_dy = 0;
+    for (size_t i = 0; i != n; ++i)
+    {
+        assert(out.zone[i] == ref.zone[i]);
+        max_dx = std::max(max_dx, std::abs(out.x[i] - ref.x[i]));
+        max_dy = std::max(max_dy, std::abs(out.y[i] - ref.y[i]));
+    }
+    std::println("max |dx| = {:.3e} m, max |dy| = {:.3e} m", max_dx, max_dy);
+    assert(max_dx < bound && max_dy < bound);
+}
+
+int main()
+{
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double>
+        lat(AGTB::Utils::Angles::FromDMS(1.0), AGTB::Utils::Angles::FromDMS(80.0)),
+        lon(AGTB::Utils::Angles::FromDMS(73.5), AGTB::Utils::Angles::FromDMS(134.5));
+
+    Points ref{.B = std::vector<double>(n), .L = std::vector<double>(n),
+               .x = std::vector<double>(n), .y = std::vector<double>(n), .zone = std::vector<int>(n)};
+    for (size_t i = 0; i != n; ++i)
+    {
+        ref.B[i] = lat(gen);
+        ref.L[i] = lon(gen);
+    }
+
+    std::println("Scalar projection of {} points:", n);
+    AGTB::timer.Tik();
+    for (size_t i = 0; i != n; ++i)
+    {
+        config::GeoCoord gc{.L = ag::Longitude<config::unit>(ref.L[i]), .B = ag::Latitude<config::unit>(ref.B[i])};
+        config::ProjCoord pc = projector::Project<config>(gc);
+        ref.x[i] = pc.x;
+        ref.y[i] = pc.y;
+        ref.zone[i] = pc.zone;
+    }
+    AGTB::timer.Tok();
+
+    Check<simd::Full>("Full", ref, 1e-6);
+    Check<simd::Survey>("Survey", ref, 1e-4);
+
+    std::println("{}", AGTB::Utils::CpuDispatchReport());
+    for (auto path : {AGTB::Utils::CpuPath::X86_64_V3, AGTB::Utils::CpuPath::Default})
+    {
+        std::println("Limit dispatch to {}, active {}", AGTB::Utils::ToString(path), AGTB::Utils::ToString(AGTB::Utils::LimitCpuPath(path)));
+        Check<simd::Full>("Full", ref, 1e-6);
+    }
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <AGTB/IO/CSV.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+
+using AGTB::ColumnarDataFrame;
+using AGTB::ColumnType;
+using AGTB::IO::ReadColumnarCSV;
+using AGTB::IO::ReadColumnarCSVMapped;
+using AGTB::IO::ReadCSV;
+
+/**
+ * @brief Survey table `Name, X, Y, H, Code, Class`, with blank lines, CRLF endings and, near the end, a real
+ * `Code` and a textual `H` that are not in the leading rows
+ *
+ */
+void WriteSurveyCsv(const std::string &path, size_t rows)
+{
+    std::mt19937_64 gen(5);
+    std::uniform_real_distribution<double> coord(0.0, 1e5);
+    std::ofstream os(path, std::ios_base::binary);
+    os << "Name, X, Y, H, Code, Class\r\n\n";
+    for (size_t r = 0; r != rows; ++r)
+    {
+        if (r % 50'000 == 7)
+        {
+            os << "  \t\n";
+        }
+        const std::string code = r == rows - 3 ? "2.5" : std::to_string(r % 7);
+        const std::string h = r == rows - 2 ? "unknown" : std::format("{:.4f}", coord(gen) / 100);
+        os << std::format("P{},{:.4f},{:.4f}, {} ,{},{}\r\n", r, coord(gen), coord(gen), h, code, r % 3 == 0 ? "control" : "detail");
+    }
+    os << "Q,1,2";
+}
+
+bool SameFrame(const ColumnarDataFrame<> &a, const ColumnarDataFrame<> &b)
+{
+    if (a.Rows() != b.Rows() || a.Cols() != b.Cols())
+    {
+        return false;
+    }
+    for (size_t c = 0; c != a.Cols(); ++c)
+    {
+        if (a.ColKeys(c) != b.ColKeys(c) || a.TypeOf(c) != b.TypeOf(c))
+        {
+            return false;
+        }
+        for (size_t r = 0; r != a.Rows(); ++r)
+        {
+            if (a.Cell(r, c) != b.Cell(r, c))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string csv = (dir / "agtb_csv.csv").string();
+
+    // Small files: separators, missing and extra fields, no header, fixed types
+    {
+        std::ofstream(csv) << "A;B;;C\n\n1;x\n2;;y;7;8\n;z;3\n";
+        auto expect = ReadColumnarCSV(csv, ";");
+        auto mapped = ReadColumnarCSVMapped(csv, ";", true, {}, 2);
+        assert(SameFrame(expect, mapped));
+        assert(mapped.Rows() == 3 && mapped.TypeOf("A") == ColumnType::Real && mapped.TypeOf("B") == ColumnType::String && mapped.TypeOf("C") == ColumnType::Real);
+        std::println("Mapped:\n{}", mapped.ToString());
+
+        assert(SameFrame(ReadColumnarCSV(csv, ";", false), ReadColumnarCSVMapped(csv, ";", false)));
+        assert(ReadColumnarCSVMapped(csv, ";", true, {{"B", ColumnType::String}}).TypeOf("B") == ColumnType::String);
+
+        bool thrown = false;
+        try
+        {
+            ReadColumnarCSVMapped(csv, ";", true, {{"C", ColumnType::Integer}});
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        std::ofstream(csv) << "A,B\n";
+        assert(ReadColumnarCSVMapped(csv).Rows() == 0);
+    }
+
+    // Whitespace separators, lines of only blanks are still skipped
+    for (auto [separator, text] : {std::pair<std::string, std::string>{" ", "a b\n0 0\n   \n\t\n1\t 2\n \t \n3  4"},
+                                   {" \t", "a b\n0 0\n   \n\t\n1\t 2\n \t \n3  4"},
+                                   {"\t", "a\tb\n0\t0\n   \n\t\n1\t2\n \t \n3\t4"}})
+    {
+        std::ofstream(csv) << text;
+        auto expect = ReadColumnarCSV(csv, separator);
+        auto mapped = ReadColumnarCSVMapped(csv, separator, true, {}, 2);
+        assert(SameFrame(expect, mapped));
+        assert(mapped.Rows() == 3 && mapped.TypeOf("b") == ColumnType::Integer);
+    }
+
+    const size_t rows = 400'000;
+    WriteSurveyCsv(csv, rows);
+    std::println("{} rows, {} bytes", rows, std::filesystem::file_size(csv));
+
+    // Same frame as ReadColumnarCSV, including the types demoted after the sampled rows
+    {
+        auto expect = ReadColumnarCSV(csv);
+        for (size_t threads : {1, 3, 0})
+        {
+            auto mapped = ReadColumnarCSVMapped(csv, ",", true, {}, threads);
+            assert(SameFrame(expect, mapped));
+        }
+        assert(expect.TypeOf("Code") == ColumnType::Real && expect.TypeOf("H") == ColumnType::String);
+    }
+
+    std::println("ReadCSV<std::string>");
+    AGTB::timer.Tik();
+    {
+        auto df = ReadCSV<std::string>(csv, ",", true);
+        assert(df.Rows() > rows);
+    }
+    AGTB::timer.Tok();
+
+    std::println("ReadColumnarCSV");
+    AGTB::timer.Tik();
+    {
+        auto df = ReadColumnarCSV(csv, ",", true, {{"H", ColumnType::String}, {"Code", ColumnType::String}});
+        assert(df.Rows() == rows + 1);
+    }
+    AGTB::timer.Tok();
+
+    std::println("ReadColumnarCSVMapped");
+    AGTB::timer.Tik();
+    {
+        auto df = ReadColumnarCSVMapped(csv, ",", true, {{"H", ColumnType::String}, {"Code", ColumnType::String}});
+        assert(df.Rows() == rows + 1);
+    }
+    AGTB::timer.Tok();
+
+    // Numeric only table, where from_chars into typed columns dominates
+    {
+        std::mt19937_64 gen(9);
+        std::uniform_real_distribution<double> coord(0.0, 1e5);
+        std::ofstream os(csv, std::ios_base::binary);
+        os << "X,Y,H,Code\n";
+        for (size_t r = 0; r != rows; ++r)
+        {
+            os << std::format("{:.4f},{:.4f},{:.4f},{}\n", coord(gen), coord(gen), coord(gen) / 100, r % 7);
+        }
+    }
+
+    double sum = 0.0;
+    std::println("Numeric table: ReadCSV<double>");
+    AGTB::timer.Tik();
+    {
+        auto df = ReadCSV<double>(csv, ",", true);
+        sum = df.NumericFrame<double>().col(2).sum();
+    }
+    AGTB::timer.Tok();
+
+    std::println("Numeric table: ReadColumnarCSVMapped");
+    AGTB::timer.Tik();
+    {
+        auto df = ReadColumnarCSVMapped(csv);
+        assert(std::abs(df.NumericSeries<double>("H").sum() - sum) < 1e-6 * std::abs(sum));
+        assert(df.TypeOf("Code") == ColumnType::Integer);
+    }
+    AGTB::timer.Tok();
+
+    std::filesystem::remove(csv);
+    return 0;
+}
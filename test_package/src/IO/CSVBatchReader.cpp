@@ -0,0 +1,180 @@
+#include <AGTB/IO/CSVBatchReader.hpp>
+#include <AGTB/Geodesy/Project.hpp>
+#include <AGTB/Linalg/NormalEquationAccumulator.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <numbers>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+
+namespace ag = AGTB::Geodesy;
+
+using AGTB::ColumnType;
+using AGTB::IO::CSVBatch;
+using AGTB::IO::CSVBatchReader;
+using AGTB::IO::ForEachCSVBatch;
+using AGTB::IO::ReadColumnarCSV;
+using AGTB::Linalg::NormalEquationAccumulator;
+
+using projector = ag::Projector<ag::GeoCS::Geodetic, ag::ProjCS::GaussKruger>;
+using config = projector::Config<ag::Ellipsoids::CGCS2000, ag::GaussZoneInterval::D6>;
+
+/**
+ * @brief Points `Name, B, L, H` (radian), `H` lies on a plane of `B`, `L` plus noise, blank lines here and there
+ *
+ */
+void WritePointsCsv(const std::string &path, size_t rows)
+{
+    constexpr double deg = std::numbers::pi / 180.0;
+    std::mt19937_64 gen(13);
+    std::uniform_real_distribution<double> B(20.0 * deg, 50.0 * deg), L(100.0 * deg, 120.0 * deg);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    std::ofstream os(path, std::ios_base::binary);
+    os << "Name,B,L,H\n";
+    for (size_t r = 0; r != rows; ++r)
+    {
+        const double b = B(gen), l = L(gen);
+        os << std::format("P{},{:.12f},{:.12f},{:.4f}\n", r, b, l, 50.0 + 100.0 * b - 30.0 * l + noise(gen));
+        if (r % 100'003 == 5)
+        {
+            os << "\n";
+        }
+    }
+}
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string csv = (dir / "agtb_csv_batches.csv").string();
+
+    // Batches cover the file in order, whatever the batch size
+    {
+        std::ofstream(csv) << "\nA; B\n1;x\n\n2;y\n3\n4;w;extra\n5;v";
+        for (size_t batch_rows : {1, 2, 4, 16})
+        {
+            for (bool prefetch : {false, true})
+            {
+                std::vector<double> a{};
+                std::vector<std::string> b{};
+                ForEachCSVBatch(
+                    csv, batch_rows,
+                    [&](const CSVBatch &batch)
+                    {
+                        assert(batch.FirstRow() == a.size() && batch.Rows() <= batch_rows);
+                        a.insert(a.end(), batch.Column<double>("A").begin(), batch.Column<double>("A").end());
+                        b.insert(b.end(), batch.Column<std::string>(1).begin(), batch.Column<std::string>(1).end());
+                    },
+                    {.separator = ";", .prefetch = prefetch});
+                assert((a == std::vector<double>{1, 2, 3, 4, 5}));
+                assert((b == std::vector<std::string>{"x", "y", "", "w", "v"}));
+            }
+        }
+
+        CSVBatchReader reader(csv, 2, {.separator = ";", .has_header = false});
+        assert(reader.ColKeys().size() == 2 && reader.TypeOf(0) == ColumnType::String);
+        size_t batches = 0;
+        for (const auto &batch : reader)
+        {
+            assert(batch.Column<std::string>("Col0")[0] == (batches == 0 ? "A" : std::to_string(2 * batches)));
+            ++batches;
+        }
+        assert(batches == 3 && !reader.Next());
+
+        // Whitespace separator, lines of only blanks are not rows
+        std::ofstream(csv) << "x y\n0.5 0\n \n\t\n1.5 2\n   ";
+        for (size_t batch_rows : {1, 2, 8})
+        {
+            std::vector<double> xs{};
+            std::vector<std::int64_t> ys{};
+            ForEachCSVBatch(
+                csv, batch_rows,
+                [&](const CSVBatch &batch)
+                {
+                    xs.insert(xs.end(), batch.Column<double>("x").begin(), batch.Column<double>("x").end());
+                    ys.insert(ys.end(), batch.Column<std::int64_t>("y").begin(), batch.Column<std::int64_t>("y").end());
+                },
+                {.separator = " ", .types = {{"y", ColumnType::Integer}}});
+            assert((xs == std::vector<double>{0.5, 1.5} && ys == std::vector<std::int64_t>{0, 2}));
+        }
+
+        // Whole numbers in the first batch are still read as reals, later decimals fit
+        std::ofstream(csv) << "H\n100\n101\n102\n103\n104\n100.5\n";
+        std::vector<double> hs{};
+        ForEachCSVBatch(csv, 4, [&](const CSVBatch &batch)
+                        { hs.insert(hs.end(), batch.Column<double>("H").begin(), batch.Column<double>("H").end()); });
+        assert((hs == std::vector<double>{100, 101, 102, 103, 104, 100.5}));
+        std::ofstream(csv) << "\nA; B\n1;x\n\n2;y\n3\n4;w;extra\n5;v";
+
+        // Types come from the first batch, a later misfit throws
+        bool thrown = false;
+        try
+        {
+            ForEachCSVBatch(csv, 2, [](const CSVBatch &) {}, {.separator = ";", .types = {{"B", ColumnType::Real}}});
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    const size_t rows = 1'000'000, batch_rows = 1 << 16;
+    WritePointsCsv(csv, rows);
+    std::println("{} rows, {} bytes, batches of {} rows", rows, std::filesystem::file_size(csv), batch_rows);
+
+    // Whole file at once
+    std::vector<double> x(rows), y(rows);
+    std::vector<int> zone(rows);
+    Eigen::VectorXd expect_plane;
+    std::println("ReadColumnarCSV + ProjectBatch + plane fit");
+    AGTB::timer.Tik();
+    {
+        auto df = ReadColumnarCSV(csv);
+        const auto &B = df.Loc<double>("B"), &L = df.Loc<double>("L"), &H = df.Loc<double>("H");
+        projector::ProjectBatch<config>(B, L, x, y, zone);
+        NormalEquationAccumulator acc(3);
+        acc.AddParallel(rows, [&](size_t i, auto a, double &l, double &)
+                        { a << 1.0, B[i], L[i]; l = H[i]; });
+        expect_plane = acc.Result().Solve();
+    }
+    AGTB::timer.Tok();
+
+    // Streamed, buffers of one batch reused
+    for (bool prefetch : {false, true})
+    {
+        std::vector<double> bx(batch_rows), by(batch_rows);
+        std::vector<int> bzone(batch_rows);
+        NormalEquationAccumulator acc(3);
+        double max_diff = 0.0;
+
+        std::println("CSVBatchReader (prefetch: {}) + ProjectBatch + plane fit", prefetch);
+        AGTB::timer.Tik();
+        CSVBatchReader reader(csv, batch_rows, {.prefetch = prefetch});
+        for (const auto &batch : reader)
+        {
+            const auto B = batch.Column<double>("B"), L = batch.Column<double>("L"), H = batch.Column<double>("H");
+            const size_t n = batch.Rows();
+            projector::ProjectBatch<config>(B, L, std::span(bx).first(n), std::span(by).first(n), std::span(bzone).first(n));
+            acc.AddParallel(n, [&](size_t i, auto a, double &l, double &)
+                            { a << 1.0, B[i], L[i]; l = H[i]; });
+            for (size_t i = 0; i != n; ++i)
+            {
+                const size_t r = batch.FirstRow() + i;
+                assert(bzone[i] == zone[r]);
+                max_diff = std::max({max_diff, std::abs(bx[i] - x[r]), std::abs(by[i] - y[r])});
+            }
+        }
+        AGTB::timer.Tok();
+
+        const auto ne = acc.Result();
+        assert(ne.observations == rows && max_diff == 0.0);
+        assert((ne.Solve() - expect_plane).cwiseAbs().maxCoeff() < 1e-6);
+        std::println("Plane H = {:.3f} + {:.3f} B + {:.3f} L", expect_plane(0), expect_plane(1), expect_plane(2));
+    }
+
+    std::filesystem::remove(csv);
+    return 0;
+}
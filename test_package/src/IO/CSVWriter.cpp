@@ -0,0 +1,143 @@
+#include <AGTB/IO/CSVWriter.hpp>
+#include <AGTB/IO/CSV.hpp>
+#include <AGTB/Geodesy/Project.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <numbers>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+namespace ag = AGTB::Geodesy;
+
+using AGTB::ColumnarDataFrame;
+using AGTB::IO::CSVWriter;
+using AGTB::IO::ReadColumnarCSV;
+using AGTB::IO::ReadCSV;
+using AGTB::IO::WriteCSV;
+
+using projector = ag::Projector<ag::GeoCS::Geodetic, ag::ProjCS::GaussKruger>;
+using config = projector::Config<ag::Ellipsoids::CGCS2000, ag::GaussZoneInterval::D6>;
+
+std::string Slurp(const std::string &path)
+{
+    std::ifstream is(path, std::ios_base::binary);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    return ss.str();
+}
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string csv = (dir / "agtb_csv_writer.csv").string(), other = (dir / "agtb_csv_writer_other.csv").string();
+
+    // Shortest round-trip form reads back exactly
+    {
+        ColumnarDataFrame<> df(3);
+        df.AddColumn<std::string>("Name", {"A", "B", "C"});
+        df.AddColumn<double>("X", {0.1, -2.5e-300, 1.0 / 3.0});
+        df.AddColumn<std::int64_t>("Code", {7, -8, 9});
+        WriteCSV(df, csv);
+        assert(Slurp(csv).starts_with("Name,X,Code\nA,0.1,7\n"));
+
+        auto back = ReadColumnarCSV(csv);
+        for (size_t r = 0; r != 3; ++r)
+        {
+            assert(back.Loc<double>("X")[r] == df.Loc<double>("X")[r]);
+            assert(back.Loc<std::int64_t>("Code")[r] == df.Loc<std::int64_t>("Code")[r]);
+        }
+
+        WriteCSV(df, csv, {.separator = ';', .precision = 2}, true);
+        std::println("Fixed precision with row keys:\n{}", Slurp(csv));
+        assert(Slurp(csv) == ";Name;X;Code\n0;A;0.10;7\n1;B;-0.00;-8\n2;C;0.33;9\n");
+
+        Eigen::Matrix<double, 2, 3> m{{1.0, 2.5, -3.0}, {0.125, 1e10, 6.0}};
+        {
+            CSVWriter out(csv);
+            out.WriteHeader({"a", "b", "c"});
+            out.WriteMatrix(m);
+        }
+        assert(ReadCSV<double>(csv).NumericFrame<double>() == m);
+
+        auto text = ReadCSV<std::string>(csv);
+        WriteCSV(text, other);
+        assert(Slurp(other) == Slurp(csv));
+
+        // Fixed form of huge values with many decimals is longer than the default room per number
+        const std::vector<double> huge{1e308, -1.7976931348623157e308, 0.1};
+        {
+            CSVWriter out(csv, {.precision = 100});
+            out.WriteColumns(huge);
+        }
+        assert(Slurp(csv) == std::format("{:.100f}\n{:.100f}\n{:.100f}\n", huge[0], huge[1], huge[2]));
+    }
+
+    static_assert(!AGTB::IO::detail::CSVWriter::Cell<bool> && AGTB::IO::detail::CSVWriter::Cell<char>);
+
+    // 10^6 projected points
+    const size_t n = 1'000'000;
+    std::vector<double> B(n), L(n), x(n), y(n);
+    std::vector<int> zone(n);
+    {
+        constexpr double deg = std::numbers::pi / 180.0;
+        std::mt19937_64 gen(17);
+        std::uniform_real_distribution<double> b(20.0 * deg, 50.0 * deg), l(100.0 * deg, 120.0 * deg);
+        std::ranges::generate(B, [&]
+                              { return b(gen); });
+        std::ranges::generate(L, [&]
+                              { return l(gen); });
+    }
+    std::println("ProjectBatch, {} points", n);
+    AGTB::timer.Tik();
+    projector::ProjectBatch<config>(B, L, x, y, zone);
+    AGTB::timer.Tok();
+
+    std::println("std::format into a string + ofstream");
+    AGTB::timer.Tik();
+    {
+        std::string str{"x,y,zone\n"};
+        for (size_t i = 0; i != n; ++i)
+        {
+            str.append(std::format("{:.4f},{:.4f},{}\n", x[i], y[i], zone[i]));
+        }
+        std::ofstream(other, std::ios_base::binary) << str;
+    }
+    AGTB::timer.Tok();
+
+    // Explicit thread count and small chunks, so the parallel chunk path runs on any machine
+    for (auto [background, threads] : {std::pair{false, size_t{1}}, {true, size_t{1}}, {false, size_t{4}}, {true, size_t{4}}})
+    {
+        std::println("CSVWriter, fixed 4 digits (background: {}, threads: {})", background, threads);
+        AGTB::timer.Tik();
+        {
+            CSVWriter out(csv, {.precision = 4, .background = background, .threads = threads, .chunk_rows = 1000});
+            out.WriteHeader({"x", "y", "zone"});
+            out.WriteColumns(x, y, zone);
+            out.Close();
+        }
+        AGTB::timer.Tok();
+        assert(Slurp(csv) == Slurp(other));
+    }
+
+    std::println("CSVWriter, shortest round-trip");
+    AGTB::timer.Tik();
+    {
+        CSVWriter out(csv, {.threads = 4, .chunk_rows = 777});
+        out.WriteHeader({"x", "y", "zone"});
+        out.WriteColumns(std::span<const double>(x), std::span<const double>(y), zone);
+        out.Close();
+    }
+    AGTB::timer.Tok();
+    {
+        auto back = ReadColumnarCSV(csv);
+        assert(back.Rows() == n && back.Loc<double>("x") == x && back.Loc<double>("y") == y);
+    }
+
+    std::filesystem::remove(csv);
+    std::filesystem::remove(other);
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include <AGTB/IO/ColumnarBinary.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+
+using AGTB::ColumnarDataFrame;
+using AGTB::ColumnType;
+using AGTB::IO::ColumnarBinaryToCSV;
+using AGTB::IO::CSVToColumnarBinary;
+using AGTB::IO::MappedDataFrame;
+using AGTB::IO::ReadColumnarCSV;
+using AGTB::IO::ReadCSV;
+using AGTB::IO::WriteColumnarBinary;
+
+/**
+ * @brief Survey table `Name, X, Y, H, Code, Class`, `Class` repeats a few labels
+ *
+ */
+void WriteSurveyCsv(const std::string &path, size_t rows)
+{
+    std::mt19937_64 gen(3);
+    std::uniform_real_distribution<double> coord(0.0, 1e5);
+    std::ofstream os(path);
+    os << "Name,X,Y,H,Code,Class\n";
+    for (size_t r = 0; r != rows; ++r)
+    {
+        os << std::format("P{},{:.4f},{:.4f},{:.4f},{},{}\n", r, coord(gen), coord(gen), coord(gen) / 100, r % 7, r % 3 == 0 ? "control" : "detail");
+    }
+}
+
+bool Throws(const std::string &path)
+{
+    try
+    {
+        MappedDataFrame df(path);
+    }
+    catch (const std::runtime_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string bin = (dir / "agtb_columnar.bin").string();
+
+    // Round trip with row keys, strings and both numeric types
+    {
+        ColumnarDataFrame<> df(3);
+        df.AddColumn<std::string>("Name", {"A", "B", "A"});
+        df.AddColumn<double>("X", {1.5, -2.25, 1e-300});
+        df.AddColumn<std::int64_t>("Code", {7, -8, 9});
+        df.RowKeys(0) = "first";
+        WriteColumnarBinary(df, bin);
+
+        MappedDataFrame mapped(bin);
+        assert(mapped.Rows() == 3 && mapped.Cols() == 3);
+        assert(mapped.ColKeys(1) == "X" && mapped.TypeOf("Code") == ColumnType::Integer);
+        assert(mapped.Strings("Name")[2] == "A" && mapped.Strings("Name").DictionarySize() == 2);
+        assert(mapped.NumericSeries<double>("X")(2) == 1e-300);
+        assert(mapped.NumericSeries<std::int64_t>("Code")(1) == -8);
+        assert(mapped.RowKeys(0) == "first" && mapped.RowKeys(2) == "2");
+        std::println("Mapped frame loaded:\n{}", mapped.Load().ToString());
+
+        bool thrown = false;
+        try
+        {
+            mapped.NumericSeries<double>("Code");
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    // Corrupt files are rejected on open
+    {
+        const std::string bad = (dir / "agtb_columnar_bad.bin").string();
+        std::ofstream(bad) << "Name,X\nA,1\n";
+        assert(Throws(bad));
+
+        std::filesystem::copy_file(bin, bad, std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::resize_file(bad, std::filesystem::file_size(bin) - 70);
+        assert(Throws(bad));
+
+        // Counts whose byte sizes wrap around to 0: rows, cols, dictionary size of `Name`
+        for (auto [offset, count] : {std::pair{16, std::uint64_t{1} << 62}, {24, std::uint64_t{1} << 60}, {64, (std::uint64_t{1} << 61) - 1}})
+        {
+            std::filesystem::copy_file(bin, bad, std::filesystem::copy_options::overwrite_existing);
+            std::fstream fs(bad, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            fs.seekp(offset);
+            fs.write(reinterpret_cast<const char *>(&count), sizeof(count));
+            fs.close();
+            assert(Throws(bad));
+        }
+
+        // Data of `X` moved off its 8-byte alignment, still inside the file
+        std::filesystem::copy_file(bin, bad, std::filesystem::copy_options::overwrite_existing);
+        {
+            std::fstream fs(bad, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+            std::uint64_t data_offset = 0;
+            fs.seekg(40 + 48 + 16);
+            fs.read(reinterpret_cast<char *>(&data_offset), sizeof(data_offset));
+            data_offset += 4;
+            fs.seekp(40 + 48 + 16);
+            fs.write(reinterpret_cast<const char *>(&data_offset), sizeof(data_offset));
+        }
+        assert(Throws(bad));
+        std::filesystem::remove(bad);
+    }
+
+    // Strings holding the separator or a line break cannot be written unquoted
+    {
+        const std::string out = (dir / "agtb_columnar_quoted.csv").string();
+        std::filesystem::remove(out);
+        ColumnarDataFrame<> df(2);
+        df.AddColumn<std::string>("Name", {"A", "B,C"});
+        df.AddColumn<double>("X", {1.0, 2.0});
+        WriteColumnarBinary(df, bin);
+
+        bool thrown = false;
+        try
+        {
+            ColumnarBinaryToCSV(bin, out);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            thrown = std::string_view(e.what()).contains("B,C");
+        }
+        assert(thrown && !std::filesystem::exists(out));
+
+        ColumnarBinaryToCSV(bin, out, ';');
+        assert(ReadColumnarCSV(out, ";").Cell(1, 0) == "B,C");
+        std::filesystem::remove(out);
+    }
+
+    const std::string csv = (dir / "agtb_columnar.csv").string();
+    const std::string back = (dir / "agtb_columnar_back.csv").string();
+    const size_t rows = 200'000;
+    WriteSurveyCsv(csv, rows);
+    CSVToColumnarBinary(csv, bin);
+    std::println("{} rows, csv {} bytes, binary {} bytes", rows, std::filesystem::file_size(csv), std::filesystem::file_size(bin));
+
+    // Csv -> binary -> Csv keeps every cell
+    {
+        ColumnarBinaryToCSV(bin, back);
+        auto expect = ReadColumnarCSV(csv);
+        auto again = ReadColumnarCSV(back);
+        assert(again.Rows() == rows && again.Cols() == expect.Cols());
+        for (size_t c = 0; c != expect.Cols(); ++c)
+        {
+            assert(again.TypeOf(c) == expect.TypeOf(c));
+            for (size_t r = 0; r < rows; r += 997)
+            {
+                assert(again.Cell(r, c) == expect.Cell(r, c));
+            }
+        }
+        assert((again.NumericSeries<double>("H") - expect.NumericSeries<double>("H")).cwiseAbs().maxCoeff() == 0.0);
+    }
+
+    double mean = 0.0;
+    std::println("Open + mean of H: ReadCSV<std::string> + NumericFrame<double>");
+    AGTB::timer.Tik();
+    {
+        auto text = ReadCSV<std::string>(csv, ",", true);
+        mean = text.ILoc(AGTB::Idx(0) >> text.Rows(), AGTB::Idx(3) >> 4).NumericFrame<double>().mean();
+    }
+    AGTB::timer.Tok();
+
+    std::println("Open + mean of H: ReadColumnarCSV");
+    AGTB::timer.Tik();
+    {
+        auto df = ReadColumnarCSV(csv);
+        assert(std::abs(df.NumericSeries<double>("H").mean() - mean) < 1e-9);
+    }
+    AGTB::timer.Tok();
+
+    std::println("Open only: MappedDataFrame");
+    AGTB::timer.Tik();
+    for (int loop = 0; loop != 100; ++loop)
+    {
+        MappedDataFrame df(bin);
+        assert(df.Rows() == rows);
+    }
+    AGTB::timer.Tok();
+
+    std::println("Open + mean of H: MappedDataFrame");
+    AGTB::timer.Tik();
+    {
+        MappedDataFrame df(bin);
+        assert(std::abs(df.NumericSeries<double>("H").mean() - mean) < 1e-9);
+        assert(df.Strings("Class").DictionarySize() == 2);
+    }
+    AGTB::timer.Tok();
+
+    std::filesystem::remove(csv);
+    std::filesystem::remove(back);
+    std::filesystem::remove(bin);
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <AGTB/Linalg/CorrectionOlsSolve.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <cassert>
+
+namespace al = AGTB::Linalg;
+using al::Matrix;
+
+template <int __unknowns>
+void Compare(Eigen::Index rows, int loop)
+{
+    const Matrix A = Matrix::Random(rows, __unknowns);
+    const Matrix L = Matrix::Random(rows, 1);
+
+    const Matrix x_qr = al::CorrectionOlsSolve(A, L);
+    const Eigen::Matrix<double, __unknowns, 1> x_fixed = al::Fixed::CorrectionOlsSolve<__unknowns>(A, L);
+    std::println("{} x {}: |x_fixed - x_qr| = {:.3e}", rows, __unknowns, (x_fixed - x_qr).cwiseAbs().maxCoeff());
+    assert((x_fixed - x_qr).cwiseAbs().maxCoeff() < 1e-12);
+
+    double sink = 0.0;
+    std::println("Dynamic QR x {}", loop);
+    AGTB::timer.Tik();
+    for (int i = 0; i != loop; ++i)
+    {
+        sink += al::CorrectionOlsSolve(A, L)(0, 0);
+    }
+    AGTB::timer.Tok();
+    std::println("Fixed LDLT x {}", loop);
+    AGTB::timer.Tik();
+    for (int i = 0; i != loop; ++i)
+    {
+        sink -= al::Fixed::CorrectionOlsSolve<__unknowns>(A, L)(0);
+    }
+    AGTB::timer.Tok();
+    assert(std::abs(sink) < 1e-6);
+}
+
+int main()
+{
+    // Intersection with 2 images and resection with 4 / 9 points
+    Compare<3>(4, 200'000);
+    Compare<6>(8, 200'000);
+    Compare<6>(18, 100'000);
+
+    // Columns of very different scale, as in resection (metres and radians), still solved by LDLT
+    Matrix A = Matrix::Random(12, 6);
+    A.leftCols<3>() *= 1e-4;
+    const Matrix L = Matrix::Random(12, 1);
+    assert((al::Fixed::CorrectionOlsSolve<6>(A, L) - al::CorrectionOlsSolve(A, L)).cwiseAbs().maxCoeff() < 1e-6);
+
+    // Nearly dependent columns fall back to QR
+    Matrix B = Matrix::Random(10, 3);
+    B.col(2) = B.col(0) + 1e-9 * B.col(1);
+    const Matrix LB = Matrix::Random(10, 1);
+    const Eigen::Vector3d x_fixed = al::Fixed::CorrectionOlsSolve<3>(B, LB);
+    const Matrix x_qr = al::CorrectionOlsSolve(B, LB);
+    std::println("Ill-conditioned: |x_fixed - x_qr| = {:.3e}", (x_fixed - x_qr).cwiseAbs().maxCoeff());
+    assert((x_fixed - x_qr).cwiseAbs().maxCoeff() == 0.0);
+
+    al::Fixed::NormalEquation<3> ne{};
+    for (Eigen::Index i = 0; i != B.rows(); ++i)
+    {
+        ne.Add(B.row(i), LB(i, 0));
+    }
+    Eigen::Vector3d x;
+    assert(!ne.Solve(x));
+
+    return 0;
+}
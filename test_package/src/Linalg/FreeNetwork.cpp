@@ -0,0 +1,152 @@
+#include <AGTB/Linalg/FreeNetwork.hpp>
+#include <AGTB/Linalg/NormalEquationMatrixInverse.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <cassert>
+
+namespace al = AGTB::Linalg;
+using al::FreeNetwork;
+using al::Matrix;
+
+/**
+ * @brief Pseudo-inverse the way `NormalEquationMatrixInverse<SVD>` used to compute it
+ *
+ */
+Matrix JacobiPseudoInverse(const Matrix &N)
+{
+    Eigen::JacobiSVD<Matrix> svd(N, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    const Eigen::VectorXd &sv = svd.singularValues();
+    const double tolerance = sv(0) * N.rows() * 1e-12;
+    Eigen::VectorXd inv = sv.unaryExpr([=](double s)
+                                       { return s > tolerance ? 1.0 / s : 0.0; });
+    return svd.matrixV() * inv.asDiagonal() * svd.matrixU().transpose();
+}
+
+/**
+ * @brief Levelling grid `rows x cols` without control, each edge is one height difference
+ *
+ */
+al::SparseMatrix LevellingNormal(int rows, int cols, std::mt19937_64 &gen)
+{
+    std::uniform_real_distribution<double> weight(0.5, 2.0);
+    std::vector<Eigen::Triplet<double>> triplets{};
+    auto add = [&](int i, int j)
+    {
+        const double p = weight(gen);
+        triplets.emplace_back(i, i, p);
+        triplets.emplace_back(j, j, p);
+        triplets.emplace_back(i, j, -p);
+        triplets.emplace_back(j, i, -p);
+    };
+    for (int r = 0; r != rows; ++r)
+    {
+        for (int c = 0; c != cols; ++c)
+        {
+            const int i = r * cols + c;
+            if (c + 1 != cols)
+                add(i, i + 1);
+            if (r + 1 != rows)
+                add(i, i + cols);
+        }
+    }
+    al::SparseMatrix N(rows * cols, rows * cols);
+    N.setFromTriplets(triplets.begin(), triplets.end());
+    return N;
+}
+
+int main()
+{
+    std::mt19937_64 gen(11);
+
+    // Plane distance net: defect 3 (two shifts, rotation)
+    {
+        const int n = 12;
+        Matrix xy = Matrix::Random(n, 2) * 500.0;
+        Matrix A = Matrix::Zero(n * (n - 1) / 2, 2 * n);
+        int r = 0;
+        for (int i = 0; i != n; ++i)
+        {
+            for (int j = i + 1; j != n; ++j, ++r)
+            {
+                const Eigen::RowVector2d d = xy.row(j) - xy.row(i);
+                const Eigen::RowVector2d u = d / d.norm();
+                A.block<1, 2>(r, 2 * i) = -u;
+                A.block<1, 2>(r, 2 * j) = u;
+            }
+        }
+        const Eigen::VectorXd l = Eigen::VectorXd::Random(A.rows()) * 0.01;
+        const Matrix N = A.transpose() * A;
+        const Eigen::VectorXd W = A.transpose() * l;
+        const Matrix G = FreeNetwork::PlaneDatum(xy);
+        assert((N * G).cwiseAbs().maxCoeff() < 1e-9);
+
+        const Matrix pinv_jacobi = JacobiPseudoInverse(N);
+        const Matrix pinv_eigen = al::NormalEquationMatrixInverse<AGTB::LinalgOption::SVD>(A);
+        const Matrix pinv_free = FreeNetwork::Inverse(N, G);
+        const Eigen::VectorXd x_svd = pinv_jacobi * W;
+        const Eigen::VectorXd x_dense = FreeNetwork::Solve(N, W, G);
+        const Eigen::VectorXd x_sparse = FreeNetwork::Solve(al::SparseMatrix(N.sparseView()), W, G);
+
+        std::println("Plane net: |Q_eig - Q_svd| = {:.3e}, |Q_free - Q_svd| = {:.3e}", (pinv_eigen - pinv_jacobi).cwiseAbs().maxCoeff(), (pinv_free - pinv_jacobi).cwiseAbs().maxCoeff());
+        std::println("Plane net: |x_dense - x_svd| = {:.3e}, |x_sparse - x_svd| = {:.3e}", (x_dense - x_svd).cwiseAbs().maxCoeff(), (x_sparse - x_svd).cwiseAbs().maxCoeff());
+        assert((pinv_eigen - pinv_jacobi).cwiseAbs().maxCoeff() < 1e-10);
+        assert((pinv_free - pinv_jacobi).cwiseAbs().maxCoeff() < 1e-10);
+        assert((x_dense - x_svd).cwiseAbs().maxCoeff() < 1e-12);
+        assert((x_sparse - x_svd).cwiseAbs().maxCoeff() < 1e-12);
+
+        // Datum on first four points only, then back to inner constraints by S-transformation
+        Eigen::VectorXd datum = Eigen::VectorXd::Zero(2 * n);
+        datum.head(8).setOnes();
+        const Eigen::VectorXd x_partial = FreeNetwork::Solve(N, W, G, datum);
+        assert((G.transpose() * datum.asDiagonal() * x_partial).cwiseAbs().maxCoeff() < 1e-12);
+        assert((N * x_partial - W).cwiseAbs().maxCoeff() < 1e-12);
+        const Eigen::VectorXd x_back = FreeNetwork::STransformation(G, Eigen::VectorXd::Ones(2 * n)) * x_partial;
+        assert((x_back - x_svd).cwiseAbs().maxCoeff() < 1e-12);
+        const Matrix Q_partial = FreeNetwork::Inverse(N, G, datum);
+        assert((N * Q_partial * N - N).cwiseAbs().maxCoeff() < 1e-9);
+    }
+
+    // Dense timings against the old full JacobiSVD
+    {
+        const int rows = 20, cols = 20;
+        const Matrix N = Matrix(LevellingNormal(rows, cols, gen));
+        const Eigen::VectorXd W = N * Eigen::VectorXd::Random(N.rows());
+        const Matrix G = FreeNetwork::HeightDatum(N.rows());
+
+        std::println("JacobiSVD pseudo-inverse, t = {}", N.rows());
+        AGTB::timer.Tik();
+        const Eigen::VectorXd x_svd = JacobiPseudoInverse(N) * W;
+        AGTB::timer.Tok();
+
+        std::println("FreeNetwork::Solve dense, t = {}", N.rows());
+        AGTB::timer.Tik();
+        const Eigen::VectorXd x_free = FreeNetwork::Solve(N, W, G);
+        AGTB::timer.Tok();
+        std::println("|x_free - x_svd| = {:.3e}", (x_free - x_svd).cwiseAbs().maxCoeff());
+        assert((x_free - x_svd).cwiseAbs().maxCoeff() < 1e-9);
+    }
+
+    // 10^4 unknowns, sparse
+    {
+        const int rows = 100, cols = 100;
+        const al::SparseMatrix N = LevellingNormal(rows, cols, gen);
+        const Eigen::VectorXd x_true = Eigen::VectorXd::Random(N.rows());
+        const Eigen::VectorXd W = N * x_true;
+        const Matrix G = FreeNetwork::HeightDatum(N.rows());
+
+        std::println("FreeNetwork::Solve sparse, t = {}", N.rows());
+        AGTB::timer.Tik();
+        const Eigen::VectorXd x = FreeNetwork::Solve(N, W, G);
+        AGTB::timer.Tok();
+
+        const Eigen::VectorXd expect = x_true.array() - x_true.mean();
+        std::println("|N x - W| = {:.3e}, sum x = {:.3e}, |x - x_true| = {:.3e}", (N * x - W).cwiseAbs().maxCoeff(), x.sum(), (x - expect).cwiseAbs().maxCoeff());
+        assert((N * x - W).cwiseAbs().maxCoeff() < 1e-9);
+        assert(std::abs(x.sum()) < 1e-8);
+        assert((x - expect).cwiseAbs().maxCoeff() < 1e-8);
+    }
+
+    return 0;
+}
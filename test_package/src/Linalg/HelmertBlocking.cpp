@@ -0,0 +1,132 @@
+#include <AGTB/Linalg/HelmertBlocking.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <cassert>
+#include <stdexcept>
+
+namespace al = AGTB::Linalg;
+using al::HelmertBlocking;
+using al::Matrix;
+
+/**
+ * @brief Levelling grid `size x size`, height differences to neighbours weighted `1 / len`, first and last point
+ * are controls (observations to them have one unknown only)
+ *
+ */
+HelmertBlocking::Observations LevellingGrid(int size, std::mt19937_64 &gen)
+{
+    std::uniform_real_distribution<double> len(0.3, 2.0), dif(-5.0, 5.0);
+    HelmertBlocking::Observations obs{};
+    const int last = size * size - 1;
+    auto add = [&](int i, int j)
+    {
+        const double p = 1.0 / len(gen);
+        if (i == 0)
+            obs.Add({{j - 1, 1.0}}, dif(gen), p);
+        else if (j == last)
+            obs.Add({{i - 1, -1.0}}, dif(gen), p);
+        else
+            obs.Add({{i - 1, -1.0}, {j - 1, 1.0}}, dif(gen), p);
+    };
+    for (int r = 0; r != size; ++r)
+    {
+        for (int c = 0; c != size; ++c)
+        {
+            const int i = r * size + c;
+            if (c + 1 != size)
+                add(i, i + 1);
+            if (r + 1 != size)
+                add(i, i + size);
+        }
+    }
+    return obs;
+}
+
+Eigen::VectorXd DirectSolve(Eigen::Index unknowns, const HelmertBlocking::Observations &obs, double &vpv)
+{
+    Matrix N = Matrix::Zero(unknowns, unknowns);
+    Eigen::VectorXd W = Eigen::VectorXd::Zero(unknowns);
+    for (size_t r = 0; r != obs.Size(); ++r)
+    {
+        for (size_t i = obs.Begin(r); i != obs.End(r); ++i)
+        {
+            W(obs.Column(i)) += obs.P(r) * obs.Value(i) * obs.L(r);
+            for (size_t j = obs.Begin(r); j != obs.End(r); ++j)
+            {
+                N(obs.Column(i), obs.Column(j)) += obs.P(r) * obs.Value(i) * obs.Value(j);
+            }
+        }
+    }
+    const Eigen::VectorXd x = N.llt().solve(W);
+    vpv = 0.0;
+    for (size_t r = 0; r != obs.Size(); ++r)
+    {
+        vpv += obs.P(r) * obs.Residual(r, x) * obs.Residual(r, x);
+    }
+    return x;
+}
+
+int main()
+{
+    std::mt19937_64 gen(7);
+
+    // Blocking reproduces the direct solution for any block size
+    {
+        const int size = 24;
+        const Eigen::Index t = size * size - 2;
+        const auto obs = LevellingGrid(size, gen);
+        double vpv_direct = 0.0;
+        const Eigen::VectorXd x_direct = DirectSolve(t, obs, vpv_direct);
+
+        for (Eigen::Index max_block : {1, 7, 40, 150, 1000})
+        {
+            const auto part = HelmertBlocking::NestedDissection(t, obs, max_block);
+            const auto result = HelmertBlocking::Solve(t, obs, part);
+            const double err = (result.x - x_direct).cwiseAbs().maxCoeff();
+            std::println("max_block {:>4}: {:>3} blocks, {:>3} junctions, largest {:>3}, |x - x_direct| = {:.3e}",
+                         max_block, result.blocks, result.junctions, result.largest_block, err);
+            assert(result.largest_block <= max_block);
+            assert(err < 1e-10);
+            assert(std::abs(result.vpv - vpv_direct) < 1e-9 * vpv_direct);
+        }
+        std::print("{}", HelmertBlocking::Solve(t, obs, {.max_block = 64, .threads = 4}).ToString());
+
+        // Two blocks joined through an observation between their interiors
+        HelmertBlocking::Partition bad{.block_of = std::vector<Eigen::Index>(t, 0), .blocks = 2};
+        std::fill(bad.block_of.begin() + t / 2, bad.block_of.end(), 1);
+        bool thrown = false;
+        try
+        {
+            HelmertBlocking::Solve(t, obs, bad);
+        }
+        catch (const std::invalid_argument &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    // Larger net against the dense normal equations
+    {
+        const int size = 60;
+        const Eigen::Index t = size * size - 2;
+        const auto obs = LevellingGrid(size, gen);
+
+        double vpv_direct = 0.0;
+        std::println("Dense normal equations, t = {}", t);
+        AGTB::timer.Tik();
+        const Eigen::VectorXd x_direct = DirectSolve(t, obs, vpv_direct);
+        AGTB::timer.Tok();
+
+        std::println("Helmert blocking, t = {}", t);
+        AGTB::timer.Tik();
+        const auto result = HelmertBlocking::Solve(t, obs, {.max_block = 256});
+        AGTB::timer.Tok();
+        std::print("{}", result.ToString());
+        assert((result.x - x_direct).cwiseAbs().maxCoeff() < 1e-10);
+    }
+
+    return 0;
+}
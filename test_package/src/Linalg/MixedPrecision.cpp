@@ -0,0 +1,164 @@
+#include <AGTB/Linalg/MixedPrecision.hpp>
+#include <AGTB/Linalg/NormalEquationMatrixInverse.hpp>
+#include <AGTB/Linalg/CorrectionOlsSolve.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <cassert>
+#include <string_view>
+
+namespace al = AGTB::Linalg;
+using al::Matrix;
+
+/**
+ * @brief Levelling grid `size x size`, weight `1 / len`, corners fixed by strong pseudo observations
+ *
+ */
+Matrix LevellingNormal(int size, std::mt19937_64 &gen)
+{
+    std::uniform_real_distribution<double> len(0.3, 2.0);
+    const int t = size * size;
+    Matrix N = Matrix::Zero(t, t);
+    auto add = [&](int i, int j)
+    {
+        const double p = 1.0 / len(gen);
+        N(i, i) += p;
+        N(j, j) += p;
+        N(i, j) -= p;
+        N(j, i) -= p;
+    };
+    for (int r = 0; r != size; ++r)
+    {
+        for (int c = 0; c != size; ++c)
+        {
+            const int i = r * size + c;
+            if (c + 1 != size)
+                add(i, i + 1);
+            if (r + 1 != size)
+                add(i, i + size);
+        }
+    }
+    for (int i : {0, size - 1, t - size, t - 1})
+    {
+        N(i, i) += 1e3;
+    }
+    return N;
+}
+
+/**
+ * @brief Traverse-like plane grid `size x size` (m), distances (2 mm) and directions (2") to neighbours and
+ * diagonals, corners fixed by strong pseudo observations. Unknowns are `(dx, dy)` per point in mm.
+ *
+ */
+Matrix TraverseNormal(int size, std::mt19937_64 &gen)
+{
+    std::uniform_real_distribution<double> jitter(-20.0, 20.0);
+    const int n = size * size, t = 2 * n;
+    Matrix xy(n, 2);
+    for (int r = 0; r != size; ++r)
+    {
+        for (int c = 0; c != size; ++c)
+        {
+            xy.row(r * size + c) << r * 300.0 + jitter(gen), c * 300.0 + jitter(gen);
+        }
+    }
+
+    Matrix N = Matrix::Zero(t, t);
+    const double rho = 206264.806, p_dist = 1.0 / (2.0 * 2.0), p_dir = 1.0 / (2.0 * 2.0);
+    auto add_row = [&](int i, int j, double ax, double ay, double p)
+    {
+        const int idx[4] = {2 * i, 2 * i + 1, 2 * j, 2 * j + 1};
+        const double a[4] = {-ax, -ay, ax, ay};
+        for (int u = 0; u != 4; ++u)
+            for (int v = 0; v != 4; ++v)
+                N(idx[u], idx[v]) += p * a[u] * a[v];
+    };
+    auto observe = [&](int i, int j)
+    {
+        const double dx = xy(j, 0) - xy(i, 0), dy = xy(j, 1) - xy(i, 1), s2 = dx * dx + dy * dy, s = std::sqrt(s2);
+        add_row(i, j, dx / s, dy / s, p_dist);
+        add_row(i, j, -rho * dy / s2 / 1000.0, rho * dx / s2 / 1000.0, p_dir);
+    };
+    for (int r = 0; r != size; ++r)
+    {
+        for (int c = 0; c != size; ++c)
+        {
+            const int i = r * size + c;
+            if (c + 1 != size)
+                observe(i, i + 1);
+            if (r + 1 != size)
+                observe(i, i + size);
+            if (r + 1 != size && c + 1 != size)
+                observe(i, i + size + 1);
+        }
+    }
+    for (int i : {0, size - 1, n - size, n - 1})
+    {
+        N(2 * i, 2 * i) += 1e4;
+        N(2 * i + 1, 2 * i + 1) += 1e4;
+    }
+    return N;
+}
+
+void Report(std::string_view name, const Matrix &N, std::mt19937_64 &gen)
+{
+    const Eigen::VectorXd x_true = Eigen::VectorXd::Random(N.rows()) * 10.0;
+    const Eigen::VectorXd W = N * x_true;
+
+    std::println("{:-^60}", std::format(" {} t = {} ", name, N.rows()));
+    std::println("double LLT:");
+    AGTB::timer.Tik();
+    const Eigen::VectorXd x_double = N.llt().solve(W);
+    AGTB::timer.Tok();
+
+    std::println("mixed precision:");
+    AGTB::timer.Tik();
+    const auto mixed = al::SolveMixedPrecision(N, W);
+    AGTB::timer.Tok();
+    std::print("{}", mixed.ToString());
+
+    const Eigen::VectorXd x_float = N.cast<float>().llt().solve(W.cast<float>()).cast<double>();
+    const double
+        err_double = (x_double - x_true).cwiseAbs().maxCoeff(),
+        err_mixed = (mixed.x - x_true).cwiseAbs().maxCoeff(),
+        err_float = (x_float - x_true).cwiseAbs().maxCoeff();
+    std::println("max error: float {:.3e}, double {:.3e}, mixed {:.3e}", err_float, err_double, err_mixed);
+    assert(err_mixed <= 10.0 * err_double + 1e-12);
+    assert(err_mixed < err_float);
+}
+
+int main()
+{
+    std::mt19937_64 gen(5);
+
+    const Matrix levelling = LevellingNormal(48, gen);
+    Report("Levelling", levelling, gen);
+    assert(al::SolveMixedPrecision(levelling, Eigen::VectorXd::Ones(levelling.rows())).status == al::detail::MixedPrecision::Status::Refined);
+
+    const Matrix traverse = TraverseNormal(32, gen);
+    Report("Traverse", traverse, gen);
+
+    // Forced fallback: float cannot factor a matrix that double still can
+    Matrix tiny = Matrix::Identity(3, 3);
+    tiny(0, 1) = tiny(1, 0) = 1.0 - 1e-10;
+    auto fallback = al::SolveMixedPrecision(tiny, Eigen::Vector3d(1.0, 2.0, 3.0));
+    std::print("{}", fallback.ToString());
+    assert(fallback.status != al::detail::MixedPrecision::Status::Refined);
+    assert((tiny * fallback.x - Eigen::Vector3d(1.0, 2.0, 3.0)).cwiseAbs().maxCoeff() < 1e-5);
+
+    // Through the existing entry points
+    const Matrix A = Matrix::Random(3000, 200);
+    const Matrix L = Matrix::Random(3000, 1);
+    const Matrix x_qr = al::CorrectionOlsSolve(A, L);
+    const Matrix x_mixed = al::CorrectionOlsSolve<AGTB::LinalgOption::MixedPrecision>(A, L);
+    std::println("CorrectionOlsSolve QR vs mixed: {:.3e}", (x_qr - x_mixed).cwiseAbs().maxCoeff());
+    assert((x_qr - x_mixed).cwiseAbs().maxCoeff() < 1e-12);
+
+    const Matrix inv_double = al::NormalEquationMatrixInverse<AGTB::LinalgOption::Cholesky>(A);
+    const Matrix inv_mixed = al::NormalEquationMatrixInverse<AGTB::LinalgOption::MixedPrecision>(A);
+    std::println("NormalEquationMatrixInverse Cholesky vs mixed: {:.3e}", (inv_double - inv_mixed).cwiseAbs().maxCoeff());
+    assert((inv_double - inv_mixed).cwiseAbs().maxCoeff() < 1e-14);
+
+    return 0;
+}
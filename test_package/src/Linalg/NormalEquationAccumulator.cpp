@@ -0,0 +1,127 @@
+#include <AGTB/Linalg/NormalEquationAccumulator.hpp>
+#include <AGTB/Linalg/NormalEquationMatrixInverse.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <ranges>
+#include <random>
+#include <cassert>
+
+namespace al = AGTB::Linalg;
+using al::NormalEquationAccumulator;
+
+/**
+ * @brief Sparse-ish deterministic observation `i`: 4 nonzero coefficients, like a levelling or distance row
+ *
+ */
+void FillObservation(size_t i, NormalEquationAccumulator::RowRef a, double &l, double &p)
+{
+    const Eigen::Index t = a.size();
+    std::minstd_rand gen(static_cast<std::uint_fast32_t>(i + 1));
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (int k = 0; k != 4; ++k)
+    {
+        a(static_cast<Eigen::Index>(gen() % t)) += dist(gen);
+    }
+    l = dist(gen) * 10.0;
+    p = 0.5 + (i % 7) * 0.25;
+}
+
+struct Observation
+{
+    Eigen::RowVectorXd a;
+    double l, p;
+};
+
+int main()
+{
+    const Eigen::Index t = 120;
+    const size_t n = 200'000;
+
+    // Dense reference
+    al::Matrix A = al::Matrix::Zero(n, t);
+    Eigen::VectorXd l(n), p(n);
+    for (size_t i = 0; i != n; ++i)
+    {
+        Eigen::RowVectorXd row = Eigen::RowVectorXd::Zero(t);
+        FillObservation(i, row, l(i), p(i));
+        A.row(i) = row;
+    }
+
+    std::println("Dense A.T * P * A, {} x {}", n, t);
+    AGTB::timer.Tik();
+    const al::Matrix N_dense = A.transpose() * p.asDiagonal() * A;
+    const Eigen::VectorXd W_dense = A.transpose() * p.asDiagonal() * l;
+    AGTB::timer.Tok();
+    const double scale = N_dense.cwiseAbs().maxCoeff();
+
+    // Row by row
+    NormalEquationAccumulator serial(t);
+    std::println("Accumulator, Add row by row");
+    AGTB::timer.Tik();
+    for (size_t i = 0; i != n; ++i)
+    {
+        serial.Add(A.row(i), l(i), p(i));
+    }
+    auto ne_serial = serial.Result();
+    AGTB::timer.Tok();
+    assert(ne_serial.observations == n);
+    assert((ne_serial.N - N_dense).cwiseAbs().maxCoeff() < 1e-12 * scale);
+    assert((ne_serial.W - W_dense).cwiseAbs().maxCoeff() < 1e-12 * W_dense.cwiseAbs().maxCoeff());
+
+    // Lazily generated range, design matrix never exists
+    NormalEquationAccumulator streamed(t);
+    auto observations = std::views::iota(size_t{0}, n) |
+                        std::views::transform(
+                            [t](size_t i)
+                            {
+                                Observation obs{Eigen::RowVectorXd::Zero(t), 0.0, 1.0};
+                                FillObservation(i, obs.a, obs.l, obs.p);
+                                return obs;
+                            });
+    std::println("Accumulator, AddRange over generated observations");
+    AGTB::timer.Tik();
+    streamed.AddRange(observations);
+    auto ne_streamed = streamed.Result();
+    AGTB::timer.Tok();
+    assert(ne_streamed.N == ne_serial.N);
+
+    // Parallel, reproducible for any thread count
+    al::Matrix N_first;
+    for (size_t threads : {1, 2, 4})
+    {
+        NormalEquationAccumulator parallel(t, {.threads = threads});
+        std::println("Accumulator, AddParallel with {} threads", threads);
+        AGTB::timer.Tik();
+        parallel.AddParallel(n, FillObservation);
+        auto ne = parallel.Result();
+        AGTB::timer.Tok();
+        assert((ne.N - N_dense).cwiseAbs().maxCoeff() < 1e-12 * scale);
+        if (N_first.size() == 0)
+        {
+            N_first = ne.N;
+        }
+        assert(ne.N == N_first);
+    }
+
+    // One partition is accumulated in place, same sums as row by row
+    {
+        NormalEquationAccumulator in_place(t, {.partitions = 1});
+        in_place.AddParallel(n, FillObservation);
+        auto ne = in_place.Result();
+        assert(ne.observations == n && ne.N == ne_serial.N);
+    }
+
+    // Solution and residuals without V
+    const Eigen::VectorXd x = ne_serial.Solve();
+    const Eigen::VectorXd V = A * x - l;
+    const double vpv = V.dot(p.asDiagonal() * V);
+    std::println("VPV {} vs {}", ne_serial.VPV(x), vpv);
+    assert(std::abs(ne_serial.VPV(x) - vpv) < 1e-8 * vpv);
+
+    const al::Matrix small = A.topRows(2000);
+    const al::Matrix inv = al::NormalEquationMatrixInverse<AGTB::LinalgOption::Cholesky>(small);
+    assert(((small.transpose() * small) * inv - al::Matrix::Identity(t, t)).cwiseAbs().maxCoeff() < 1e-8);
+
+    return 0;
+}
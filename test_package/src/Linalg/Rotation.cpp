@@ -0,0 +1,57 @@
+#include <AGTB/Linalg/CoordinateSystemTranform.hpp>
+#include <AGTB/Utils/Timer.hpp>
+#include <print>
+#include <cassert>
+
+namespace al = AGTB::Linalg;
+using al::Axis;
+
+int main()
+{
+    const double phi = 0.12, omega = -0.05, kappa = 1.3;
+
+    al::Matrix dynamic = al::CsRotationMatrix<Axis::Y, Axis::X, Axis::Z>(phi, omega, kappa);
+    al::Matrix3 fixed = al::Fixed::CsRotationMatrix<Axis::Y, Axis::X, Axis::Z>(phi, omega, kappa);
+    Eigen::Quaterniond q = al::Fixed::CsRotationQuaternion<Axis::Y, Axis::X, Axis::Z>(phi, omega, kappa);
+    assert((dynamic - fixed).cwiseAbs().maxCoeff() < 1e-15);
+    assert((q.toRotationMatrix() - fixed).cwiseAbs().maxCoeff() < 1e-15);
+
+    const int loop = 1'000'000;
+    double sink = 0.0;
+    std::println("Dynamic CsRotationMatrix x {}", loop);
+    AGTB::timer.Tik();
+    for (int i = 0; i != loop; ++i)
+    {
+        sink += al::CsRotationMatrix<Axis::Y, Axis::X, Axis::Z>(phi + i * 1e-9, omega, kappa)(0, 0);
+    }
+    AGTB::timer.Tok();
+    std::println("Fixed CsRotationMatrix x {}", loop);
+    AGTB::timer.Tik();
+    for (int i = 0; i != loop; ++i)
+    {
+        sink -= al::Fixed::CsRotationMatrix<Axis::Y, Axis::X, Axis::Z>(phi + i * 1e-9, omega, kappa)(0, 0);
+    }
+    AGTB::timer.Tok();
+    assert(std::abs(sink) < 1e-6);
+
+    // In place transforms on row-major coordinates, on a Map and on a block
+    const Eigen::Index n = 1'000'000;
+    al::Matrix xyz = al::Matrix::Random(n, 3) * 1000.0;
+
+    std::println("Copying CsTranslate + CsRotateForward, {} points", n);
+    AGTB::timer.Tik();
+    al::Matrix expect = al::CsRotateForward(al::CsTranslate(xyz, 1.0, 2.0, 3.0), dynamic);
+    AGTB::timer.Tok();
+
+    al::Coordinates coords = xyz;
+    std::println("In place CsTranslate + CsRotateForward, {} points", n);
+    AGTB::timer.Tik();
+    al::CsTranslate(coords, 1.0, 2.0, 3.0);
+    al::CsRotateForward(coords, fixed);
+    AGTB::timer.Tok();
+    assert((coords - expect).cwiseAbs().maxCoeff() < 1e-9);
+
+    al::CsRotateInverse(Eigen::Map<al::Coordinates>(coords.data(), n, 3), fixed);
+    al::CsTranslate(coords.topRows(n), -1.0, -2.0, -3.0);
+    assert((coords - xyz).cwiseAbs().maxCoeff() < 1e-9);
+}
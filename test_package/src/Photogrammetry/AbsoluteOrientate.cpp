@@ -0,0 +1,57 @@
+#include <AGTB/Photogrammetry.hpp>
+#include <AGTB/Utils/Timer.hpp>
+#include <print>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace ap = AGTB::Photogrammetry;
+using Points = ap::AbsoluteOrientate::Points;
+
+Points MakeGround(const Points &model, const ap::AbsoluteOrientationElements &e)
+{
+    const ap::Matrix R = AGTB::Linalg::CsRotationMatrix<AGTB::Linalg::Axis::Y, AGTB::Linalg::Axis::X, AGTB::Linalg::Axis::Z>(e.Phi, e.Omega, e.Kappa);
+    Points ground = e.Lambda * model * R.transpose();
+    ground.rowwise() += Eigen::RowVector3d(e.X, e.Y, e.Z);
+    return ground;
+}
+
+int main()
+{
+    ap::AbsoluteOrientationElements truth{.X = 5000.0, .Y = 3000.0, .Z = 200.0, .Lambda = 9.7, .Phi = 0.12, .Omega = -0.05, .Kappa = 1.3};
+
+    Points model = Points::Random(8, 3) * 50.0;
+    Points ground = MakeGround(model, truth);
+    ground += Points::Random(8, 3) * 0.01;
+
+    ap::AbsoluteOrientate::Result result = ap::AbsoluteOrientate::Solve({model, ground});
+    std::println("{}", result.ToString());
+    assert(result.info == ap::IterativeSolutionInfo::Success);
+    assert(std::abs(result.elements.Lambda - truth.Lambda) < 1e-3);
+    assert(std::abs(result.elements.Kappa - truth.Kappa) < 1e-4);
+
+    // Thousands of models sharing two contiguous buffers
+    const Eigen::Index models = 5000, per_model = 6;
+    Points all_model = Points::Random(models * per_model, 3) * 50.0, all_ground(models * per_model, 3);
+    std::vector<ap::AbsoluteOrientate::Param> params{};
+    params.reserve(models);
+    for (Eigen::Index i = 0; i != models; ++i)
+    {
+        ap::AbsoluteOrientationElements e = truth;
+        e.Kappa = 0.001 * i;
+        all_ground.middleRows(i * per_model, per_model) = MakeGround(all_model.middleRows(i * per_model, per_model), e);
+        params.push_back({all_model.middleRows(i * per_model, per_model), all_ground.middleRows(i * per_model, per_model)});
+    }
+
+    std::vector<ap::AbsoluteOrientate::Result> results(models);
+    std::println("Batch absolute orientation of {} models", models);
+    AGTB::timer.Tik();
+    ap::AbsoluteOrientate::SolveBatch(params, results);
+    AGTB::timer.Tok();
+
+    for (Eigen::Index i = 0; i != models; ++i)
+    {
+        assert(results[i].info == ap::IterativeSolutionInfo::Success);
+        assert(std::abs(std::remainder(results[i].elements.Kappa - 0.001 * i, 2 * std::numbers::pi)) < 1e-9);
+    }
+}
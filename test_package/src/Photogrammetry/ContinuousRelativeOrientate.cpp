@@ -1,9 +1,81 @@
 #include <AGTB/Photogrammetry/ContinuousRelativeOrientate.hpp>
+#include <AGTB/Photogrammetry/SpaceMath/Transform.hpp>
+#include <AGTB/Utils/Timer.hpp>
+#include <print>
+#include <cassert>
+#include <cmath>
 
 namespace ap = AGTB::Photogrammetry;
 
+/**
+ * @brief Synthetic stereo pair, left photo at origin without rotation, right one at `(Bx, By, Bz)` rotated by
+ * `(phi, omega, kappa)`
+ *
+ */
+ap::ContinuousRelativeOrienteParam MakePair(Eigen::Index n, double By, double Bz, double phi, double omega, double kappa)
+{
+    const double f = 0.15, Bx = 0.09 * 1000 / 0.15 * 0.1;
+    ap::Matrix obj = ap::Matrix::Random(n, 3);
+    obj.col(0) = (obj.col(0).array() * 250.0 + Bx / 2).matrix();
+    obj.col(1) = (obj.col(1).array() * 250.0).matrix();
+    obj.col(2) = (obj.col(2).array() * 30.0 - 1000.0).matrix();
+
+    ap::ExteriorOrientationElements
+        left{0, 0, 0, 0, 0, 0},
+        right{Bx, By, Bz, phi, omega, kappa};
+    ap::InteriorOrientationElements in{.f = f};
+
+    return ap::ContinuousRelativeOrienteParam{
+        .xy1 = ap::Transform::Obj2Img(obj, left, in),
+        .xy2 = ap::Transform::Obj2Img(obj, right, in),
+        .in1 = in,
+        .in2 = in};
+}
+
 int main()
 {
-    ap::ContinuousRelativeOrienteParam p{};
+    const double Bx = 0.09 * 1000 / 0.15 * 0.1, By = 1.2, Bz = -0.8, phi = 0.012, omega = -0.008, kappa = 0.021;
+    ap::ContinuousRelativeOrienteParam p = MakePair(2000, By, Bz, phi, omega, kappa);
+
+    AGTB::timer.Tik();
     ap::ContinuousRelativeOrienteResult r = ap::Solve(p);
-}
\ No newline at end of file
+    AGTB::timer.Tok();
+    std::println("{}", r.ToString());
+
+    // Mu, Nu are relative to mean x-parallax, which differs from true Bx by model scale only
+    assert(r.info == ap::IterativeSolutionInfo::Success);
+    assert(std::abs(r.cro.Phi - phi) < 1e-6);
+    assert(std::abs(r.cro.Omega - omega) < 1e-6);
+    assert(std::abs(r.cro.Kappa - kappa) < 1e-6);
+    assert(std::abs(r.cro.Mu - By / Bx) < 1e-6);
+    assert(std::abs(r.cro.Nu - Bz / Bx) < 1e-6);
+
+    // Five points leave no redundancy for `m0`
+    bool thrown = false;
+    try
+    {
+        ap::Solve(MakePair(5, By, Bz, phi, omega, kappa));
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(std::isfinite(ap::Solve(MakePair(6, By, Bz, phi, omega, kappa)).m0));
+
+    std::vector<ap::ContinuousRelativeOrienteParam> pairs{};
+    for (int i = 0; i != 64; ++i)
+    {
+        pairs.push_back(MakePair(1000, By, Bz, phi * (i % 5), omega, kappa));
+    }
+
+    std::println("Batch of {} stereo pairs", pairs.size());
+    AGTB::timer.Tik();
+    auto batch = ap::SolveBatch(pairs);
+    AGTB::timer.Tok();
+    for (size_t i = 0; i != batch.size(); ++i)
+    {
+        assert(batch[i].info == ap::IterativeSolutionInfo::Success);
+        assert(std::abs(batch[i].cro.Phi - phi * (i % 5)) < 1e-6);
+    }
+}
@@ -0,0 +1,83 @@
+#include <AGTB/Photogrammetry.hpp>
+#include <AGTB/Utils/Timer.hpp>
+#include <print>
+#include <cassert>
+#include <cmath>
+
+namespace ap = AGTB::Photogrammetry;
+
+int main()
+{
+    ap::InteriorOrientationElements in{
+        .x0 = 0.0,
+        .y0 = 0.0,
+        .f = 0.15324,
+        .m = 50000,
+        .distortion = {.k1 = -2.5, .k2 = 40.0, .k3 = 0.0, .p1 = 3e-5, .p2 = -2e-5}};
+    std::println("{}", in.ToString());
+
+    // Measured point whose corrected value is `ideal`, by fixed point iteration
+    auto distort = [&](double x, double y)
+    {
+        double xm = x, ym = y;
+        for (int i = 0; i != 20; ++i)
+        {
+            double dx, dy;
+            in.distortion.Of(xm - in.x0, ym - in.y0, dx, dy);
+            xm = x + dx;
+            ym = y + dy;
+        }
+        return std::pair{xm, ym};
+    };
+
+    // Space resection on distorted measurements
+    ap::ExteriorOrientationElements truth{39795.452, 27476.462, 7572.685, -0.003987, 0.002114, -0.067578};
+    ap::Matrix object(6, 3);
+    object << 36589.41, 25273.32, 2195.17,
+        37631.08, 31324.51, 728.69,
+        39100.97, 24934.98, 2386.50,
+        40426.54, 30319.81, 757.31,
+        38000.00, 28000.00, 1500.00,
+        41000.00, 26000.00, 1800.00;
+    ap::Matrix ideal = ap::Transform::Obj2Img(object, truth, in);
+    ap::Matrix measured(ideal.rows(), 2);
+    for (Eigen::Index i = 0; i != ideal.rows(); ++i)
+    {
+        auto [xm, ym] = distort(ideal(i, 0), ideal(i, 1));
+        measured.row(i) << xm, ym;
+    }
+
+    ap::SpaceResection::Result result = ap::SpaceResection::Solve({.interior = in, .image = measured, .object = object});
+    std::println("{}", result.ToString());
+    assert(result.info == ap::IterativeSolutionInfo::Success);
+    assert(std::abs(result.exterior.Xs - truth.Xs) < 1e-2);
+    assert(std::abs(result.exterior.Kappa - truth.Kappa) < 1e-6);
+
+    // Bulk correction, polynomial vs lookup table
+    const Eigen::Index n = 4'000'000;
+    ap::Matrix image = ap::Matrix::Random(n, 2) * 0.115;
+
+    std::println("Polynomial undistortion, {} points", n);
+    AGTB::timer.Tik();
+    ap::Matrix poly = ap::Distortion::Undistort(image, in);
+    AGTB::timer.Tok();
+
+    auto lut = ap::Distortion::UndistortionLUT::WithTolerance(in, {-0.115, 0.115, -0.115, 0.115}, 1e-7);
+    std::println("LUT {} x {} nodes, {} bytes, max error {}", lut.NodesX(), lut.NodesY(), lut.Bytes(), lut.MaxError());
+
+    std::println("LUT undistortion, {} points", n);
+    ap::Matrix fast(n, 2);
+    AGTB::timer.Tik();
+    lut.Apply(image, fast);
+    AGTB::timer.Tok();
+
+    double max_dif = (poly - fast).cwiseAbs().maxCoeff();
+    std::println("max |polynomial - LUT| = {}", max_dif);
+    assert(max_dif <= 1e-7);
+
+    // Outside of table falls back to polynomial
+    double x = 0.2, y = -0.2, ex = x, ey = y;
+    lut.Undistort(x, y);
+    in.Undistort(ex, ey);
+    assert(x == ex && y == ey);
+}
@@ -0,0 +1,55 @@
+#include <AGTB/Photogrammetry.hpp>
+#include <print>
+#include <cassert>
+#include <cmath>
+
+namespace ap = AGTB::Photogrammetry;
+
+int main()
+{
+    using Ortho = ap::Orthorectify;
+    const Eigen::Index rows = 3000, cols = 3000;
+
+    Ortho::RasterMatrix Z(rows, cols), x(rows, cols), y(rows, cols);
+    for (Eigen::Index r = 0; r != rows; ++r)
+    {
+        for (Eigen::Index c = 0; c != cols; ++c)
+        {
+            Z(r, c) = 100.0 + 20.0 * std::sin(r * 1e-2) * std::cos(c * 1e-2);
+        }
+    }
+
+    Ortho::Param param{
+        .dem = {.X0 = 4000.0, .Y0 = 6000.0, .dX = 2.0 / 3.0, .dY = -2.0 / 3.0, .Z = {Z.data(), rows, cols}},
+        .exterior = {4999.770168, 4999.728897, 2000.002353, 0.00021500, 0.02906441, 0.09524706},
+        .interior = {.f = 0.15},
+        .image = {.x = {x.data(), rows, cols}, .y = {y.data(), rows, cols}}};
+
+    Ortho::Result single = Ortho::Solve(param, {.threads = 1});
+    std::println("{}", single.ToString());
+
+    Ortho::Result result = Ortho::Solve(param);
+    std::println("{}", result.ToString());
+
+    // Ragged tiles on the borders
+    Ortho::Result ragged = Ortho::Solve(param, {.tile_rows = 37, .tile_cols = 301, .threads = 4});
+    std::println("{}", ragged.ToString());
+
+    // Cross check a strided sample against the reference transform
+    const Eigen::Index stride = 97;
+    const Eigen::Index n = ((rows + stride - 1) / stride) * ((cols + stride - 1) / stride);
+    ap::Matrix obj(n, 3), ref_xy(n, 2);
+    Eigen::Index i = 0;
+    for (Eigen::Index r = 0; r < rows; r += stride)
+    {
+        for (Eigen::Index c = 0; c < cols; c += stride, ++i)
+        {
+            obj.row(i) << param.dem.X0 + c * param.dem.dX, param.dem.Y0 + r * param.dem.dY, Z(r, c);
+            ref_xy.row(i) << x(r, c), y(r, c);
+        }
+    }
+    ap::Matrix expect = ap::Transform::Obj2Img(obj, param.exterior, param.interior);
+    double max_dif = (expect - ref_xy).cwiseAbs().maxCoeff();
+    std::println("max |Obj2Img - Orthorectify| = {}", max_dif);
+    assert(max_dif < 1e-12);
+}
@@ -0,0 +1,41 @@
+#include <AGTB/Photogrammetry.hpp>
+#include <AGTB/Utils/Timer.hpp>
+#include <print>
+#include <cassert>
+
+namespace ap = AGTB::Photogrammetry;
+
+int main()
+{
+    const Eigen::Index n = 1'000'000;
+
+    ap::ExteriorOrientationElements ex{4999.770168, 4999.728897, 2000.002353, 0.00021500, 0.02906441, 0.09524706};
+    ap::InteriorOrientationElements in{.f = 0.15};
+
+    ap::Matrix obj = ap::Matrix::Random(n, 3);
+    obj.col(0) = (obj.col(0).array() * 500.0 + 5000.0).matrix();
+    obj.col(1) = (obj.col(1).array() * 500.0 + 5000.0).matrix();
+    obj.col(2) = (obj.col(2).array() * 20.0 + 100.0).matrix();
+
+    std::println("Chained Obj2Img, {} points", n);
+    AGTB::timer.Tik();
+    ap::Matrix chained = ap::Transform::Obj2Img(obj, ex, in);
+    AGTB::timer.Tok();
+
+    std::println("Fused Obj2ImgFused, {} points", n);
+    ap::Matrix fused(n, 2);
+    AGTB::timer.Tik();
+    ap::Transform::Obj2ImgFused(obj, ex, in, fused);
+    AGTB::timer.Tok();
+
+    double max_dif = (chained - fused).cwiseAbs().maxCoeff();
+    std::println("max |chained - fused| = {}", max_dif);
+    assert(max_dif < 1e-12);
+
+    // Row-major Map as input and a block as output, no copy on either side
+    Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> obj_rm = obj;
+    Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>> obj_view(obj_rm.data(), n, 3);
+    ap::Matrix img_and_more(n, 4);
+    ap::Transform::Obj2ImgFused<ap::Transform::YXZ>(obj_view, ex, in, img_and_more.leftCols(2));
+    assert((img_and_more.leftCols(2) - chained).cwiseAbs().maxCoeff() < 1e-12);
+}
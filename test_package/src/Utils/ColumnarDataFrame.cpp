@@ -0,0 +1,110 @@
+#include <AGTB/Container/ColumnarDataFrame.hpp>
+#include <AGTB/IO/CSV.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <random>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+
+using AGTB::ColumnarDataFrame;
+using AGTB::ColumnType;
+using AGTB::IO::ReadColumnarCSV;
+using AGTB::IO::ReadCSV;
+
+/**
+ * @brief Survey table `Name, X, Y, H, Code`, names are numeric for every other point
+ *
+ */
+void WriteSurveyCsv(const std::string &path, size_t rows)
+{
+    std::mt19937_64 gen(1);
+    std::uniform_real_distribution<double> coord(0.0, 1e5);
+    std::ofstream os(path);
+    os << "Name,X,Y,H,Code\n";
+    for (size_t r = 0; r != rows; ++r)
+    {
+        const std::string name = r % 2 == 0 ? std::to_string(1000 + r) : std::format("P{}", r);
+        os << std::format("{},{:.4f},{:.4f},{:.4f},{}\n", name, coord(gen), coord(gen), coord(gen) / 100, r % 7);
+    }
+}
+
+int main()
+{
+    ColumnarDataFrame<> df{};
+    df.AddColumn<std::string>("Name", {"A", "B", "C"});
+    df.AddColumn<double>("X", {1.0, 2.0, 3.0});
+    df.AddColumn<std::int64_t>("Code", {7, 8, 9});
+    auto &y = df.AddColumn<double>("Y");
+    y[1] = 5.0;
+    std::println("Columnar frame:\n{}", df.ToString());
+
+    // Zero-copy maps write through to the column
+    auto x = df.NumericSeries<double>("X");
+    x *= 2.0;
+    assert(df.ILoc<double>(2, 1) == 6.0);
+    assert(x.data() == df.Loc<double>("X").data());
+    assert(df.TypeOf("Code") == ColumnType::Integer);
+    assert(df.NumericFrame<double>({"X", "Y", "Code"})(1, 2) == 8.0);
+
+    bool thrown = false;
+    try
+    {
+        df.NumericSeries<double>("Code");
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try
+    {
+        df.AddColumn<double>("Z", {1.0});
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    const std::string path = (std::filesystem::temp_directory_path() / "agtb_columnar.csv").string();
+    const size_t rows = 200'000;
+    WriteSurveyCsv(path, rows);
+
+    std::println("ReadColumnarCSV, {} rows", rows);
+    AGTB::timer.Tik();
+    auto survey = ReadColumnarCSV(path, ",", true, {{"Name", ColumnType::String}});
+    AGTB::timer.Tok();
+    assert(survey.Rows() == rows && survey.Cols() == 5);
+    assert(survey.TypeOf("Name") == ColumnType::String);
+    assert(survey.TypeOf("X") == ColumnType::Real);
+    assert(survey.TypeOf("Code") == ColumnType::Integer);
+    assert(survey.ILoc<std::string>(0, 0) == "1000" && survey.ILoc<std::string>(1, 0) == "P1");
+
+    // Inferred without override, the mixed name column stays text
+    assert(ReadColumnarCSV(path).TypeOf("Name") == ColumnType::String);
+
+    std::println("Mean of X, Y, H over columns (no conversion)");
+    AGTB::timer.Tik();
+    double sum = 0.0;
+    for (int loop = 0; loop != 100; ++loop)
+    {
+        sum += survey.NumericSeries<double>("X").mean() + survey.NumericSeries<double>("Y").mean() + survey.NumericSeries<double>("H").mean();
+    }
+    AGTB::timer.Tok();
+
+    std::println("ReadCSV<std::string> + NumericFrame<double>, {} rows", rows);
+    AGTB::timer.Tik();
+    auto text = ReadCSV<std::string>(path, ",", true);
+    auto block = text.ILoc(AGTB::Idx(0) >> text.Rows(), AGTB::Idx(1) >> 4).NumericFrame<double>();
+    AGTB::timer.Tok();
+    const double expect = block.col(0).mean() + block.col(1).mean() + block.col(2).mean();
+    std::println("|mean difference| = {:.3e}", std::abs(sum / 100 - expect));
+    assert(std::abs(sum / 100 - expect) < 1e-6);
+
+    std::filesystem::remove(path);
+    return 0;
+}
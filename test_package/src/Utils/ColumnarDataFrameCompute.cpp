@@ -0,0 +1,132 @@
+#include <AGTB/Container/ColumnarDataFrame.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <map>
+#include <print>
+#include <random>
+#include <cassert>
+
+using AGTB::Aggregate;
+using AGTB::ColumnarDataFrame;
+
+/**
+ * @brief Levelling observations `Line, Len, dH`, about 1% of `dH` missing (NaN)
+ *
+ */
+ColumnarDataFrame<> Observations(size_t rows, int lines, std::mt19937_64 &gen)
+{
+    std::uniform_int_distribution<int> line(0, lines - 1);
+    std::uniform_real_distribution<double> len(0.2, 2.0), noise(-0.003, 0.003), missing(0.0, 1.0);
+    std::vector<std::string> name(rows);
+    std::vector<double> l(rows), dh(rows);
+    for (size_t r = 0; r != rows; ++r)
+    {
+        name[r] = std::format("L{:03}", line(gen));
+        l[r] = len(gen);
+        dh[r] = missing(gen) < 0.01 ? std::numeric_limits<double>::quiet_NaN() : noise(gen) * std::sqrt(l[r]);
+    }
+    ColumnarDataFrame<> df{};
+    df.AddColumn("Line", std::move(name));
+    df.AddColumn("Len", std::move(l));
+    df.AddColumn("dH", std::move(dh));
+    return df;
+}
+
+int main()
+{
+    std::mt19937_64 gen(3);
+    const size_t rows = 2'000'000;
+    auto df = Observations(rows, 200, gen);
+
+    // Elementwise: misclosure per km, weights
+    std::println("Assign dH / sqrt(Len), 1 / Len");
+    AGTB::timer.Tik();
+    df.Assign("dH_km", df.NumericSeries<double>("dH").array() / df.NumericSeries<double>("Len").array().sqrt());
+    df.Assign("P", 1.0 / df.NumericSeries<double>("Len").array());
+    AGTB::timer.Tok();
+    assert(std::abs(df.ILoc<double>(7, df.ColIndex("P")) * df.ILoc<double>(7, 1) - 1.0) < 1e-15);
+
+    // Reductions against a plain loop
+    double sum = 0.0, sum_sq = 0.0, count = 0.0;
+    for (double v : df.Loc<double>("dH"))
+    {
+        if (!std::isnan(v))
+        {
+            sum += v;
+            sum_sq += v * v;
+            ++count;
+        }
+    }
+    std::println("Reduce mean / std / rms of dH");
+    AGTB::timer.Tik();
+    const double
+        mean = df.Reduce("dH", Aggregate::Mean),
+        std_dev = df.Reduce("dH", Aggregate::Std),
+        rms = df.Reduce("dH", Aggregate::Rms, 1);
+    AGTB::timer.Tok();
+    std::println("mean = {:.6e}, std = {:.6e}, rms = {:.6e}", mean, std_dev, rms);
+    assert(df.Reduce("dH", Aggregate::Count) == count);
+    assert(std::abs(mean - sum / count) < 1e-15);
+    assert(std::abs(rms - std::sqrt(sum_sq / count)) < 1e-15);
+    assert(std::abs(std_dev * std_dev - (sum_sq - sum * sum / count) / (count - 1)) < 1e-15);
+    assert(df.Reduce("dH", Aggregate::Sum, 1) == df.Reduce("dH", Aggregate::Sum, 4));
+
+    // Group-by line against std::map
+    std::println("GroupBy Line: count, sum, rms of dH");
+    AGTB::timer.Tik();
+    auto by_line = df.GroupBy("Line", {{"dH", Aggregate::Count}, {"dH", Aggregate::Sum}, {"dH", Aggregate::Rms}, {"Len", Aggregate::Sum}});
+    AGTB::timer.Tok();
+    std::map<std::string, std::pair<double, double>> expect{};
+    for (size_t r = 0; r != rows; ++r)
+    {
+        const double v = df.ILoc<double>(r, 2);
+        auto &[n, s] = expect[df.ILoc<std::string>(r, 0)];
+        if (!std::isnan(v))
+        {
+            n += 1.0;
+            s += v;
+        }
+    }
+    assert(by_line.Rows() == expect.size());
+    size_t g = 0;
+    for (const auto &[line, ns] : expect)
+    {
+        assert(by_line.Loc<std::string>("Line")[g] == line);
+        assert(by_line.Loc<std::int64_t>("dH_count")[g] == static_cast<std::int64_t>(ns.first));
+        assert(std::abs(by_line.Loc<double>("dH_sum")[g] - ns.second) < 1e-12);
+        ++g;
+    }
+    std::println("{}", by_line.Filter(by_line.NumericSeries<std::int64_t>("dH_count").array() < 9'720).ToString());
+
+    // NaN keys are one group sorted last, integer sums are exact past 2^53
+    {
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+        constexpr std::int64_t big = (std::int64_t{1} << 53) + 1;
+        ColumnarDataFrame<> small(6);
+        small.AddColumn<double>("K", {2.0, nan, 1.0, nan, 2.0, nan});
+        small.AddColumn<std::int64_t>("V", {3, big, 7, -1, 4, 0});
+        auto groups = small.GroupBy("K", {{"V", Aggregate::Count}, {"V", Aggregate::Sum}});
+        assert(groups.Rows() == 3);
+        assert(groups.Loc<double>("K")[0] == 1.0 && groups.Loc<double>("K")[1] == 2.0 && std::isnan(groups.Loc<double>("K")[2]));
+        assert((groups.Loc<std::int64_t>("V_count") == std::vector<std::int64_t>{1, 2, 3}));
+        assert((groups.Loc<double>("V_sum") == std::vector<double>{7.0, 7.0, static_cast<double>(big - 1)}));
+        assert(small.GroupBy("K", {{"V", Aggregate::Count}}, false).Rows() == 3);
+
+        small.AddColumn<std::int64_t>("W", {big, 1, 0, 0, 0, 0});
+        assert(small.Reduce("W", Aggregate::Sum) == static_cast<double>(big + 1));
+        assert(small.Reduce("W", Aggregate::Count) == 6.0);
+    }
+
+    // Filter mask
+    std::println("Filter |dH_km| > 2.5 mm");
+    AGTB::timer.Tik();
+    auto outliers = df.Filter(df.NumericSeries<double>("dH_km").array().abs() > 0.0025);
+    AGTB::timer.Tok();
+    const auto expect_outliers = std::ranges::count_if(df.Loc<double>("dH_km"), [](double v)
+                                                       { return std::abs(v) > 0.0025; });
+    std::println("{} of {} rows", outliers.Rows(), rows);
+    assert(outliers.Rows() == static_cast<size_t>(expect_outliers));
+    assert((outliers.NumericSeries<double>("dH_km").array().abs() > 0.0025).all());
+
+    return 0;
+}
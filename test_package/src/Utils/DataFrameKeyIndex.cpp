@@ -0,0 +1,121 @@
+#include <AGTB/Container/DataFrame.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <print>
+#include <cassert>
+#include <stdexcept>
+
+using AGTB::DataFrame;
+using AGTB::DataFrameJoin;
+
+/**
+ * @brief Frame of `rows` points keyed `P<i * step>`, columns `cols`
+ *
+ */
+DataFrame<double> PointTable(size_t rows, size_t step, std::vector<std::string> cols)
+{
+    DataFrame<double> df(rows, cols.size());
+    for (size_t c = 0; c != cols.size(); ++c)
+    {
+        df.ColKeys(c) = cols[c];
+    }
+    for (size_t r = 0; r != rows; ++r)
+    {
+        df.RowKeys(r) = std::format("P{}", r * step);
+        for (size_t c = 0; c != cols.size(); ++c)
+        {
+            df.ILoc(r, c) = static_cast<double>(r * step) + 0.1 * c;
+        }
+    }
+    return df;
+}
+
+/**
+ * @brief Sum of `H` of every row in `coords` looked up by key through `Loc`
+ *
+ */
+double SumByKey(DataFrame<double> &heights, const DataFrame<double> &coords)
+{
+    double sum = 0.0;
+    for (size_t r = 0; r != coords.Rows(); ++r)
+    {
+        sum += heights.Loc(coords.RowKeys()[r], "H");
+    }
+    return sum;
+}
+
+int main()
+{
+    // Same answers with and without index, index follows key changes
+    {
+        auto df = PointTable(5, 1, {"X", "Y", "H"});
+        df.UseKeyIndex();
+        assert(df.Loc("P3", "Y") == 3.1);
+        df.RowKeys(3) = "Q3";
+        assert(df.Loc("Q3", "H") == 3.2);
+        // Missing key is reported as row or column, scanned or indexed
+        for (bool index : {true, false})
+        {
+            df.UseKeyIndex(index);
+            for (auto [rk, ck, what] : {std::tuple{"P3", "H", "Row key not found: P3"}, {"Q3", "Z", "Column key not found: Z"}})
+            {
+                bool thrown = false;
+                try
+                {
+                    df.Loc(rk, ck);
+                }
+                catch (const std::out_of_range &e)
+                {
+                    thrown = std::string_view(e.what()).contains(what);
+                }
+                assert(thrown);
+            }
+        }
+    }
+
+    // Inner and left join by station name
+    {
+        auto coords = PointTable(6, 1, {"X", "Y"});
+        auto heights = PointTable(4, 2, {"H"});
+        auto inner = coords.Join(heights);
+        std::println("Inner join:\n{}", inner.ToString());
+        assert(inner.Rows() == 3 && inner.Cols() == 3);
+        assert(inner.RowKeys()[2] == "P4" && inner.ILoc(2, 2) == 4.0);
+        auto left = coords.Join(heights, DataFrameJoin::Left);
+        assert(left.Rows() == 6 && left.ILoc(1, 2) == 0.0 && left.ILoc(4, 2) == 4.0);
+    }
+
+    // Lookup of every row, scan against index
+    {
+        const size_t rows = 20'000;
+        auto coords = PointTable(rows, 1, {"X", "Y"});
+        auto heights = PointTable(rows, 1, {"H"});
+
+        std::println("Loc by scan, {} keys", rows);
+        AGTB::timer.Tik();
+        const double by_scan = SumByKey(heights, coords);
+        AGTB::timer.Tok();
+
+        heights.UseKeyIndex();
+        std::println("Loc by index, {} keys", rows);
+        AGTB::timer.Tik();
+        const double by_index = SumByKey(heights, coords);
+        AGTB::timer.Tok();
+        assert(by_scan == by_index);
+    }
+
+    // Join of 10^6 rows
+    {
+        const size_t rows = 1'000'000;
+        auto coords = PointTable(rows, 1, {"X", "Y"});
+        auto heights = PointTable(rows / 2, 2, {"H"});
+        std::println("Join {} x {} rows", rows, rows / 2);
+        AGTB::timer.Tik();
+        auto joined = coords.Join(heights);
+        AGTB::timer.Tok();
+        assert(joined.Rows() == rows / 2);
+        assert(joined.ILoc(joined.Rows() - 1, 2) == static_cast<double>(rows - 2));
+    }
+
+    return 0;
+}
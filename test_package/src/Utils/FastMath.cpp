@@ -0,0 +1,106 @@
+#include <AGTB/Utils/FastMath.hpp>
+#include <AGTB/Utils/Timer.hpp>
+#include <gcem.hpp>
+
+#include <print>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <string_view>
+
+namespace am = AGTB::Math;
+
+static_assert(am::sin(0.5) == gcem::sin(0.5));
+static_assert(am::pow(1.5, 3) == gcem::pow(1.5, 3));
+static_assert(am::sqrt(4.0) == 2.0);
+
+constexpr size_t n = 10'000'000;
+
+std::vector<double> Samples(double lo, double hi)
+{
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<double> xs(n);
+    for (auto &x : xs)
+    {
+        x = dist(gen);
+    }
+    return xs;
+}
+
+template <typename __ref, typename __fast>
+void Compare(std::string_view name, const std::vector<double> &xs, __ref &&ref, __fast &&fast, double tolerance = 1e-14)
+{
+    double sum_ref = 0, sum_fast = 0, max_diff = 0;
+
+    std::println("{:-^60}", name);
+    std::println("gcem:");
+    AGTB::timer.Tik();
+    for (double x : xs)
+    {
+        sum_ref += ref(x);
+    }
+    AGTB::timer.Tok();
+
+    std::println("AGTB::Math:");
+    AGTB::timer.Tik();
+    for (double x : xs)
+    {
+        sum_fast += fast(x);
+    }
+    AGTB::timer.Tok();
+
+    for (size_t i = 0; i < xs.size(); i += 997)
+    {
+        const double r = ref(xs[i]);
+        max_diff = std::max(max_diff, std::abs(r - fast(xs[i])) / std::max(1.0, std::abs(r)));
+    }
+    std::println("checksum {} vs {}, max relative diff {:.3e}", sum_ref, sum_fast, max_diff);
+    assert(max_diff < tolerance);
+}
+
+int main()
+{
+    const auto angles = Samples(-3.14, 3.14);
+    const auto positive = Samples(1e-3, 1e3);
+
+    Compare("sin", angles, [](double x)
+            { return gcem::sin(x); }, [](double x)
+            { return am::sin(x); });
+    Compare("cos", angles, [](double x)
+            { return gcem::cos(x); }, [](double x)
+            { return am::cos(x); });
+    Compare("tan", angles, [](double x)
+            { return gcem::tan(x); }, [](double x)
+            { return am::tan(x); }, 1e-12);
+    Compare("atan", positive, [](double x)
+            { return gcem::atan(x); }, [](double x)
+            { return am::atan(x); });
+    Compare("sqrt", positive, [](double x)
+            { return gcem::sqrt(x); }, [](double x)
+            { return am::sqrt(x); });
+    Compare("pow(x, 4)", angles, [](double x)
+            { return gcem::pow(x, 4); }, [](double x)
+            { return am::pow(x, 4); });
+    Compare("pow(x, -1.5)", positive, [](double x)
+            { return gcem::pow(x, -1.5); }, [](double x)
+            { return am::pow(x, -1.5); });
+    Compare("sin + cos / sincos", angles, [](double x)
+            { return gcem::sin(x) + gcem::cos(x); }, [](double x)
+            {
+                double s, c;
+                am::sincos(x, s, c);
+                return s + c; });
+
+    // Exponents off the sqrt path, including non-finite and huge ones, fall back to std::pow
+    for (const double y : {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+                           -std::numeric_limits<double>::infinity(), 1e300, -1e300, 2.75})
+    {
+        const double fast = am::pow(2.0, y), expect = std::pow(2.0, y);
+        assert(std::isnan(expect) ? std::isnan(fast) : fast == expect);
+    }
+
+    return 0;
+}
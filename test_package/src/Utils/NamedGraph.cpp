@@ -0,0 +1,285 @@
+#include <AGTB/Container/NamedGraph.hpp>
+#include <AGTB/Utils/Timer.hpp>
+
+#include <map>
+#include <queue>
+#include <random>
+#include <print>
+#include <cassert>
+
+struct Point
+{
+    double elev = 0.0;
+};
+
+struct Line
+{
+    double dif = 0.0;
+};
+
+using Net = AGTB::NamedGraph<Point, Line>;
+
+int main()
+{
+    // Removal keeps handles dense and every name <-> descriptor mapping in sync
+    {
+        Net net{};
+        net.AddEdge(true)("A", "B", "1", {1.0})("B", "C", "2", {2.0})("C", "D", "3", {3.0})("A", "D", "4", {4.0});
+        net.Vertex("C").elev = 30.0;
+        net.Vertex("D").elev = 40.0;
+
+        net.RemoveEdge("2");
+        net.RemoveEdge("3");
+        net.RemoveVertex("C");
+
+        assert(net.Vertices().Size() == 3 && net.Edges().Size() == 2);
+        assert(!net.ContainsVertex("C") && !net.ContainsEdge("2"));
+        assert(net.Vertex("D").elev == 40.0);
+        assert(net.SourceName("4") == "A" && net.TargetName("4") == "D");
+        assert(net.Edge("4").dif == 4.0 && net.Edge("1").dif == 1.0);
+        for (const auto vh : net.VertexHandles())
+        {
+            assert(net.Handle(net.Index(vh)) == vh);
+            assert(net.FindVertex(net.NameOf(vh)) == vh);
+        }
+        for (const auto eh : net.EdgeHandles())
+        {
+            assert(net.NameOf(net.Index(eh)) == net.NameOf(eh));
+            assert(net.NameOf(net.SourceHandle(eh)) == net.SourceName(net.NameOf(eh)));
+        }
+
+        // Snapshot agrees with the graph
+        const auto frozen = net.Freeze(&Line::dif);
+        assert(frozen.VertexCount() == 3 && frozen.EdgeCount() == 2);
+        const auto a = net.FindVertex("A");
+        assert(frozen.OutEdges(a).size() == 2 && frozen.InEdges(a).empty());
+        assert(net.NameOf(frozen.OutEdges(a)[0]) == "1" && net.NameOf(frozen.OutNeighbours(a)[1]) == "D");
+        assert(frozen.Field<0>(net.FindEdge("4")) == 4.0);
+        assert(net.NameOf(frozen.InNeighbours(net.FindVertex("D"))[0]) == "A");
+
+        bool thrown = false;
+        try
+        {
+            net.Vertex("C");
+        }
+        catch (const std::out_of_range &)
+        {
+            thrown = true;
+        }
+        assert(thrown);
+
+        // Pairs and names in name order, views in handle order, copies rebuild their own order
+        net.AddVertex("C");
+        auto [beg, end] = net.Vertices().Iterators();
+        std::vector<std::string> sorted{};
+        for (auto it = beg; it != end; ++it)
+        {
+            assert(net.Vertices().UnWrap().Descriptor(net.FindVertex(it->first).id) == it->second);
+            sorted.emplace_back(it->first);
+        }
+        assert((sorted == std::vector<std::string>{"A", "B", "C", "D"}));
+        assert(std::ranges::equal(net.Vertices().Names(), sorted));
+        assert(net.Vertices().NamesView().back() == "C");
+
+        Net copy = net;
+        copy.AddVertex("AA");
+        assert(copy.Vertices().Begin()->first == "A" && std::next(copy.Vertices().Begin())->first == "AA");
+        assert(std::ranges::distance(net.Vertices().Names()) == 4);
+    }
+
+    // Levelling line of 10^5 points
+    const size_t size = 100'000;
+    Net net{};
+    std::vector<std::string> names(size), edge_names(size - 1);
+    for (size_t i = 0; i != size; ++i)
+    {
+        names[i] = std::format("P{}", i);
+        net.AddVertex(names[i], {static_cast<double>(i)});
+    }
+    for (size_t i = 0; i + 1 != size; ++i)
+    {
+        edge_names[i] = std::format("L{}", i);
+        net.AddEdge(names[i], names[i + 1], edge_names[i], {1.0});
+    }
+
+    // What the same three lookups per edge cost with ordered string maps
+    std::map<std::string, size_t> vertex_tree{}, edge_tree{};
+    for (size_t i = 0; i != size; ++i)
+    {
+        vertex_tree.emplace(names[i], i);
+    }
+    for (size_t i = 0; i + 1 != size; ++i)
+    {
+        edge_tree.emplace(edge_names[i], i);
+    }
+
+    const int loops = 10;
+    size_t touched = 0;
+    std::println("std::map<std::string, ...> lookups, {} x {}", loops, size);
+    AGTB::timer.Tik();
+    for (int loop = 0; loop != loops; ++loop)
+    {
+        for (size_t i = 0; i + 1 != size; ++i)
+        {
+            touched += edge_tree.at(edge_names[i]) + vertex_tree.at(names[i + 1]) - vertex_tree.at(names[i]);
+        }
+    }
+    AGTB::timer.Tok();
+    assert(touched == loops * ((size - 1) * (size - 2) / 2 + (size - 1)));
+
+    double sum = 0.0;
+    std::println("Name lookups (Edge, SourceVertex, TargetVertex), {} x {}", loops, size);
+    AGTB::timer.Tik();
+    for (int loop = 0; loop != loops; ++loop)
+    {
+        for (const auto &e : edge_names)
+        {
+            sum += net.Edge(e).dif + net.TargetVertex(e).elev - net.SourceVertex(e).elev;
+        }
+    }
+    AGTB::timer.Tok();
+    assert(sum == loops * 2.0 * (size - 1));
+
+    sum = 0.0;
+    std::println("Handle loop, {} x {}", loops, size);
+    AGTB::timer.Tik();
+    for (int loop = 0; loop != loops; ++loop)
+    {
+        for (const auto eh : net.EdgeHandles())
+        {
+            sum += net.Edge(eh).dif + net.Vertex(net.TargetHandle(eh)).elev - net.Vertex(net.SourceHandle(eh)).elev;
+        }
+    }
+    AGTB::timer.Tok();
+    assert(sum == loops * 2.0 * (size - 1));
+
+    // Breadth-first walk from P0, as the adjusters initialize
+    auto walk_names = [&]
+    {
+        std::vector<bool> seen(size, false);
+        std::queue<std::string> queue{};
+        queue.push(names[0]);
+        seen[0] = true;
+        size_t visited = 0;
+        while (!queue.empty())
+        {
+            const std::string v = queue.front();
+            queue.pop();
+            ++visited;
+            for (const auto &e : net.OutEdgesOf(v))
+            {
+                const auto id = net.FindVertex(net.TargetName(e)).id;
+                if (!seen[id])
+                {
+                    seen[id] = true;
+                    queue.push(net.TargetName(e));
+                }
+            }
+        }
+        return visited;
+    };
+
+    std::println("BFS by names and OutEdgesOf, {} times", loops);
+    AGTB::timer.Tik();
+    for (int loop = 0; loop != loops; ++loop)
+    {
+        assert(walk_names() == size);
+    }
+    AGTB::timer.Tok();
+
+    std::println("Freeze + BFS on the snapshot, {} times", loops);
+    AGTB::timer.Tik();
+    for (int loop = 0; loop != loops; ++loop)
+    {
+        const auto frozen = net.Freeze(&Line::dif);
+        std::vector<bool> seen(size, false);
+        std::queue<AGTB::VertexHandle> queue{};
+        queue.push(net.FindVertex(names[0]));
+        seen[queue.front().id] = true;
+        size_t visited = 0;
+        while (!queue.empty())
+        {
+            const auto v = queue.front();
+            queue.pop();
+            ++visited;
+            for (const auto next : frozen.OutNeighbours(v))
+            {
+                if (!seen[next.id])
+                {
+                    seen[next.id] = true;
+                    queue.push(next);
+                }
+            }
+        }
+        assert(visited == size);
+    }
+    AGTB::timer.Tok();
+
+    // 2.5 * 10^5 stations with 4 out edges each: generator vs view accessors
+    {
+        std::mt19937_64 gen(11);
+        const size_t stations = 250'000, degree = 4;
+        std::uniform_int_distribution<size_t> pick(0, stations - 1);
+        Net big{};
+        std::vector<std::string> station_names(stations);
+        for (size_t i = 0; i != stations; ++i)
+        {
+            station_names[i] = std::format("S{}", i);
+            big.AddVertex(station_names[i]);
+        }
+        for (size_t i = 0; i != stations; ++i)
+        {
+            for (size_t k = 0; k != degree; ++k)
+            {
+                big.AddEdge(station_names[i], station_names[pick(gen)], std::format("E{}_{}", i, k));
+            }
+        }
+
+        std::vector<std::string> names_of_view{};
+        for (const auto &e : big.EdgesView(station_names[7]))
+        {
+            names_of_view.emplace_back(e);
+        }
+        std::vector<std::string> names_of_generator{};
+        for (const auto &e : big.EdgesOf(station_names[7]))
+        {
+            names_of_generator.emplace_back(e);
+        }
+        assert(names_of_view == names_of_generator && names_of_view.size() >= degree);
+
+        size_t chars = 0;
+        std::println("InEdgesOf + OutEdgesOf (std::generator), {} edges", stations * degree);
+        AGTB::timer.Tik();
+        for (const auto &v : big.Vertices().Names())
+        {
+            for (const auto &e : big.InEdgesOf(v))
+            {
+                chars += e.size();
+            }
+            for (const auto &e : big.OutEdgesOf(v))
+            {
+                chars += e.size();
+            }
+        }
+        AGTB::timer.Tok();
+
+        size_t view_chars = 0;
+        std::println("InEdgesView + OutEdgesView, {} edges", stations * degree);
+        AGTB::timer.Tik();
+        for (const auto &v : big.Vertices().NamesView())
+        {
+            for (const auto &e : big.InEdgesView(v))
+            {
+                view_chars += e.size();
+            }
+            for (const auto &e : big.OutEdgesView(v))
+            {
+                view_chars += e.size();
+            }
+        }
+        AGTB::timer.Tok();
+        assert(chars == view_chars);
+    }
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <AGTB/Utils/SimdMath.hpp>
+#include <AGTB/Utils/Timer.hpp>
+#include <gcem.hpp>
+
+#include <print>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <string_view>
+
+namespace simd = AGTB::Math::Simd;
+using simd::Pack;
+using simd::width;
+
+constexpr size_t n = 1 << 22;
+
+double Ulp(double value, double reference)
+{
+    if (value == reference)
+    {
+        return 0.0;
+    }
+    const double r = std::abs(reference);
+    return std::abs(value - reference) / (std::nextafter(r, INFINITY) - r);
+}
+
+struct Error
+{
+    double ulp, abs;
+};
+
+std::vector<double> Samples(double lo, double hi, unsigned seed)
+{
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<double> xs(n);
+    for (auto &x : xs)
+    {
+        x = dist(gen);
+    }
+    return xs;
+}
+
+template <typename __packed, typename __scalar>
+Error Measure(std::string_view name, const std::vector<double> &a, const std::vector<double> &b, __packed &&packed, __scalar &&scalar)
+{
+    std::vector<double> out(n), ref(n);
+
+    std::println("{:-^60}", name);
+    std::println("gcem:");
+    AGTB::timer.Tik();
+    for (size_t i = 0; i != n; ++i)
+    {
+        ref[i] = scalar(a[i], b[i]);
+    }
+    AGTB::timer.Tok();
+
+    std::println("Simd (width = {}):", width);
+    AGTB::timer.Tik();
+    for (size_t i = 0; i != n; i += width)
+    {
+        simd::Store(&out[i], packed(simd::Load(&a[i]), simd::Load(&b[i])));
+    }
+    AGTB::timer.Tok();
+
+    Error e{0.0, 0.0};
+    for (size_t i = 0; i != n; ++i)
+    {
+        e.ulp = std::max(e.ulp, Ulp(out[i], ref[i]));
+        e.abs = std::max(e.abs, std::abs(out[i] - ref[i]));
+    }
+    std::println("max error {} ulp, {:.3e} abs", e.ulp, e.abs);
+    return e;
+}
+
+template <simd::Precision __tier>
+void Check(std::string_view tier, double ulp_bound, double abs_bound)
+{
+    const auto angles = Samples(-7.0, 7.0, 1), ys = Samples(-1e4, 1e4, 2), xs = Samples(-1e4, 1e4, 3);
+    constexpr double earth_radius = 6.4e6;
+
+    std::println("{:=^60}", tier);
+    const Error
+        e_sin = Measure(
+            "sin", angles, angles,
+            [](Pack x, Pack)
+            { return __tier::sin(x); },
+            [](double x, double)
+            { return gcem::sin(x); }),
+        e_cos = Measure(
+            "cos", angles, angles,
+            [](Pack x, Pack)
+            { return __tier::cos(x); },
+            [](double x, double)
+            { return gcem::cos(x); }),
+        e_atan2 = Measure(
+            "atan2", ys, xs,
+            [](Pack y, Pack x)
+            { return __tier::atan2(y, x); },
+            [](double y, double x)
+            { return gcem::atan2(y, x); }),
+        e_sqrt = Measure(
+            "sqrt", ys, ys,
+            [](Pack x, Pack)
+            { return __tier::sqrt(simd::Abs(x)); },
+            [](double x, double)
+            { return gcem::sqrt(gcem::abs(x)); });
+
+    for (const Error &e : {e_sin, e_cos, e_atan2})
+    {
+        assert(e.ulp <= ulp_bound);
+        assert(e.abs <= abs_bound);
+        std::println("{:.3e} m on Earth radius", e.abs * earth_radius);
+    }
+    assert(e_sqrt.ulp <= 1.0);
+}
+
+int main()
+{
+    Check<simd::Full>("Full", 4.0, 1e-15);
+    Check<simd::Survey>("Survey", INFINITY, 1.5e-11);
+
+    Pack s, c;
+    simd::Full::sincos(simd::Broadcast(1e7), s, c);
+    assert(s[0] == std::sin(1e7) && c[0] == std::cos(1e7));
+    assert(simd::Full::atan2(simd::Broadcast(-0.0), simd::Broadcast(-1.0))[0] == -gcem::atan2(0.0, -1.0));
+    assert(simd::Full::atan2(simd::Broadcast(0.0), simd::Broadcast(0.0))[0] == 0.0);
+
+    return 0;
+}